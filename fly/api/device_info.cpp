@@ -5,7 +5,8 @@ namespace fly
 
 DeviceInfo::DeviceInfo(const DeviceIndex device, const std::string& name) :
     id(device),
-    name(name)
+    name(name),
+    hostUnifiedMemory(false)
 {}
 
 DeviceIndex DeviceInfo::getId() const
@@ -75,6 +76,11 @@ size_t DeviceInfo::getMaxWorkGroupSize() const
     return maxWorkGroupSize;
 }
 
+bool DeviceInfo::hasHostUnifiedMemory() const
+{
+    return hostUnifiedMemory;
+}
+
 void DeviceInfo::setVendor(const std::string& vendor)
 {
     this->vendor = vendor;
@@ -115,6 +121,11 @@ void DeviceInfo::setMaxWorkGroupSize(const size_t maxWorkGroupSize)
     this->maxWorkGroupSize = maxWorkGroupSize;
 }
 
+void DeviceInfo::setHostUnifiedMemory(const bool flag)
+{
+    hostUnifiedMemory = flag;
+}
+
 std::ostream& operator<<(std::ostream& outputTarget, const DeviceInfo& deviceInfo)
 {
     outputTarget << "Printing detailed info for device with index: " << deviceInfo.getId() << std::endl;
@@ -126,6 +137,7 @@ std::ostream& operator<<(std::ostream& outputTarget, const DeviceInfo& deviceInf
     outputTarget << "Maximum constant buffer size: " << deviceInfo.getMaxConstantBufferSize() << std::endl;
     outputTarget << "Maximum parallel compute units: " << deviceInfo.getMaxComputeUnits() << std::endl;
     outputTarget << "Maximum work-group size: " << deviceInfo.getMaxWorkGroupSize() << std::endl;
+    outputTarget << "Host unified memory: " << (deviceInfo.hasHostUnifiedMemory() ? "yes" : "no") << std::endl;
     outputTarget << "Extensions: " << deviceInfo.getExtensions() << std::endl;
     return outputTarget;
 }
@@ -92,6 +92,12 @@ public:
       */
     size_t getMaxWorkGroupSize() const;
 
+    /** @fn bool hasHostUnifiedMemory() const
+      * Checks whether device shares physical memory with host, eg. CPUs and integrated GPUs.
+      * @return True if device and host use unified memory, false otherwise.
+      */
+    bool hasHostUnifiedMemory() const;
+
     /** @fn void setVendor(const std::string& vendor)
       * Setter for name of device vendor.
       * @param vendor Name of device vendor.
@@ -140,6 +146,12 @@ public:
       */
     void setMaxWorkGroupSize(const size_t maxWorkGroupSize);
 
+    /** @fn void setHostUnifiedMemory(const bool flag)
+      * Setter for flag which specifies whether device shares physical memory with host.
+      * @param flag True if device and host use unified memory, false otherwise.
+      */
+    void setHostUnifiedMemory(const bool flag);
+
 private:
     DeviceIndex id;
     std::string name;
@@ -151,6 +163,7 @@ private:
     uint64_t maxConstantBufferSize;
     uint32_t maxComputeUnits;
     size_t maxWorkGroupSize;
+    bool hostUnifiedMemory;
 };
 
 /** @fn std::ostream& operator<<(std::ostream& outputTarget, const DeviceInfo& deviceInfo)
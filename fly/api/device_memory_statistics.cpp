@@ -0,0 +1,48 @@
+#include <fly/api/device_memory_statistics.h>
+
+namespace fly
+{
+
+DeviceMemoryStatistics::DeviceMemoryStatistics() :
+    currentUsage(0),
+    peakUsage(0),
+    budget(0),
+    evictionCount(0),
+    spillCount(0)
+{}
+
+DeviceMemoryStatistics::DeviceMemoryStatistics(const size_t currentUsage, const size_t peakUsage, const size_t budget,
+    const uint64_t evictionCount, const uint64_t spillCount) :
+    currentUsage(currentUsage),
+    peakUsage(peakUsage),
+    budget(budget),
+    evictionCount(evictionCount),
+    spillCount(spillCount)
+{}
+
+size_t DeviceMemoryStatistics::getCurrentUsage() const
+{
+    return currentUsage;
+}
+
+size_t DeviceMemoryStatistics::getPeakUsage() const
+{
+    return peakUsage;
+}
+
+size_t DeviceMemoryStatistics::getBudget() const
+{
+    return budget;
+}
+
+uint64_t DeviceMemoryStatistics::getEvictionCount() const
+{
+    return evictionCount;
+}
+
+uint64_t DeviceMemoryStatistics::getSpillCount() const
+{
+    return spillCount;
+}
+
+} // namespace fly
@@ -0,0 +1,74 @@
+/** @file device_memory_statistics.h
+  * Functionality related to retrieving statistics of device memory used by argument buffers.
+  */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "fly/fly_platform.h"
+
+namespace fly
+{
+
+/** @class DeviceMemoryStatistics
+  * Class which holds statistics of device memory occupied by argument buffers of compute engine.
+  */
+class DeviceMemoryStatistics
+{
+public:
+    /** @fn DeviceMemoryStatistics()
+      * Default constructor, creates statistics with all counters set to zero.
+      */
+    DeviceMemoryStatistics();
+
+    /** @fn explicit DeviceMemoryStatistics(const size_t currentUsage, const size_t peakUsage, const size_t budget,
+      * const uint64_t evictionCount, const uint64_t spillCount)
+      * Constructor which creates new device memory statistics object.
+      * @param currentUsage Size of argument buffers currently allocated on device.
+      * @param peakUsage Largest size of argument buffers allocated on device at the same time.
+      * @param budget Device memory budget for argument buffers. Zero means that the budget is not limited.
+      * @param evictionCount Number of buffers removed from device in order to satisfy the budget.
+      * @param spillCount Number of evicted buffers whose contents were modified by kernel and had to be copied to host.
+      */
+    explicit DeviceMemoryStatistics(const size_t currentUsage, const size_t peakUsage, const size_t budget, const uint64_t evictionCount,
+        const uint64_t spillCount);
+
+    /** @fn size_t getCurrentUsage() const
+      * Getter for size of argument buffers currently allocated on device.
+      * @return Size of argument buffers currently allocated on device.
+      */
+    size_t getCurrentUsage() const;
+
+    /** @fn size_t getPeakUsage() const
+      * Getter for largest size of argument buffers allocated on device at the same time.
+      * @return Peak size of argument buffers allocated on device.
+      */
+    size_t getPeakUsage() const;
+
+    /** @fn size_t getBudget() const
+      * Getter for device memory budget for argument buffers.
+      * @return Device memory budget. Zero means that the budget is not limited.
+      */
+    size_t getBudget() const;
+
+    /** @fn uint64_t getEvictionCount() const
+      * Getter for number of buffers removed from device in order to satisfy the budget.
+      * @return Number of buffer evictions.
+      */
+    uint64_t getEvictionCount() const;
+
+    /** @fn uint64_t getSpillCount() const
+      * Getter for number of evicted buffers whose contents were copied to host.
+      * @return Number of buffer spills.
+      */
+    uint64_t getSpillCount() const;
+
+private:
+    size_t currentUsage;
+    size_t peakUsage;
+    size_t budget;
+    uint64_t evictionCount;
+    uint64_t spillCount;
+};
+
+} // namespace fly
@@ -0,0 +1,69 @@
+#include <stdexcept>
+#include <fly/api/host_kernel_context.h>
+
+namespace fly
+{
+
+HostKernelContext::HostKernelContext(const std::vector<size_t>& globalSize, const std::vector<size_t>& localSize,
+    const std::vector<size_t>& groupId, const std::vector<void*>& arguments, const std::vector<ParameterPair>& parameterPairs) :
+    globalSize(globalSize),
+    localSize(localSize),
+    groupId(groupId),
+    arguments(arguments),
+    parameterPairs(parameterPairs)
+{}
+
+size_t HostKernelContext::getGlobalSize(const size_t dimension) const
+{
+    return globalSize.at(dimension);
+}
+
+size_t HostKernelContext::getLocalSize(const size_t dimension) const
+{
+    return localSize.at(dimension);
+}
+
+size_t HostKernelContext::getGroupId(const size_t dimension) const
+{
+    return groupId.at(dimension);
+}
+
+size_t HostKernelContext::getNumberOfGroups(const size_t dimension) const
+{
+    return globalSize.at(dimension) / localSize.at(dimension);
+}
+
+size_t HostKernelContext::getGlobalId(const size_t dimension, const size_t localId) const
+{
+    return groupId.at(dimension) * localSize.at(dimension) + localId;
+}
+
+size_t HostKernelContext::getWorkGroupSize() const
+{
+    return localSize.at(0) * localSize.at(1) * localSize.at(2);
+}
+
+size_t HostKernelContext::getParameterValue(const std::string& parameterName) const
+{
+    return findParameter(parameterName).getValue();
+}
+
+double HostKernelContext::getParameterValueDouble(const std::string& parameterName) const
+{
+    return findParameter(parameterName).getValueDouble();
+}
+
+const ParameterPair& HostKernelContext::findParameter(const std::string& parameterName) const
+{
+    for (const auto& parameterPair : parameterPairs)
+    {
+        if (parameterPair.getName() == parameterName)
+        {
+            return parameterPair;
+        }
+    }
+
+    throw std::runtime_error(std::string("Parameter with following name is not part of current configuration: ") + parameterName);
+}
+
+} // namespace fly
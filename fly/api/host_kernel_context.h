@@ -0,0 +1,128 @@
+/** @file host_kernel_context.h
+  * Functionality related to writing kernels for Host compute API.
+  */
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include "fly/api/parameter_pair.h"
+#include "fly/fly_platform.h"
+
+namespace fly
+{
+
+/** @class HostKernelContext
+  * Class which describes single work-group of a kernel launched with Host compute API. Host kernel function is called once per work-group
+  * and is responsible for iterating over work-items of the group. Barrier between work-items corresponds to splitting the iteration
+  * into several consecutive loops. Context object is valid only during the corresponding kernel function call.
+  */
+class HostKernelContext
+{
+public:
+    /** @fn explicit HostKernelContext(const std::vector<size_t>& globalSize, const std::vector<size_t>& localSize,
+      * const std::vector<size_t>& groupId, const std::vector<void*>& arguments, const std::vector<ParameterPair>& parameterPairs)
+      * Constructor, which creates context for single work-group. It is utilized by Host compute engine.
+      * @param globalSize Global size of launched kernel in work-items.
+      * @param localSize Local size of launched kernel in work-items.
+      * @param groupId Index of current work-group in each dimension.
+      * @param arguments Pointers to kernel arguments in the order specified by kernel argument ids.
+      * @param parameterPairs Values of tuning parameters for current kernel launch.
+      */
+    explicit HostKernelContext(const std::vector<size_t>& globalSize, const std::vector<size_t>& localSize, const std::vector<size_t>& groupId,
+        const std::vector<void*>& arguments, const std::vector<ParameterPair>& parameterPairs);
+
+    /** @fn size_t getGlobalSize(const size_t dimension) const
+      * Getter for global size of launched kernel in specified dimension.
+      * @param dimension Dimension index, must be lower than 3.
+      * @return Global size in specified dimension.
+      */
+    size_t getGlobalSize(const size_t dimension) const;
+
+    /** @fn size_t getLocalSize(const size_t dimension) const
+      * Getter for local size of launched kernel in specified dimension.
+      * @param dimension Dimension index, must be lower than 3.
+      * @return Local size in specified dimension.
+      */
+    size_t getLocalSize(const size_t dimension) const;
+
+    /** @fn size_t getGroupId(const size_t dimension) const
+      * Getter for index of current work-group in specified dimension.
+      * @param dimension Dimension index, must be lower than 3.
+      * @return Index of current work-group in specified dimension.
+      */
+    size_t getGroupId(const size_t dimension) const;
+
+    /** @fn size_t getNumberOfGroups(const size_t dimension) const
+      * Getter for number of work-groups in specified dimension.
+      * @param dimension Dimension index, must be lower than 3.
+      * @return Number of work-groups in specified dimension.
+      */
+    size_t getNumberOfGroups(const size_t dimension) const;
+
+    /** @fn size_t getGlobalId(const size_t dimension, const size_t localId) const
+      * Computes global index of work-item with specified local index inside current work-group.
+      * @param dimension Dimension index, must be lower than 3.
+      * @param localId Local index of work-item in specified dimension.
+      * @return Global index of work-item in specified dimension.
+      */
+    size_t getGlobalId(const size_t dimension, const size_t localId) const;
+
+    /** @fn size_t getWorkGroupSize() const
+      * Getter for total number of work-items inside single work-group.
+      * @return Total number of work-items inside single work-group.
+      */
+    size_t getWorkGroupSize() const;
+
+    /** @fn size_t getParameterValue(const std::string& parameterName) const
+      * Getter for value of integer tuning parameter in current configuration.
+      * @param parameterName Name of tuning parameter.
+      * @return Value of tuning parameter.
+      */
+    size_t getParameterValue(const std::string& parameterName) const;
+
+    /** @fn double getParameterValueDouble(const std::string& parameterName) const
+      * Getter for value of floating-point tuning parameter in current configuration.
+      * @param parameterName Name of tuning parameter.
+      * @return Value of tuning parameter.
+      */
+    double getParameterValueDouble(const std::string& parameterName) const;
+
+    /** @fn template <typename T> T* getArgumentVector(const size_t index) const
+      * Getter for vector or local memory argument. Local memory arguments are allocated separately for each work-group. Arguments with
+      * HostZeroCopy memory location point directly to user data, read-only arguments must therefore never be written.
+      * @param index Index of argument in kernel argument list.
+      * @return Pointer to argument data.
+      */
+    template <typename T> T* getArgumentVector(const size_t index) const
+    {
+        return static_cast<T*>(arguments.at(index));
+    }
+
+    /** @fn template <typename T> T getArgumentScalar(const size_t index) const
+      * Getter for scalar argument.
+      * @param index Index of argument in kernel argument list.
+      * @return Value of scalar argument.
+      */
+    template <typename T> T getArgumentScalar(const size_t index) const
+    {
+        return *static_cast<const T*>(arguments.at(index));
+    }
+
+private:
+    const std::vector<size_t>& globalSize;
+    const std::vector<size_t>& localSize;
+    const std::vector<size_t>& groupId;
+    const std::vector<void*>& arguments;
+    const std::vector<ParameterPair>& parameterPairs;
+
+    const ParameterPair& findParameter(const std::string& parameterName) const;
+};
+
+/** @typedef HostKernelFunction
+  * Definition of kernel function executed by Host compute API. It is called once for each work-group.
+  */
+using HostKernelFunction = std::function<void(const HostKernelContext&)>;
+
+} // namespace fly
@@ -0,0 +1,48 @@
+#include <fly/api/kernel_cache_statistics.h>
+
+namespace fly
+{
+
+KernelCacheStatistics::KernelCacheStatistics() :
+    hitCount(0),
+    missCount(0),
+    evictionCount(0),
+    entryCount(0),
+    sizeInBytes(0)
+{}
+
+KernelCacheStatistics::KernelCacheStatistics(const uint64_t hitCount, const uint64_t missCount, const uint64_t evictionCount,
+    const size_t entryCount, const size_t sizeInBytes) :
+    hitCount(hitCount),
+    missCount(missCount),
+    evictionCount(evictionCount),
+    entryCount(entryCount),
+    sizeInBytes(sizeInBytes)
+{}
+
+uint64_t KernelCacheStatistics::getHitCount() const
+{
+    return hitCount;
+}
+
+uint64_t KernelCacheStatistics::getMissCount() const
+{
+    return missCount;
+}
+
+uint64_t KernelCacheStatistics::getEvictionCount() const
+{
+    return evictionCount;
+}
+
+size_t KernelCacheStatistics::getEntryCount() const
+{
+    return entryCount;
+}
+
+size_t KernelCacheStatistics::getSizeInBytes() const
+{
+    return sizeInBytes;
+}
+
+} // namespace fly
@@ -0,0 +1,74 @@
+/** @file kernel_cache_statistics.h
+  * Functionality related to retrieving statistics of compiled kernel cache.
+  */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "fly/fly_platform.h"
+
+namespace fly
+{
+
+/** @class KernelCacheStatistics
+  * Class which holds statistics of compiled kernel cache utilized by compute engine.
+  */
+class KernelCacheStatistics
+{
+public:
+    /** @fn KernelCacheStatistics()
+      * Default constructor, creates statistics with all counters set to zero.
+      */
+    KernelCacheStatistics();
+
+    /** @fn explicit KernelCacheStatistics(const uint64_t hitCount, const uint64_t missCount, const uint64_t evictionCount,
+      * const size_t entryCount, const size_t sizeInBytes)
+      * Constructor which creates new kernel cache statistics object.
+      * @param hitCount Number of kernel launches which found compiled kernel in the cache.
+      * @param missCount Number of kernel launches which had to compile kernel.
+      * @param evictionCount Number of kernels removed from the cache in order to satisfy its capacity or byte budget.
+      * @param entryCount Number of kernels currently stored in the cache.
+      * @param sizeInBytes Size of compiled kernels currently stored in the cache.
+      */
+    explicit KernelCacheStatistics(const uint64_t hitCount, const uint64_t missCount, const uint64_t evictionCount, const size_t entryCount,
+        const size_t sizeInBytes);
+
+    /** @fn uint64_t getHitCount() const
+      * Getter for number of kernel launches which found compiled kernel in the cache.
+      * @return Number of cache hits.
+      */
+    uint64_t getHitCount() const;
+
+    /** @fn uint64_t getMissCount() const
+      * Getter for number of kernel launches which had to compile kernel.
+      * @return Number of cache misses.
+      */
+    uint64_t getMissCount() const;
+
+    /** @fn uint64_t getEvictionCount() const
+      * Getter for number of kernels removed from the cache in order to satisfy its capacity or byte budget.
+      * @return Number of cache evictions.
+      */
+    uint64_t getEvictionCount() const;
+
+    /** @fn size_t getEntryCount() const
+      * Getter for number of kernels currently stored in the cache.
+      * @return Number of kernels currently stored in the cache.
+      */
+    size_t getEntryCount() const;
+
+    /** @fn size_t getSizeInBytes() const
+      * Getter for size of compiled kernels currently stored in the cache.
+      * @return Size of compiled kernels currently stored in the cache.
+      */
+    size_t getSizeInBytes() const;
+
+private:
+    uint64_t hitCount;
+    uint64_t missCount;
+    uint64_t evictionCount;
+    size_t entryCount;
+    size_t sizeInBytes;
+};
+
+} // namespace fly
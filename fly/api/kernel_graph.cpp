@@ -0,0 +1,63 @@
+#include <stdexcept>
+#include <string>
+#include <fly/api/kernel_graph.h>
+
+namespace fly
+{
+
+KernelGraph::KernelGraph()
+{}
+
+size_t KernelGraph::addNode(const KernelId id, const std::vector<ParameterPair>& configuration)
+{
+    kernelIds.push_back(id);
+    configurations.push_back(configuration);
+    dependencies.push_back(std::vector<size_t>{});
+    return kernelIds.size() - 1;
+}
+
+void KernelGraph::addDependency(const size_t node, const size_t dependency)
+{
+    checkNodeIndex(node);
+
+    if (dependency >= node)
+    {
+        throw std::runtime_error(std::string("Node can only depend on earlier node, node index: ") + std::to_string(node)
+            + ", dependency index: " + std::to_string(dependency));
+    }
+
+    dependencies[node].push_back(dependency);
+}
+
+size_t KernelGraph::getNodeCount() const
+{
+    return kernelIds.size();
+}
+
+KernelId KernelGraph::getKernelId(const size_t node) const
+{
+    checkNodeIndex(node);
+    return kernelIds[node];
+}
+
+const std::vector<ParameterPair>& KernelGraph::getConfiguration(const size_t node) const
+{
+    checkNodeIndex(node);
+    return configurations[node];
+}
+
+const std::vector<size_t>& KernelGraph::getDependencies(const size_t node) const
+{
+    checkNodeIndex(node);
+    return dependencies[node];
+}
+
+void KernelGraph::checkNodeIndex(const size_t node) const
+{
+    if (node >= kernelIds.size())
+    {
+        throw std::runtime_error(std::string("Invalid kernel graph node index: ") + std::to_string(node));
+    }
+}
+
+} // namespace fly
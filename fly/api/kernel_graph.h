@@ -0,0 +1,78 @@
+/** @file kernel_graph.h
+  * Functionality related to describing graphs of dependent kernel runs with Fly API.
+  */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "fly/api/parameter_pair.h"
+#include "fly/fly_types.h"
+
+namespace fly
+{
+
+/** @class KernelGraph
+  * Class which describes sequence of kernel runs executed together with Tuner::runGraph method. Nodes are kernels with configurations,
+  * listed in program order. Dependencies between nodes are inferred from access types of vector arguments shared by kernels, additional
+  * dependencies can be added explicitly. Independent nodes may be executed concurrently on separate compute queues.
+  */
+class KernelGraph
+{
+public:
+    /** @fn KernelGraph()
+      * Constructor, which creates empty kernel graph.
+      */
+    KernelGraph();
+
+    /** @fn size_t addNode(const KernelId id, const std::vector<ParameterPair>& configuration)
+      * Adds kernel run to the end of graph. Node is executed after all earlier nodes which write arguments it reads, or which access
+      * arguments it writes.
+      * @param id Id of kernel which will be run.
+      * @param configuration Configuration of kernel which will be run.
+      * @return Index of the added node.
+      */
+    size_t addNode(const KernelId id, const std::vector<ParameterPair>& configuration);
+
+    /** @fn void addDependency(const size_t node, const size_t dependency)
+      * Adds dependency which cannot be inferred from kernel arguments, e.g. when kernels communicate through persistent argument.
+      * @param node Index of node which will wait for dependency.
+      * @param dependency Index of earlier node which has to be completed first.
+      */
+    void addDependency(const size_t node, const size_t dependency);
+
+    /** @fn size_t getNodeCount() const
+      * Getter for number of nodes in graph.
+      * @return Number of nodes in graph.
+      */
+    size_t getNodeCount() const;
+
+    /** @fn KernelId getKernelId(const size_t node) const
+      * Getter for id of kernel run by specified node.
+      * @param node Index of node.
+      * @return Id of kernel run by specified node.
+      */
+    KernelId getKernelId(const size_t node) const;
+
+    /** @fn const std::vector<ParameterPair>& getConfiguration(const size_t node) const
+      * Getter for configuration of kernel run by specified node.
+      * @param node Index of node.
+      * @return Configuration of kernel run by specified node.
+      */
+    const std::vector<ParameterPair>& getConfiguration(const size_t node) const;
+
+    /** @fn const std::vector<size_t>& getDependencies(const size_t node) const
+      * Getter for explicitly added dependencies of specified node.
+      * @param node Index of node.
+      * @return Indices of nodes which specified node explicitly depends on.
+      */
+    const std::vector<size_t>& getDependencies(const size_t node) const;
+
+private:
+    std::vector<KernelId> kernelIds;
+    std::vector<std::vector<ParameterPair>> configurations;
+    std::vector<std::vector<size_t>> dependencies;
+
+    void checkNodeIndex(const size_t node) const;
+};
+
+} // namespace fly
@@ -0,0 +1,187 @@
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include <fly/api/searcher/annealing_searcher.h>
+#include <fly/kernel/configuration_space.h>
+
+namespace fly
+{
+
+// Number of explored neighbours which are skipped before searcher jumps to random configuration
+static const size_t maximumNeighbourAttempts = 100;
+
+AnnealingSearcher::AnnealingSearcher() :
+    AnnealingSearcher(4.0, 0.95, std::random_device()())
+{}
+
+AnnealingSearcher::AnnealingSearcher(const double maximumTemperature, const double coolingFactor, const uint64_t seed) :
+    configurationSpace(nullptr),
+    randomSearcher(seed),
+    currentIndex(0),
+    currentDuration(0),
+    maximumTemperature(maximumTemperature),
+    coolingFactor(coolingFactor),
+    temperature(maximumTemperature),
+    generator(seed)
+{
+    if (maximumTemperature <= 0.0)
+    {
+        throw std::runtime_error("Maximum temperature of annealing searcher must be greater than zero");
+    }
+
+    if (coolingFactor <= 0.0 || coolingFactor > 1.0)
+    {
+        throw std::runtime_error("Cooling factor of annealing searcher must lie in range (0, 1]");
+    }
+}
+
+void AnnealingSearcher::initialize(const ConfigurationSpace& configurationSpace)
+{
+    this->configurationSpace = &configurationSpace;
+    randomSearcher.initialize(configurationSpace);
+    exploredDurations.clear();
+    currentIndex = configurationSpace.getSize();
+    temperature = maximumTemperature;
+}
+
+uint64_t AnnealingSearcher::getNextConfiguration()
+{
+    if (currentIndex == configurationSpace->getSize())
+    {
+        return randomSearcher.getNextConfiguration();
+    }
+
+    for (size_t attempt = 0; attempt < maximumNeighbourAttempts; ++attempt)
+    {
+        const uint64_t neighbour = getNeighbour(currentIndex);
+
+        if (neighbour == configurationSpace->getSize())
+        {
+            continue;
+        }
+
+        auto explored = exploredDurations.find(neighbour);
+
+        if (explored == exploredDurations.end())
+        {
+            return neighbour;
+        }
+
+        // Explored neighbour is not run again, but the walk can still move through it
+        if (acceptState(explored->second))
+        {
+            currentIndex = neighbour;
+            currentDuration = explored->second;
+        }
+    }
+
+    return randomSearcher.getNextConfiguration();
+}
+
+void AnnealingSearcher::updateResult(const uint64_t index, const ComputationResult& result)
+{
+    const uint64_t duration = result.getDuration();
+    exploredDurations[index] = duration;
+    randomSearcher.updateResult(index, result);
+
+    if (currentIndex == configurationSpace->getSize() || acceptState(duration))
+    {
+        currentIndex = index;
+        currentDuration = duration;
+    }
+
+    temperature *= coolingFactor;
+}
+
+uint64_t AnnealingSearcher::getNeighbour(const uint64_t index)
+{
+    std::vector<uint64_t> subspaceIndices = configurationSpace->splitIndex(index);
+
+    // Kernel without tuning parameters has no subspaces, so there is no neighbour to move to
+    if (subspaceIndices.empty())
+    {
+        return configurationSpace->getSize();
+    }
+
+    std::uniform_int_distribution<size_t> subspaceDistribution(0, subspaceIndices.size() - 1);
+    const size_t subspaceIndex = subspaceDistribution(generator);
+    const ConfigurationSubspace& subspace = configurationSpace->getSubspace(subspaceIndex);
+    const std::vector<KernelParameter>& parameters = subspace.getParameters();
+
+    if (subspace.getSize() < 2)
+    {
+        return configurationSpace->getSize();
+    }
+
+    std::uniform_int_distribution<size_t> parameterDistribution(0, parameters.size() - 1);
+    const size_t parameterIndex = parameterDistribution(generator);
+    const KernelParameter& parameter = parameters[parameterIndex];
+    const size_t valueCount = parameter.getValues().size();
+
+    if (valueCount < 2)
+    {
+        return configurationSpace->getSize();
+    }
+
+    std::vector<ParameterPair> configuration;
+    subspace.appendConfiguration(subspaceIndices[subspaceIndex], configuration);
+
+    // Value is shifted by random non-zero offset, so that the neighbour always differs from the current configuration
+    std::uniform_int_distribution<size_t> offsetDistribution(1, valueCount - 1);
+    size_t valueIndex = 0;
+
+    for (size_t i = 0; i < valueCount; ++i)
+    {
+        const bool equal = parameter.hasValuesDouble() ? parameter.getValuesDouble()[i] == configuration[parameterIndex].getValueDouble()
+            : parameter.getValues()[i] == configuration[parameterIndex].getValue();
+
+        if (equal)
+        {
+            valueIndex = i;
+            break;
+        }
+    }
+
+    valueIndex = (valueIndex + offsetDistribution(generator)) % valueCount;
+
+    if (parameter.hasValuesDouble())
+    {
+        configuration[parameterIndex] = ParameterPair(parameter.getName(), parameter.getValuesDouble()[valueIndex]);
+    }
+    else
+    {
+        configuration[parameterIndex] = ParameterPair(parameter.getName(), parameter.getValues()[valueIndex]);
+    }
+
+    subspaceIndices[subspaceIndex] = subspace.getIndex(configuration);
+    const uint64_t neighbour = configurationSpace->combineIndices(subspaceIndices);
+
+    if (!configurationSpace->isValid(neighbour))
+    {
+        return configurationSpace->getSize();
+    }
+
+    return neighbour;
+}
+
+bool AnnealingSearcher::acceptState(const uint64_t duration)
+{
+    if (duration < currentDuration)
+    {
+        return true;
+    }
+
+    if (temperature <= 0.0 || currentDuration == 0)
+    {
+        return false;
+    }
+
+    // Acceptance probability depends on relative slowdown, so that it does not depend on absolute kernel duration
+    const double slowdown = (static_cast<double>(duration) - static_cast<double>(currentDuration)) / static_cast<double>(currentDuration);
+    const double probability = std::exp(-slowdown / temperature);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+    return distribution(generator) < probability;
+}
+
+} // namespace fly
@@ -0,0 +1,53 @@
+/** @file annealing_searcher.h
+  * Searcher based on simulated annealing.
+  */
+#pragma once
+
+#include <map>
+#include <random>
+#include <fly/api/searcher/random_searcher.h>
+
+namespace fly
+{
+
+/** @class AnnealingSearcher
+  * Searcher which explores neighbourhood of the current configuration. Neighbouring configurations differ in value of a single parameter.
+  * Slower configuration replaces the current one with probability which decreases with temperature. When no unexplored neighbour is
+  * found, searcher jumps to random unexplored configuration.
+  */
+class AnnealingSearcher : public Searcher
+{
+public:
+    /** @fn AnnealingSearcher()
+      * Initializes annealing searcher with maximum temperature 4.0, cooling factor 0.95 and nondeterministic seed.
+      */
+    AnnealingSearcher();
+
+    /** @fn explicit AnnealingSearcher(const double maximumTemperature, const double coolingFactor, const uint64_t seed)
+      * Initializes annealing searcher.
+      * @param maximumTemperature Initial temperature. Higher temperature makes acceptance of slower configurations more likely.
+      * @param coolingFactor Factor by which temperature is multiplied after each explored configuration. Must lie in range (0, 1].
+      * @param seed Seed of random number generator.
+      */
+    explicit AnnealingSearcher(const double maximumTemperature, const double coolingFactor, const uint64_t seed);
+
+    void initialize(const ConfigurationSpace& configurationSpace) override;
+    uint64_t getNextConfiguration() override;
+    void updateResult(const uint64_t index, const ComputationResult& result) override;
+
+private:
+    const ConfigurationSpace* configurationSpace;
+    RandomSearcher randomSearcher;
+    std::map<uint64_t, uint64_t> exploredDurations;
+    uint64_t currentIndex;
+    uint64_t currentDuration;
+    double maximumTemperature;
+    double coolingFactor;
+    double temperature;
+    std::mt19937_64 generator;
+
+    uint64_t getNeighbour(const uint64_t index);
+    bool acceptState(const uint64_t duration);
+};
+
+} // namespace fly
@@ -0,0 +1,33 @@
+#include <fly/api/searcher/full_searcher.h>
+#include <fly/kernel/configuration_space.h>
+
+namespace fly
+{
+
+FullSearcher::FullSearcher() :
+    configurationSpace(nullptr),
+    nextIndex(0)
+{}
+
+void FullSearcher::initialize(const ConfigurationSpace& configurationSpace)
+{
+    this->configurationSpace = &configurationSpace;
+    nextIndex = configurationSpace.getNextValidIndex(0);
+}
+
+uint64_t FullSearcher::getNextConfiguration()
+{
+    const uint64_t result = nextIndex;
+
+    if (nextIndex < configurationSpace->getSize())
+    {
+        nextIndex = configurationSpace->getNextValidIndex(nextIndex + 1);
+    }
+
+    return result;
+}
+
+void FullSearcher::updateResult(const uint64_t, const ComputationResult&)
+{}
+
+} // namespace fly
@@ -0,0 +1,31 @@
+/** @file full_searcher.h
+  * Searcher which explores all valid configurations.
+  */
+#pragma once
+
+#include <fly/api/searcher/searcher.h>
+
+namespace fly
+{
+
+/** @class FullSearcher
+  * Searcher which explores all configurations which satisfy kernel constraints in order of their indices.
+  */
+class FullSearcher : public Searcher
+{
+public:
+    /** @fn FullSearcher()
+      * Initializes full searcher.
+      */
+    FullSearcher();
+
+    void initialize(const ConfigurationSpace& configurationSpace) override;
+    uint64_t getNextConfiguration() override;
+    void updateResult(const uint64_t index, const ComputationResult& result) override;
+
+private:
+    const ConfigurationSpace* configurationSpace;
+    uint64_t nextIndex;
+};
+
+} // namespace fly
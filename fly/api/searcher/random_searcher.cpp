@@ -0,0 +1,63 @@
+#include <fly/api/searcher/random_searcher.h>
+#include <fly/kernel/configuration_space.h>
+
+namespace fly
+{
+
+RandomSearcher::RandomSearcher() :
+    RandomSearcher(std::random_device()())
+{}
+
+RandomSearcher::RandomSearcher(const uint64_t seed) :
+    configurationSpace(nullptr),
+    generator(seed)
+{}
+
+void RandomSearcher::initialize(const ConfigurationSpace& configurationSpace)
+{
+    this->configurationSpace = &configurationSpace;
+    exploredIndices.clear();
+}
+
+uint64_t RandomSearcher::getNextConfiguration()
+{
+    const uint64_t size = configurationSpace->getSize();
+    std::uniform_int_distribution<uint64_t> distribution(0, size - 1);
+
+    uint64_t start = configurationSpace->getNextValidIndex(distribution(generator));
+    if (start == size)
+    {
+        start = configurationSpace->getNextValidIndex(0);
+    }
+
+    if (start == size)
+    {
+        return size;
+    }
+
+    uint64_t index = start;
+
+    while (exploredIndices.find(index) != exploredIndices.end())
+    {
+        index = configurationSpace->getNextValidIndex(index + 1);
+        if (index == size)
+        {
+            index = configurationSpace->getNextValidIndex(0);
+        }
+
+        if (index == start)
+        {
+            return size;
+        }
+    }
+
+    exploredIndices.insert(index);
+    return index;
+}
+
+void RandomSearcher::updateResult(const uint64_t index, const ComputationResult&)
+{
+    exploredIndices.insert(index);
+}
+
+} // namespace fly
@@ -0,0 +1,42 @@
+/** @file random_searcher.h
+  * Searcher which explores valid configurations in random order.
+  */
+#pragma once
+
+#include <random>
+#include <unordered_set>
+#include <fly/api/searcher/searcher.h>
+
+namespace fly
+{
+
+/** @class RandomSearcher
+  * Searcher which explores configurations which satisfy kernel constraints in random order, each configuration is explored at most once.
+  * Random index is drawn from the whole configuration space and moved to the nearest unexplored valid configuration, so that
+  * configuration space never has to be enumerated.
+  */
+class RandomSearcher : public Searcher
+{
+public:
+    /** @fn RandomSearcher()
+      * Initializes random searcher with nondeterministic seed.
+      */
+    RandomSearcher();
+
+    /** @fn explicit RandomSearcher(const uint64_t seed)
+      * Initializes random searcher with specified seed. Searchers with the same seed explore configurations in the same order.
+      * @param seed Seed of random number generator.
+      */
+    explicit RandomSearcher(const uint64_t seed);
+
+    void initialize(const ConfigurationSpace& configurationSpace) override;
+    uint64_t getNextConfiguration() override;
+    void updateResult(const uint64_t index, const ComputationResult& result) override;
+
+private:
+    const ConfigurationSpace* configurationSpace;
+    std::unordered_set<uint64_t> exploredIndices;
+    std::mt19937_64 generator;
+};
+
+} // namespace fly
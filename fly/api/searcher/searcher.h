@@ -0,0 +1,47 @@
+/** @file searcher.h
+  * Interface for implementing kernel configuration searchers.
+  */
+#pragma once
+
+#include <cstdint>
+#include <fly/api/computation_result.h>
+
+namespace fly
+{
+
+class ConfigurationSpace;
+
+/** @class Searcher
+  * Class which is used to decide which configuration will be run next during offline kernel tuning. Configurations are identified by
+  * their index inside kernel configuration space, see configuration_space.h.
+  */
+class Searcher
+{
+public:
+    /** @fn virtual ~Searcher() = default
+      * Searcher destructor. Inheriting class can override destructor with custom implementation. Default implementation is provided
+      * by Fly framework.
+      */
+    virtual ~Searcher() = default;
+
+    /** @fn virtual void initialize(const ConfigurationSpace& configurationSpace) = 0
+      * Prepares searcher for tuning. Configuration space remains valid until tuning of the kernel is finished.
+      * @param configurationSpace Configuration space of the tuned kernel.
+      */
+    virtual void initialize(const ConfigurationSpace& configurationSpace) = 0;
+
+    /** @fn virtual uint64_t getNextConfiguration() = 0
+      * Selects configuration which will be run next. Returned configuration must satisfy all kernel constraints.
+      * @return Index of the next configuration. Size of configuration space if there are no more configurations to explore.
+      */
+    virtual uint64_t getNextConfiguration() = 0;
+
+    /** @fn virtual void updateResult(const uint64_t index, const ComputationResult& result) = 0
+      * Informs searcher about result of computation of configuration with specified index.
+      * @param index Index of the computed configuration.
+      * @param result Result of the computation. Failed computations have maximum duration.
+      */
+    virtual void updateResult(const uint64_t index, const ComputationResult& result) = 0;
+};
+
+} // namespace fly
@@ -0,0 +1,31 @@
+#include <fly/api/stop_condition/configuration_count.h>
+
+namespace fly
+{
+
+ConfigurationCount::ConfigurationCount(const size_t count) :
+    currentCount(0),
+    targetCount(count)
+{}
+
+void ConfigurationCount::initialize()
+{
+    currentCount = 0;
+}
+
+void ConfigurationCount::updateStatus(const ComputationResult&)
+{
+    ++currentCount;
+}
+
+bool ConfigurationCount::isSatisfied() const
+{
+    return currentCount >= targetCount;
+}
+
+std::string ConfigurationCount::getStatusString() const
+{
+    return std::string("Explored configurations: ") + std::to_string(currentCount) + " / " + std::to_string(targetCount);
+}
+
+} // namespace fly
@@ -0,0 +1,34 @@
+/** @file configuration_count.h
+  * Stop condition based on number of explored configurations.
+  */
+#pragma once
+
+#include <cstddef>
+#include <fly/api/stop_condition/stop_condition.h>
+
+namespace fly
+{
+
+/** @class ConfigurationCount
+  * Stops tuning after specified number of configurations is explored.
+  */
+class ConfigurationCount : public StopCondition
+{
+public:
+    /** @fn explicit ConfigurationCount(const size_t count)
+      * Initializes configuration count stop condition.
+      * @param count Number of configurations which will be explored.
+      */
+    explicit ConfigurationCount(const size_t count);
+
+    void initialize() override;
+    void updateStatus(const ComputationResult& result) override;
+    bool isSatisfied() const override;
+    std::string getStatusString() const override;
+
+private:
+    size_t currentCount;
+    size_t targetCount;
+};
+
+} // namespace fly
@@ -0,0 +1,42 @@
+#include <algorithm>
+#include <limits>
+#include <fly/api/stop_condition/configuration_duration.h>
+
+namespace fly
+{
+
+ConfigurationDuration::ConfigurationDuration(const double duration) :
+    bestDuration(std::numeric_limits<uint64_t>::max()),
+    targetDuration(std::max(0.0, duration))
+{}
+
+void ConfigurationDuration::initialize()
+{
+    bestDuration = std::numeric_limits<uint64_t>::max();
+}
+
+void ConfigurationDuration::updateStatus(const ComputationResult& result)
+{
+    if (result.getStatus())
+    {
+        bestDuration = std::min(bestDuration, result.getDuration());
+    }
+}
+
+bool ConfigurationDuration::isSatisfied() const
+{
+    return bestDuration != std::numeric_limits<uint64_t>::max() && static_cast<double>(bestDuration) / 1000000.0 <= targetDuration;
+}
+
+std::string ConfigurationDuration::getStatusString() const
+{
+    if (bestDuration == std::numeric_limits<uint64_t>::max())
+    {
+        return std::string("No successful configuration found yet, target duration: ") + std::to_string(targetDuration) + "ms";
+    }
+
+    return std::string("Best configuration duration: ") + std::to_string(static_cast<double>(bestDuration) / 1000000.0) + "ms / "
+        + std::to_string(targetDuration) + "ms";
+}
+
+} // namespace fly
@@ -0,0 +1,34 @@
+/** @file configuration_duration.h
+  * Stop condition based on duration of the best configuration.
+  */
+#pragma once
+
+#include <cstdint>
+#include <fly/api/stop_condition/stop_condition.h>
+
+namespace fly
+{
+
+/** @class ConfigurationDuration
+  * Stops tuning once configuration with duration equal to or below specified target duration is found.
+  */
+class ConfigurationDuration : public StopCondition
+{
+public:
+    /** @fn explicit ConfigurationDuration(const double duration)
+      * Initializes configuration duration stop condition.
+      * @param duration Target configuration duration in milliseconds.
+      */
+    explicit ConfigurationDuration(const double duration);
+
+    void initialize() override;
+    void updateStatus(const ComputationResult& result) override;
+    bool isSatisfied() const override;
+    std::string getStatusString() const override;
+
+private:
+    uint64_t bestDuration;
+    double targetDuration;
+};
+
+} // namespace fly
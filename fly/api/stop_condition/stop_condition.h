@@ -0,0 +1,48 @@
+/** @file stop_condition.h
+  * Interface for implementing tuning stop conditions.
+  */
+#pragma once
+
+#include <string>
+#include <fly/api/computation_result.h>
+
+namespace fly
+{
+
+/** @class StopCondition
+  * Class which decides whether offline kernel tuning should be stopped before all configurations are explored.
+  */
+class StopCondition
+{
+public:
+    /** @fn virtual ~StopCondition() = default
+      * Stop condition destructor. Inheriting class can override destructor with custom implementation. Default implementation is
+      * provided by Fly framework.
+      */
+    virtual ~StopCondition() = default;
+
+    /** @fn virtual void initialize() = 0
+      * Called once before tuning starts.
+      */
+    virtual void initialize() = 0;
+
+    /** @fn virtual void updateStatus(const ComputationResult& result) = 0
+      * Called after each explored configuration.
+      * @param result Result of the computation. Failed computations have maximum duration.
+      */
+    virtual void updateStatus(const ComputationResult& result) = 0;
+
+    /** @fn virtual bool isSatisfied() const = 0
+      * Checks whether tuning should be stopped.
+      * @return True if tuning should be stopped. False otherwise.
+      */
+    virtual bool isSatisfied() const = 0;
+
+    /** @fn virtual std::string getStatusString() const = 0
+      * Returns description of current stop condition status, which is logged after each explored configuration.
+      * @return Stop condition status.
+      */
+    virtual std::string getStatusString() const = 0;
+};
+
+} // namespace fly
@@ -0,0 +1,35 @@
+#include <algorithm>
+#include <fly/api/stop_condition/tuning_duration.h>
+
+namespace fly
+{
+
+TuningDuration::TuningDuration(const double duration) :
+    initialTime(std::chrono::steady_clock::now()),
+    targetDuration(std::max(0.0, duration))
+{}
+
+void TuningDuration::initialize()
+{
+    initialTime = std::chrono::steady_clock::now();
+}
+
+void TuningDuration::updateStatus(const ComputationResult&)
+{}
+
+bool TuningDuration::isSatisfied() const
+{
+    return getElapsedSeconds() >= targetDuration;
+}
+
+std::string TuningDuration::getStatusString() const
+{
+    return std::string("Elapsed tuning time: ") + std::to_string(getElapsedSeconds()) + " / " + std::to_string(targetDuration) + " seconds";
+}
+
+double TuningDuration::getElapsedSeconds() const
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - initialTime).count();
+}
+
+} // namespace fly
@@ -0,0 +1,37 @@
+/** @file tuning_duration.h
+  * Stop condition based on total tuning time.
+  */
+#pragma once
+
+#include <chrono>
+#include <fly/api/stop_condition/stop_condition.h>
+
+namespace fly
+{
+
+/** @class TuningDuration
+  * Stops tuning after specified amount of wall-clock time passes. Configuration which is running when the time limit is reached is
+  * finished first.
+  */
+class TuningDuration : public StopCondition
+{
+public:
+    /** @fn explicit TuningDuration(const double duration)
+      * Initializes tuning duration stop condition.
+      * @param duration Maximum tuning duration in seconds.
+      */
+    explicit TuningDuration(const double duration);
+
+    void initialize() override;
+    void updateStatus(const ComputationResult& result) override;
+    bool isSatisfied() const override;
+    std::string getStatusString() const override;
+
+private:
+    std::chrono::steady_clock::time_point initialTime;
+    double targetDuration;
+
+    double getElapsedSeconds() const;
+};
+
+} // namespace fly
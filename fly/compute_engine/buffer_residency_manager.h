@@ -0,0 +1,271 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <fly/api/device_memory_statistics.h>
+#include <fly/kernel_argument/kernel_argument.h>
+#include <fly/utility/logger.h>
+#include "fly/fly_types.h"
+
+namespace fly
+{
+
+// Accounting of device memory occupied by argument buffers, shared by compute engines. Buffers are kept in recency order, most recently
+// used buffer is first. Once the budget would be exceeded, least recently used buffers are selected for eviction. Read-only buffers can be
+// uploaded again from host data of their arguments, contents of other buffers are spilled to host and restored on their next use.
+class BufferResidencyManager
+{
+public:
+    // Constructor
+    BufferResidencyManager() :
+        budget(0),
+        currentUsage(0),
+        peakUsage(0),
+        evictionCount(0),
+        spillCount(0),
+        launchIndex(0)
+    {}
+
+    // Core methods
+    void addBuffer(const ArgumentId id, const size_t size, const ArgumentAccessType accessType)
+    {
+        removeBuffer(id);
+        entries.emplace_front(id, size, accessType, launchIndex);
+        index.insert(std::make_pair(id, entries.begin()));
+        increaseUsage(size);
+    }
+
+    void removeBuffer(const ArgumentId id)
+    {
+        auto indexPointer = index.find(id);
+
+        if (indexPointer != index.end())
+        {
+            currentUsage -= indexPointer->second->size;
+            entries.erase(indexPointer->second);
+            index.erase(indexPointer);
+        }
+    }
+
+    void resizeBuffer(const ArgumentId id, const size_t size)
+    {
+        auto indexPointer = index.find(id);
+
+        if (indexPointer != index.end())
+        {
+            currentUsage -= indexPointer->second->size;
+            indexPointer->second->size = size;
+            increaseUsage(size);
+        }
+    }
+
+    void touchBuffer(const ArgumentId id)
+    {
+        auto indexPointer = index.find(id);
+
+        if (indexPointer != index.end())
+        {
+            indexPointer->second->launchIndex = launchIndex;
+            entries.splice(entries.begin(), entries, indexPointer->second);
+        }
+    }
+
+    // Persistent buffers are accounted for, but they are never evicted
+    void addPersistentBuffer(const ArgumentId id, const size_t size)
+    {
+        removePersistentBuffer(id);
+        persistentBuffers.insert(std::make_pair(id, size));
+        increaseUsage(size);
+    }
+
+    void removePersistentBuffer(const ArgumentId id)
+    {
+        auto bufferPointer = persistentBuffers.find(id);
+
+        if (bufferPointer != persistentBuffers.end())
+        {
+            currentUsage -= bufferPointer->second;
+            persistentBuffers.erase(bufferPointer);
+        }
+    }
+
+    // Buffers used since the start of the latest launch cannot be evicted, so that launch which is being set up does not lose its buffers
+    void beginLaunch(const std::vector<KernelArgument*>& arguments)
+    {
+        launchIndex++;
+
+        for (const auto argument : arguments)
+        {
+            if (argument->getUploadType() == ArgumentUploadType::Vector)
+            {
+                touchBuffer(argument->getId());
+            }
+        }
+    }
+
+    std::vector<ArgumentId> getEvictionCandidates(const size_t incomingSize) const
+    {
+        std::vector<ArgumentId> result;
+
+        if (budget == 0)
+        {
+            return result;
+        }
+
+        size_t usage = currentUsage;
+
+        for (auto entry = entries.rbegin(); entry != entries.rend() && usage + incomingSize > budget; ++entry)
+        {
+            if (entry->launchIndex != launchIndex)
+            {
+                result.push_back(entry->id);
+                usage -= entry->size;
+            }
+        }
+
+        if (usage + incomingSize > budget)
+        {
+            Logger::getLogger().log(LoggingLevel::Warning, "Device memory budget of " + std::to_string(budget) + " bytes is exceeded, "
+                + std::to_string(usage + incomingSize) + " bytes are required by buffers which cannot be evicted");
+        }
+
+        return result;
+    }
+
+    // Buffer has to be removed afterwards
+    void evictBuffer(const ArgumentId id)
+    {
+        removeBuffer(id);
+        evictionCount++;
+    }
+
+    bool isSpillRequired(const ArgumentId id) const
+    {
+        auto indexPointer = index.find(id);
+        return indexPointer != index.end() && indexPointer->second->accessType != ArgumentAccessType::ReadOnly;
+    }
+
+    void storeSpilledArgument(KernelArgument argument)
+    {
+        const ArgumentId id = argument.getId();
+        spilledArguments.erase(id);
+        spilledArguments.insert(std::make_pair(id, std::unique_ptr<KernelArgument>(new KernelArgument(std::move(argument)))));
+        spillCount++;
+    }
+
+    const KernelArgument* findSpilledArgument(const ArgumentId id) const
+    {
+        auto argumentPointer = spilledArguments.find(id);
+
+        if (argumentPointer == spilledArguments.end())
+        {
+            return nullptr;
+        }
+
+        return argumentPointer->second.get();
+    }
+
+    // Ownership of spilled data is transferred to caller, which uploads it into new buffer
+    std::unique_ptr<KernelArgument> takeSpilledArgument(const ArgumentId id)
+    {
+        auto argumentPointer = spilledArguments.find(id);
+
+        if (argumentPointer == spilledArguments.end())
+        {
+            return nullptr;
+        }
+
+        std::unique_ptr<KernelArgument> result = std::move(argumentPointer->second);
+        spilledArguments.erase(argumentPointer);
+        return result;
+    }
+
+    void releaseSpilledArgument(const ArgumentId id)
+    {
+        spilledArguments.erase(id);
+    }
+
+    void releaseSpilledArguments()
+    {
+        spilledArguments.clear();
+    }
+
+    void releaseSpilledArguments(const ArgumentAccessType accessType)
+    {
+        for (auto iterator = spilledArguments.begin(); iterator != spilledArguments.end();)
+        {
+            if (iterator->second->getAccessType() == accessType)
+            {
+                iterator = spilledArguments.erase(iterator);
+            }
+            else
+            {
+                ++iterator;
+            }
+        }
+    }
+
+    // Setters
+    void setBudget(const size_t budget)
+    {
+        this->budget = budget;
+    }
+
+    // Getters
+    size_t getBudget() const
+    {
+        return budget;
+    }
+
+    DeviceMemoryStatistics getStatistics() const
+    {
+        return DeviceMemoryStatistics(currentUsage, peakUsage, budget, evictionCount, spillCount);
+    }
+
+private:
+    struct ResidentBuffer
+    {
+        ResidentBuffer(const ArgumentId id, const size_t size, const ArgumentAccessType accessType, const uint64_t launchIndex) :
+            id(id),
+            size(size),
+            accessType(accessType),
+            launchIndex(launchIndex)
+        {}
+
+        ArgumentId id;
+        size_t size;
+        ArgumentAccessType accessType;
+        uint64_t launchIndex;
+    };
+
+    using BufferIterator = std::list<ResidentBuffer>::iterator;
+
+    // Attributes
+    size_t budget;
+    size_t currentUsage;
+    size_t peakUsage;
+    uint64_t evictionCount;
+    uint64_t spillCount;
+    uint64_t launchIndex;
+    std::list<ResidentBuffer> entries;
+    std::unordered_map<ArgumentId, BufferIterator> index;
+    std::map<ArgumentId, size_t> persistentBuffers;
+    std::map<ArgumentId, std::unique_ptr<KernelArgument>> spilledArguments;
+
+    // Helper methods
+    void increaseUsage(const size_t size)
+    {
+        currentUsage += size;
+        peakUsage = std::max(peakUsage, currentUsage);
+    }
+};
+
+} // namespace fly
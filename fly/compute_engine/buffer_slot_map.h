@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "fly/fly_types.h"
+
+namespace fly
+{
+
+// Buffers indexed directly by id of their kernel argument. Argument ids are assigned sequentially by argument manager, so lookup, insertion
+// and removal take constant time. Slots of removed buffers stay allocated and are reused once the same argument is uploaded again.
+template <typename BufferType>
+class BufferSlotMap
+{
+public:
+    // Constructor
+    BufferSlotMap() :
+        bufferCount(0)
+    {}
+
+    // Core methods
+    void insert(std::unique_ptr<BufferType> buffer)
+    {
+        const ArgumentId id = buffer->getKernelArgumentId();
+
+        if (id >= slots.size())
+        {
+            slots.resize(id + 1);
+        }
+
+        if (slots[id] == nullptr)
+        {
+            bufferCount++;
+        }
+
+        slots[id] = std::move(buffer);
+    }
+
+    BufferType* find(const ArgumentId id) const
+    {
+        if (id >= slots.size())
+        {
+            return nullptr;
+        }
+
+        return slots[id].get();
+    }
+
+    bool erase(const ArgumentId id)
+    {
+        if (find(id) == nullptr)
+        {
+            return false;
+        }
+
+        slots[id].reset();
+        bufferCount--;
+        return true;
+    }
+
+    void clear()
+    {
+        for (auto& slot : slots)
+        {
+            slot.reset();
+        }
+
+        bufferCount = 0;
+    }
+
+    template <typename Function>
+    void forEach(Function function) const
+    {
+        for (const auto& slot : slots)
+        {
+            if (slot != nullptr)
+            {
+                function(*slot);
+            }
+        }
+    }
+
+    // Getters
+    size_t size() const
+    {
+        return bufferCount;
+    }
+
+    bool empty() const
+    {
+        return bufferCount == 0;
+    }
+
+private:
+    // Attributes
+    std::vector<std::unique_ptr<BufferType>> slots;
+    size_t bufferCount;
+};
+
+} // namespace fly
@@ -4,11 +4,14 @@
 #include <string>
 #include <vector>
 #include <fly/api/device_info.h>
+#include <fly/api/device_memory_statistics.h>
+#include <fly/api/kernel_cache_statistics.h>
 #include <fly/api/output_descriptor.h>
 #include <fly/api/platform_info.h>
 #include <fly/dto/kernel_result.h>
 #include <fly/dto/kernel_runtime_data.h>
 #include <fly/enum/global_size_type.h>
+#include <fly/enum/kernel_cache_eviction_policy.h>
 #include <fly/kernel_argument/kernel_argument.h>
 #include "fly/fly_types.h"
 
@@ -27,6 +30,13 @@ public:
     virtual EventId runKernelAsync(const KernelRuntimeData& kernelData, const std::vector<KernelArgument*>& argumentPointers, const QueueId queue) = 0;
     virtual KernelResult getKernelResult(const EventId id, const std::vector<OutputDescriptor>& outputDescriptors) const = 0;
     virtual uint64_t getKernelOverhead(const EventId id) const = 0;
+    // Builds kernel into kernel cache without running it, may be called concurrently from multiple threads
+    virtual void compileKernel(const KernelRuntimeData& kernelData) = 0;
+
+    // Prepared launch methods, compiled kernel and launch geometry are resolved once in prepareKernel and reused by every launch
+    virtual void prepareKernel(const LaunchId id, const KernelRuntimeData& kernelData) = 0;
+    virtual EventId runPreparedKernelAsync(const LaunchId id, const std::vector<KernelArgument*>& argumentPointers, const QueueId queue) = 0;
+    virtual void releasePreparedKernel(const LaunchId id) = 0;
 
     // Utility methods
     virtual void setCompilerOptions(const std::string& options) = 0;
@@ -34,6 +44,10 @@ public:
     virtual void setAutomaticGlobalSizeCorrection(const bool flag) = 0;
     virtual void setKernelCacheUsage(const bool flag) = 0;
     virtual void setKernelCacheCapacity(const size_t capacity) = 0;
+    virtual void setKernelCacheByteBudget(const size_t budget) = 0;
+    virtual void setKernelCacheEvictionPolicy(const KernelCacheEvictionPolicy policy) = 0;
+    virtual KernelCacheStatistics getKernelCacheStatistics() const = 0;
+    virtual void setPersistentKernelCache(const std::string& directory, const size_t maxSizeInBytes) = 0;
     virtual void clearKernelCache() = 0;
 
     // Queue handling methods
@@ -42,6 +56,8 @@ public:
     virtual void synchronizeQueue(const QueueId queue) = 0;
     virtual void synchronizeDevice() = 0;
     virtual void clearEvents() = 0;
+    // Commands submitted to queue after this call start only after kernel event completes, host is not blocked
+    virtual void enqueueEventWait(const QueueId queue, const EventId id) = 0;
 
     // Argument handling methods
     virtual uint64_t uploadArgument(KernelArgument& kernelArgument) = 0;
@@ -60,6 +76,9 @@ public:
     virtual void clearBuffer(const ArgumentId id) = 0;
     virtual void clearBuffers() = 0;
     virtual void clearBuffers(const ArgumentAccessType accessType) = 0;
+    virtual ArgumentMemoryLocation getAutomaticMemoryLocation(const ArgumentAccessType accessType) const = 0;
+    virtual void setDeviceMemoryBudget(const size_t budget) = 0;
+    virtual DeviceMemoryStatistics getDeviceMemoryStatistics() const = 0;
 
     // Information retrieval methods
     virtual void printComputeAPIInfo(std::ostream& outputTarget) const = 0;
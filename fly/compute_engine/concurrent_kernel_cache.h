@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <fly/compute_engine/kernel_cache.h>
+#include <fly/compute_engine/kernel_fingerprint.h>
+#include <fly/utility/timer.h>
+
+namespace fly
+{
+
+// Thread-safe kernel cache which can be filled from multiple compilation threads. Entries are shared, so that eviction does not destroy
+// kernel which is still being launched by another thread. Concurrent requests for the same kernel wait for single build.
+template <typename Value> class ConcurrentKernelCache
+{
+public:
+    using Builder = std::function<std::shared_ptr<Value>(size_t& entrySize)>;
+
+    // Constructor
+    explicit ConcurrentKernelCache(const size_t capacity) :
+        cache(capacity)
+    {}
+
+    // Core methods
+    std::shared_ptr<Value> getOrBuild(const KernelFingerprint& key, const Builder& builder)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        auto cachePointer = cache.find(key);
+
+        if (cachePointer != nullptr)
+        {
+            return *cachePointer;
+        }
+
+        auto pendingPointer = pendingBuilds.find(key);
+
+        if (pendingPointer != pendingBuilds.end())
+        {
+            std::shared_future<std::shared_ptr<Value>> pendingBuild = pendingPointer->second;
+            lock.unlock();
+            return pendingBuild.get();
+        }
+
+        std::promise<std::shared_ptr<Value>> buildPromise;
+        pendingBuilds.insert(std::make_pair(key, buildPromise.get_future().share()));
+        lock.unlock();
+
+        std::shared_ptr<Value> value;
+        size_t entrySize = 0;
+        Timer buildTimer;
+
+        try
+        {
+            buildTimer.start();
+            value = builder(entrySize);
+            buildTimer.stop();
+        }
+        catch (...)
+        {
+            lock.lock();
+            pendingBuilds.erase(key);
+            lock.unlock();
+            buildPromise.set_exception(std::current_exception());
+            throw;
+        }
+
+        lock.lock();
+        cache.insert(key, value, entrySize, buildTimer.getElapsedTime());
+        pendingBuilds.erase(key);
+        lock.unlock();
+
+        buildPromise.set_value(value);
+        return value;
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        cache.clear();
+    }
+
+    // Setters
+    void setCapacity(const size_t capacity)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        cache.setCapacity(capacity);
+    }
+
+    void setByteBudget(const size_t byteBudget)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        cache.setByteBudget(byteBudget);
+    }
+
+    void setEvictionPolicy(const KernelCacheEvictionPolicy evictionPolicy)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        cache.setEvictionPolicy(evictionPolicy);
+    }
+
+    // Getters
+    KernelCacheStatistics getStatistics() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return cache.getStatistics();
+    }
+
+private:
+    // Attributes
+    KernelCache<KernelFingerprint, std::shared_ptr<Value>, KernelFingerprintHash> cache;
+    std::unordered_map<KernelFingerprint, std::shared_future<std::shared_ptr<Value>>, KernelFingerprintHash> pendingBuilds;
+    mutable std::mutex mutex;
+};
+
+} // namespace fly
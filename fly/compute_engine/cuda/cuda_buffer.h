@@ -1,6 +1,8 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -172,6 +174,42 @@ public:
         checkCUDAError(cuEventRecord(endEvent, stream), "cuEventRecord");
     }
 
+    static bool isFillPatternSizeSupported(const size_t patternSize)
+    {
+        return patternSize == 1 || patternSize == 2 || patternSize == 4;
+    }
+
+    void fillData(CUstream stream, const void* pattern, const size_t patternSize, CUevent startEvent, CUevent endEvent)
+    {
+        const CUdeviceptr target = memoryLocation == ArgumentMemoryLocation::Device ? deviceBuffer : hostBuffer;
+        checkCUDAError(cuEventRecord(startEvent, stream), "cuEventRecord");
+
+        if (patternSize == 1)
+        {
+            uint8_t value;
+            std::memcpy(&value, pattern, sizeof(value));
+            checkCUDAError(cuMemsetD8Async(target, value, bufferSize, stream), "cuMemsetD8Async");
+        }
+        else if (patternSize == 2)
+        {
+            uint16_t value;
+            std::memcpy(&value, pattern, sizeof(value));
+            checkCUDAError(cuMemsetD16Async(target, value, bufferSize / sizeof(value), stream), "cuMemsetD16Async");
+        }
+        else if (patternSize == 4)
+        {
+            uint32_t value;
+            std::memcpy(&value, pattern, sizeof(value));
+            checkCUDAError(cuMemsetD32Async(target, value, bufferSize / sizeof(value), stream), "cuMemsetD32Async");
+        }
+        else
+        {
+            throw std::runtime_error(std::string("Unsupported fill pattern size: ") + std::to_string(patternSize));
+        }
+
+        checkCUDAError(cuEventRecord(endEvent, stream), "cuEventRecord");
+    }
+
     void downloadData(void* destination, const size_t dataSize) const
     {
         if (bufferSize < dataSize)
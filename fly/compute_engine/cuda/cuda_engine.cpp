@@ -1,5 +1,6 @@
 #ifdef FLY_PLATFORM_CUDA
 
+#include <cstring>
 #include <stdexcept>
 #include <fly/compute_engine/cuda/cuda_engine.h>
 #include <fly/utility/fly_utility.h>
@@ -16,9 +17,9 @@ CUDAEngine::CUDAEngine(const DeviceIndex deviceIndex, const uint32_t queueCount)
     globalSizeType(GlobalSizeType::CUDA),
     globalSizeCorrection(false),
     kernelCacheFlag(true),
-    kernelCacheCapacity(10),
     persistentBufferFlag(true),
-    nextEventId(0)
+    nextEventId(0),
+    kernelCache(10)
 {
     Logger::logDebug("Initializing CUDA runtime");
     checkCUDAError(cuInit(0), "cuInit");
@@ -52,34 +53,16 @@ KernelResult CUDAEngine::runKernel(const KernelRuntimeData& kernelData, const st
 
 EventId CUDAEngine::runKernelAsync(const KernelRuntimeData& kernelData, const std::vector<KernelArgument*>& argumentPointers, const QueueId queue)
 {
+    bindContext();
     Timer overheadTimer;
     overheadTimer.start();
 
-    CUDAKernel* kernel;
-    std::unique_ptr<CUDAKernel> kernelUnique;
-
-    if (kernelCacheFlag)
-    {
-        if (kernelCache.find(std::make_pair(kernelData.getName(), kernelData.getSource())) == kernelCache.end())
-        {
-            if (kernelCache.size() >= kernelCacheCapacity)
-            {
-                clearKernelCache();
-            }
-            std::unique_ptr<CUDAProgram> program = createAndBuildProgram(kernelData.getSource());
-            auto kernel = MakeStdUnique<CUDAKernel>(program->getPtxSource(), kernelData.getName());
-            kernelCache.insert(std::make_pair(std::make_pair(kernelData.getName(), kernelData.getSource()), std::move(kernel)));
-        }
-        auto cachePointer = kernelCache.find(std::make_pair(kernelData.getName(), kernelData.getSource()));
-        kernel = cachePointer->second.get();
-    }
-    else
-    {
-        std::unique_ptr<CUDAProgram> program = createAndBuildProgram(kernelData.getSource());
-        kernelUnique = MakeStdUnique<CUDAKernel>(program->getPtxSource(), kernelData.getName());
-        kernel = kernelUnique.get();
-    }
+    // Kernel is held until it is enqueued, even if it gets evicted from cache by another thread meanwhile. Module is compiled and loaded
+    // before the engine is locked, other threads keep submitting work in the meantime.
+    std::shared_ptr<CUDAKernel> kernel = loadKernel(kernelData);
+    std::lock_guard<std::recursive_mutex> lock(mutex);
 
+    residencyManager.beginLaunch(argumentPointers);
     std::vector<CUdeviceptr*> kernelArguments = getKernelArguments(argumentPointers);
 
     overheadTimer.stop();
@@ -100,36 +83,88 @@ KernelResult CUDAEngine::getKernelResult(const EventId id, const std::vector<Out
     return result;
 }
 
+void CUDAEngine::compileKernel(const KernelRuntimeData& kernelData)
+{
+    // Compilation threads need engine context to load modules
+    bindContext();
+    loadKernel(kernelData);
+}
+
+void CUDAEngine::prepareKernel(const LaunchId id, const KernelRuntimeData& kernelData)
+{
+    bindContext();
+    std::shared_ptr<CUDAKernel> kernel = loadKernel(kernelData);
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    preparedKernels[id] = MakeStdUnique<CUDAPreparedKernel>(kernel, kernelData.getGlobalSize(), kernelData.getLocalSize(),
+        kernelData.getLocalMemoryModifiers());
+}
+
+EventId CUDAEngine::runPreparedKernelAsync(const LaunchId id, const std::vector<KernelArgument*>& argumentPointers, const QueueId queue)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    bindContext();
+    Timer overheadTimer;
+    overheadTimer.start();
+
+    auto preparedPointer = preparedKernels.find(id);
+    if (preparedPointer == preparedKernels.end())
+    {
+        throw std::runtime_error(std::string("Prepared kernel launch with following id does not exist: ") + std::to_string(id));
+    }
+
+    const CUDAPreparedKernel& preparedKernel = *preparedPointer->second;
+    residencyManager.beginLaunch(argumentPointers);
+    std::vector<CUdeviceptr*> kernelArguments = getKernelArguments(argumentPointers);
+
+    overheadTimer.stop();
+
+    return enqueueKernel(*preparedKernel.kernel, preparedKernel.globalSize, preparedKernel.localSize, kernelArguments,
+        getSharedMemorySizeInBytes(argumentPointers, preparedKernel.localMemoryModifiers), queue, overheadTimer.getElapsedTime());
+}
+
+void CUDAEngine::releasePreparedKernel(const LaunchId id)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    preparedKernels.erase(id);
+}
+
 uint64_t CUDAEngine::getKernelOverhead(const EventId id) const
 {
-    auto eventPointer = kernelEvents.find(id);
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    const auto* events = kernelEvents.find(id);
 
-    if (eventPointer == kernelEvents.end())
+    if (events == nullptr)
     {
         throw std::runtime_error(std::string("Kernel event with following id does not exist or its result was already retrieved: ")
             + std::to_string(id));
     }
 
-    return eventPointer->second.first->getOverhead();
+    return events->first->getOverhead();
 }
 
 void CUDAEngine::setCompilerOptions(const std::string& options)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     compilerOptions = options;
 }
 
 void CUDAEngine::setGlobalSizeType(const GlobalSizeType type)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     globalSizeType = type;
 }
 
 void CUDAEngine::setAutomaticGlobalSizeCorrection(const bool flag)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     globalSizeCorrection = flag;
 }
 
 void CUDAEngine::setKernelCacheUsage(const bool flag)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    bindContext();
+
     if (!flag)
     {
         clearKernelCache();
@@ -139,7 +174,30 @@ void CUDAEngine::setKernelCacheUsage(const bool flag)
 
 void CUDAEngine::setKernelCacheCapacity(const size_t capacity)
 {
-    kernelCacheCapacity = capacity;
+    kernelCache.setCapacity(capacity);
+}
+
+void CUDAEngine::setKernelCacheByteBudget(const size_t budget)
+{
+    kernelCache.setByteBudget(budget);
+}
+
+void CUDAEngine::setKernelCacheEvictionPolicy(const KernelCacheEvictionPolicy policy)
+{
+    kernelCache.setEvictionPolicy(policy);
+}
+
+KernelCacheStatistics CUDAEngine::getKernelCacheStatistics() const
+{
+    return kernelCache.getStatistics();
+}
+
+void CUDAEngine::setPersistentKernelCache(const std::string& directory, const size_t)
+{
+    if (!directory.empty())
+    {
+        throw std::runtime_error("Persistent kernel cache is not supported for CUDA backend");
+    }
 }
 
 void CUDAEngine::clearKernelCache()
@@ -166,6 +224,8 @@ std::vector<QueueId> CUDAEngine::getAllQueues() const
 
 void CUDAEngine::synchronizeQueue(const QueueId queue)
 {
+    bindContext();
+
     if (queue >= streams.size())
     {
         throw std::runtime_error(std::string("Invalid stream index: ") + std::to_string(queue));
@@ -176,6 +236,8 @@ void CUDAEngine::synchronizeQueue(const QueueId queue)
 
 void CUDAEngine::synchronizeDevice()
 {
+    bindContext();
+
     for (auto& stream : streams)
     {
         checkCUDAError(cuStreamSynchronize(stream->getStream()), "cuStreamSynchronize");
@@ -184,10 +246,32 @@ void CUDAEngine::synchronizeDevice()
 
 void CUDAEngine::clearEvents()
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     kernelEvents.clear();
     bufferEvents.clear();
 }
 
+void CUDAEngine::enqueueEventWait(const QueueId queue, const EventId id)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    bindContext();
+
+    if (queue >= streams.size())
+    {
+        throw std::runtime_error(std::string("Invalid stream index: ") + std::to_string(queue));
+    }
+
+    const auto* events = kernelEvents.find(id);
+
+    if (events == nullptr)
+    {
+        throw std::runtime_error(std::string("Kernel event with following id does not exist or its result was already retrieved: ")
+            + std::to_string(id));
+    }
+
+    checkCUDAError(cuStreamWaitEvent(streams.at(queue)->getStream(), events->second->getEvent(), 0), "cuStreamWaitEvent");
+}
+
 uint64_t CUDAEngine::uploadArgument(KernelArgument& kernelArgument)
 {
     if (kernelArgument.getUploadType() != ArgumentUploadType::Vector)
@@ -201,6 +285,9 @@ uint64_t CUDAEngine::uploadArgument(KernelArgument& kernelArgument)
 
 EventId CUDAEngine::uploadArgumentAsync(KernelArgument& kernelArgument, const QueueId queue)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    bindContext();
+
     if (queue >= streams.size())
     {
         throw std::runtime_error(std::string("Invalid stream index: ") + std::to_string(queue));
@@ -215,9 +302,22 @@ EventId CUDAEngine::uploadArgumentAsync(KernelArgument& kernelArgument, const Qu
     {
         return UINT64_MAX;
     }
-    
+
+    std::unique_ptr<KernelArgument> spilledArgument = residencyManager.takeSpilledArgument(kernelArgument.getId());
+    if (spilledArgument != nullptr)
+    {
+        return uploadSpilledArgument(*spilledArgument, queue);
+    }
+
+    // Zero-copy buffers use host memory of argument
+    if (kernelArgument.getMemoryLocation() != ArgumentMemoryLocation::HostZeroCopy)
+    {
+        reserveBufferMemory(kernelArgument.getDataSizeInBytes());
+        residencyManager.addBuffer(kernelArgument.getId(), kernelArgument.getDataSizeInBytes(), kernelArgument.getAccessType());
+    }
+
     std::unique_ptr<CUDABuffer> buffer = nullptr;
-    EventId eventId = nextEventId;
+    const EventId eventId = nextEventId++;
 
     Logger::getLogger().log(LoggingLevel::Debug, "Uploading buffer for argument " + std::to_string(kernelArgument.getId()) + ", event id: "
         + std::to_string(eventId));
@@ -225,21 +325,43 @@ EventId CUDAEngine::uploadArgumentAsync(KernelArgument& kernelArgument, const Qu
     if (kernelArgument.getMemoryLocation() == ArgumentMemoryLocation::HostZeroCopy)
     {
         buffer = MakeStdUnique<CUDABuffer>(kernelArgument, true);
-        bufferEvents.insert(std::make_pair(eventId, std::make_pair(MakeStdUnique<CUDAEvent>(eventId, false),
-            MakeStdUnique<CUDAEvent>(eventId, false))));
+        bufferEvents.insert(eventId, std::make_pair(createEvent(eventId, false), createEvent(eventId, false)));
+    }
+    else if (kernelArgument.getAccessType() == ArgumentAccessType::WriteOnly)
+    {
+        // Contents of output buffers are overwritten by kernel, host data is not transferred
+        buffer = MakeStdUnique<CUDABuffer>(kernelArgument, false);
+
+        if (kernelArgument.hasFillPattern() && CUDABuffer::isFillPatternSizeSupported(kernelArgument.getFillPatternPeriod()))
+        {
+            auto startEvent = createEvent(eventId, true);
+            auto endEvent = createEvent(eventId, true);
+            buffer->fillData(streams.at(queue)->getStream(), kernelArgument.getFillPattern().data(), kernelArgument.getFillPatternPeriod(),
+                startEvent->getEvent(), endEvent->getEvent());
+            bufferEvents.insert(eventId, std::make_pair(std::move(startEvent), std::move(endEvent)));
+        }
+        else
+        {
+            if (kernelArgument.hasFillPattern())
+            {
+                std::vector<uint8_t> filledData(kernelArgument.getDataSizeInBytes());
+                kernelArgument.fillWithPattern(filledData.data(), filledData.size());
+                buffer->uploadData(filledData.data(), filledData.size());
+            }
+            bufferEvents.insert(eventId, std::make_pair(createEvent(eventId, false), createEvent(eventId, false)));
+        }
     }
     else
     {
         buffer = MakeStdUnique<CUDABuffer>(kernelArgument, false);
-        auto startEvent = MakeStdUnique<CUDAEvent>(eventId, true);
-        auto endEvent = MakeStdUnique<CUDAEvent>(eventId, true);
+        auto startEvent = createEvent(eventId, true);
+        auto endEvent = createEvent(eventId, true);
         buffer->uploadData(streams.at(queue)->getStream(), kernelArgument.getData(), kernelArgument.getDataSizeInBytes(), startEvent->getEvent(),
             endEvent->getEvent());
-        bufferEvents.insert(std::make_pair(eventId, std::make_pair(std::move(startEvent), std::move(endEvent))));
+        bufferEvents.insert(eventId, std::make_pair(std::move(startEvent), std::move(endEvent)));
     }
 
     buffers.insert(std::move(buffer)); // buffer data will be stolen
-    nextEventId++;
     return eventId;
 }
 
@@ -251,11 +373,15 @@ uint64_t CUDAEngine::updateArgument(const ArgumentId id, const void* data, const
 
 EventId CUDAEngine::updateArgumentAsync(const ArgumentId id, const void* data, const size_t dataSizeInBytes, const QueueId queue)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    bindContext();
+
     if (queue >= streams.size())
     {
         throw std::runtime_error(std::string("Invalid stream index: ") + std::to_string(queue));
     }
 
+    restoreSpilledBuffer(id);
     CUDABuffer* buffer = findBuffer(id);
 
     if (buffer == nullptr)
@@ -263,9 +389,9 @@ EventId CUDAEngine::updateArgumentAsync(const ArgumentId id, const void* data, c
         throw std::runtime_error(std::string("Buffer with following id was not found: ") + std::to_string(id));
     }
 
-    EventId eventId = nextEventId;
-    auto startEvent = MakeStdUnique<CUDAEvent>(eventId, true);
-    auto endEvent = MakeStdUnique<CUDAEvent>(eventId, true);
+    const EventId eventId = nextEventId++;
+    auto startEvent = createEvent(eventId, true);
+    auto endEvent = createEvent(eventId, true);
 
     Logger::getLogger().log(LoggingLevel::Debug, "Updating buffer for argument " + std::to_string(id) + ", event id: " + std::to_string(eventId));
 
@@ -278,8 +404,7 @@ EventId CUDAEngine::updateArgumentAsync(const ArgumentId id, const void* data, c
         buffer->uploadData(streams.at(queue)->getStream(), data, dataSizeInBytes, startEvent->getEvent(), endEvent->getEvent());
     }
 
-    bufferEvents.insert(std::make_pair(eventId, std::make_pair(std::move(startEvent), std::move(endEvent))));
-    nextEventId++;
+    bufferEvents.insert(eventId, std::make_pair(std::move(startEvent), std::move(endEvent)));
     return eventId;
 }
 
@@ -291,21 +416,38 @@ uint64_t CUDAEngine::downloadArgument(const ArgumentId id, void* destination, co
 
 EventId CUDAEngine::downloadArgumentAsync(const ArgumentId id, void* destination, const size_t dataSizeInBytes, const QueueId queue) const
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    bindContext();
+
     if (queue >= streams.size())
     {
         throw std::runtime_error(std::string("Invalid stream index: ") + std::to_string(queue));
     }
 
     CUDABuffer* buffer = findBuffer(id);
+    const KernelArgument* spilledArgument = residencyManager.findSpilledArgument(id);
 
-    if (buffer == nullptr)
+    if (buffer == nullptr && spilledArgument == nullptr)
     {
         throw std::runtime_error(std::string("Buffer with following id was not found: ") + std::to_string(id));
     }
 
-    EventId eventId = nextEventId;
-    auto startEvent = MakeStdUnique<CUDAEvent>(eventId, true);
-    auto endEvent = MakeStdUnique<CUDAEvent>(eventId, true);
+    const EventId eventId = nextEventId++;
+
+    if (buffer == nullptr)
+    {
+        // Evicted buffer is served from its spilled contents
+        Logger::getLogger().log(LoggingLevel::Debug, "Downloading spilled buffer for argument " + std::to_string(id) + ", event id: "
+            + std::to_string(eventId));
+
+        const size_t dataSize = dataSizeInBytes == 0 ? spilledArgument->getDataSizeInBytes() : dataSizeInBytes;
+        std::memcpy(destination, spilledArgument->getData(), dataSize);
+        bufferEvents.insert(eventId, std::make_pair(createEvent(eventId, false), createEvent(eventId, false)));
+        return eventId;
+    }
+
+    auto startEvent = createEvent(eventId, true);
+    auto endEvent = createEvent(eventId, true);
 
     Logger::getLogger().log(LoggingLevel::Debug, "Downloading buffer for argument " + std::to_string(id) + ", event id: " + std::to_string(eventId));
 
@@ -318,14 +460,26 @@ EventId CUDAEngine::downloadArgumentAsync(const ArgumentId id, void* destination
         buffer->downloadData(streams.at(queue)->getStream(), destination, dataSizeInBytes, startEvent->getEvent(), endEvent->getEvent());
     }
 
-    bufferEvents.insert(std::make_pair(eventId, std::make_pair(std::move(startEvent), std::move(endEvent))));
-    nextEventId++;
+    bufferEvents.insert(eventId, std::make_pair(std::move(startEvent), std::move(endEvent)));
     return eventId;
 }
 
 KernelArgument CUDAEngine::downloadArgumentObject(const ArgumentId id, uint64_t* downloadDuration) const
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    bindContext();
     CUDABuffer* buffer = findBuffer(id);
+    const KernelArgument* spilledArgument = residencyManager.findSpilledArgument(id);
+
+    if (buffer == nullptr && spilledArgument != nullptr)
+    {
+        if (downloadDuration != nullptr)
+        {
+            *downloadDuration = 0;
+        }
+
+        return *spilledArgument;
+    }
 
     if (buffer == nullptr)
     {
@@ -335,16 +489,15 @@ KernelArgument CUDAEngine::downloadArgumentObject(const ArgumentId id, uint64_t*
     KernelArgument argument(buffer->getKernelArgumentId(), buffer->getBufferSize() / buffer->getElementSize(), buffer->getElementSize(),
         buffer->getDataType(), buffer->getMemoryLocation(), buffer->getAccessType(), ArgumentUploadType::Vector);
     
-    EventId eventId = nextEventId;
-    auto startEvent = MakeStdUnique<CUDAEvent>(eventId, true);
-    auto endEvent = MakeStdUnique<CUDAEvent>(eventId, true);
+    const EventId eventId = nextEventId++;
+    auto startEvent = createEvent(eventId, true);
+    auto endEvent = createEvent(eventId, true);
 
     Logger::getLogger().log(LoggingLevel::Debug, "Downloading buffer for argument " + std::to_string(id) + ", event id: " + std::to_string(eventId));
     buffer->downloadData(streams.at(getDefaultQueue())->getStream(), argument.getData(), argument.getDataSizeInBytes(), startEvent->getEvent(),
         endEvent->getEvent());
 
-    bufferEvents.insert(std::make_pair(eventId, std::make_pair(std::move(startEvent), std::move(endEvent))));
-    nextEventId++;
+    bufferEvents.insert(eventId, std::make_pair(std::move(startEvent), std::move(endEvent)));
 
     uint64_t duration = getArgumentOperationDuration(eventId);
     if (downloadDuration != nullptr)
@@ -363,11 +516,17 @@ uint64_t CUDAEngine::copyArgument(const ArgumentId destination, const ArgumentId
 
 EventId CUDAEngine::copyArgumentAsync(const ArgumentId destination, const ArgumentId source, const size_t dataSizeInBytes, const QueueId queue)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    bindContext();
+
     if (queue >= streams.size())
     {
         throw std::runtime_error(std::string("Invalid stream index: ") + std::to_string(queue));
     }
 
+    restoreSpilledBuffer(destination);
+    restoreSpilledBuffer(source);
+
     CUDABuffer* destinationBuffer = findBuffer(destination);
     CUDABuffer* sourceBuffer = findBuffer(source);
 
@@ -382,9 +541,9 @@ EventId CUDAEngine::copyArgumentAsync(const ArgumentId destination, const Argume
         throw std::runtime_error("Data type for buffers during copying operation must match");
     }
 
-    EventId eventId = nextEventId;
-    auto startEvent = MakeStdUnique<CUDAEvent>(eventId, true);
-    auto endEvent = MakeStdUnique<CUDAEvent>(eventId, true);
+    const EventId eventId = nextEventId++;
+    auto startEvent = createEvent(eventId, true);
+    auto endEvent = createEvent(eventId, true);
 
     Logger::getLogger().log(LoggingLevel::Debug, "Copying buffer for argument " + std::to_string(source) + " into buffer for argument "
         + std::to_string(destination) + ", event id: " + std::to_string(eventId));
@@ -399,37 +558,32 @@ EventId CUDAEngine::copyArgumentAsync(const ArgumentId destination, const Argume
         destinationBuffer->uploadData(streams.at(queue)->getStream(), sourceBuffer, dataSizeInBytes, startEvent->getEvent(), endEvent->getEvent());
     }
 
-    bufferEvents.insert(std::make_pair(eventId, std::make_pair(std::move(startEvent), std::move(endEvent))));
-    nextEventId++;
+    bufferEvents.insert(eventId, std::make_pair(std::move(startEvent), std::move(endEvent)));
     return eventId;
 }
 
 uint64_t CUDAEngine::persistArgument(KernelArgument& kernelArgument, const bool flag)
 {
-    bool bufferFound = false;
-    auto iterator = persistentBuffers.cbegin();
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    bindContext();
+    const bool bufferFound = persistentBuffers.find(kernelArgument.getId()) != nullptr;
 
-    while (iterator != persistentBuffers.cend())
+    if (bufferFound && !flag)
     {
-        if (iterator->get()->getKernelArgumentId() == kernelArgument.getId())
-        {
-            bufferFound = true;
-            if (!flag)
-            {
-                persistentBuffers.erase(iterator);
-            }
-            break;
-        }
-        else
-        {
-            ++iterator;
-        }
+        persistentBuffers.erase(kernelArgument.getId());
+        residencyManager.removePersistentBuffer(kernelArgument.getId());
     }
     
     if (flag && !bufferFound)
     {
+        if (kernelArgument.getMemoryLocation() != ArgumentMemoryLocation::HostZeroCopy)
+        {
+            reserveBufferMemory(kernelArgument.getDataSizeInBytes());
+            residencyManager.addPersistentBuffer(kernelArgument.getId(), kernelArgument.getDataSizeInBytes());
+        }
+
         std::unique_ptr<CUDABuffer> buffer = nullptr;
-        EventId eventId = nextEventId;
+        const EventId eventId = nextEventId++;
 
         Logger::getLogger().log(LoggingLevel::Debug, "Uploading persistent buffer for argument " + std::to_string(kernelArgument.getId())
             + ", event id: " + std::to_string(eventId));
@@ -437,21 +591,19 @@ uint64_t CUDAEngine::persistArgument(KernelArgument& kernelArgument, const bool
         if (kernelArgument.getMemoryLocation() == ArgumentMemoryLocation::HostZeroCopy)
         {
             buffer = MakeStdUnique<CUDABuffer>(kernelArgument, true);
-            bufferEvents.insert(std::make_pair(eventId, std::make_pair(MakeStdUnique<CUDAEvent>(eventId, false),
-                MakeStdUnique<CUDAEvent>(eventId, false))));
+            bufferEvents.insert(eventId, std::make_pair(createEvent(eventId, false), createEvent(eventId, false)));
         }
         else
         {
             buffer = MakeStdUnique<CUDABuffer>(kernelArgument, false);
-            auto startEvent = MakeStdUnique<CUDAEvent>(eventId, true);
-            auto endEvent = MakeStdUnique<CUDAEvent>(eventId, true);
+            auto startEvent = createEvent(eventId, true);
+            auto endEvent = createEvent(eventId, true);
             buffer->uploadData(streams.at(getDefaultQueue())->getStream(), kernelArgument.getData(), kernelArgument.getDataSizeInBytes(),
                 startEvent->getEvent(), endEvent->getEvent());
-            bufferEvents.insert(std::make_pair(eventId, std::make_pair(std::move(startEvent), std::move(endEvent))));
+            bufferEvents.insert(eventId, std::make_pair(std::move(startEvent), std::move(endEvent)));
         }
 
         persistentBuffers.insert(std::move(buffer)); // buffer data will be stolen
-        nextEventId++;
 
         return getArgumentOperationDuration(eventId);
     }
@@ -461,32 +613,41 @@ uint64_t CUDAEngine::persistArgument(KernelArgument& kernelArgument, const bool
 
 uint64_t CUDAEngine::getArgumentOperationDuration(const EventId id) const
 {
-    auto eventPointer = bufferEvents.find(id);
+    std::pair<std::unique_ptr<CUDAEvent>, std::unique_ptr<CUDAEvent>> events;
 
-    if (eventPointer == bufferEvents.end())
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        events = bufferEvents.take(id);
+    }
+
+    if (events.first == nullptr)
     {
         throw std::runtime_error(std::string("Buffer event with following id does not exist or its result was already retrieved: ")
             + std::to_string(id));
     }
 
-    if (!eventPointer->second.first->isValid())
+    if (!events.first->isValid())
     {
-        bufferEvents.erase(id);
+        recycleEvents(std::move(events));
         return 0;
     }
 
     Logger::getLogger().log(LoggingLevel::Debug, "Performing buffer operation synchronization for event id: " + std::to_string(id));
 
-    // Wait until the second event in pair (the end event) finishes
-    checkCUDAError(cuEventSynchronize(eventPointer->second.second->getEvent()), "cuEventSynchronize");
-    float duration = getEventCommandDuration(eventPointer->second.first->getEvent(), eventPointer->second.second->getEvent());
-    bufferEvents.erase(id);
+    // Wait until the second event in pair (the end event) finishes, other threads may keep using the engine in the meantime
+    bindContext();
+    checkCUDAError(cuEventSynchronize(events.second->getEvent()), "cuEventSynchronize");
+    float duration = getEventCommandDuration(events.first->getEvent(), events.second->getEvent());
+    recycleEvents(std::move(events));
 
     return static_cast<uint64_t>(duration);
 }
 
 void CUDAEngine::resizeArgument(const ArgumentId id, const size_t newSize, const bool preserveData)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    bindContext();
+    restoreSpilledBuffer(id);
     CUDABuffer* buffer = findBuffer(id);
 
     if (buffer == nullptr)
@@ -495,54 +656,98 @@ void CUDAEngine::resizeArgument(const ArgumentId id, const size_t newSize, const
     }
 
     Logger::getLogger().log(LoggingLevel::Debug, "Resizing buffer for argument " + std::to_string(id));
-    buffer->resize(newSize, preserveData);
-}
-
-void CUDAEngine::clearBuffer(const ArgumentId id)
-{
-    auto iterator = buffers.cbegin();
 
-    while (iterator != buffers.cend())
+    if (buffer->getMemoryLocation() != ArgumentMemoryLocation::HostZeroCopy)
     {
-        if (iterator->get()->getKernelArgumentId() == id)
-        {
-            buffers.erase(iterator);
-            return;
-        }
-        else
+        residencyManager.touchBuffer(id);
+        if (newSize > buffer->getBufferSize())
         {
-            ++iterator;
+            reserveBufferMemory(newSize - buffer->getBufferSize());
         }
+        residencyManager.resizeBuffer(id, newSize);
     }
+
+    buffer->resize(newSize, preserveData);
+}
+
+void CUDAEngine::clearBuffer(const ArgumentId id)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    bindContext();
+    residencyManager.releaseSpilledArgument(id);
+    eraseBuffer(id);
 }
 
 void CUDAEngine::setPersistentBufferUsage(const bool flag)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     persistentBufferFlag = flag;
 }
 
 void CUDAEngine::clearBuffers()
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    bindContext();
+    buffers.forEach([this](const CUDABuffer& buffer)
+    {
+        residencyManager.removeBuffer(buffer.getKernelArgumentId());
+    });
+
     buffers.clear();
+    residencyManager.releaseSpilledArguments();
 }
 
 void CUDAEngine::clearBuffers(const ArgumentAccessType accessType)
 {
-    auto iterator = buffers.cbegin();
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    bindContext();
+    residencyManager.releaseSpilledArguments(accessType);
+    std::vector<ArgumentId> clearedBuffers;
 
-    while (iterator != buffers.cend())
+    buffers.forEach([&clearedBuffers, accessType](const CUDABuffer& buffer)
     {
-        if (iterator->get()->getAccessType() == accessType)
-        {
-            iterator = buffers.erase(iterator);
-        }
-        else
+        if (buffer.getAccessType() == accessType)
         {
-            ++iterator;
+            clearedBuffers.push_back(buffer.getKernelArgumentId());
         }
+    });
+
+    for (const auto id : clearedBuffers)
+    {
+        residencyManager.removeBuffer(id);
+        buffers.erase(id);
     }
 }
 
+void CUDAEngine::setDeviceMemoryBudget(const size_t budget)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    bindContext();
+    residencyManager.setBudget(budget);
+}
+
+DeviceMemoryStatistics CUDAEngine::getDeviceMemoryStatistics() const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    return residencyManager.getStatistics();
+}
+
+ArgumentMemoryLocation CUDAEngine::getAutomaticMemoryLocation(const ArgumentAccessType accessType) const
+{
+    if (!getCurrentDeviceInfo().hasHostUnifiedMemory())
+    {
+        return ArgumentMemoryLocation::Device;
+    }
+
+    // Device reads host memory directly, so read-only data does not need to be copied at all
+    if (accessType == ArgumentAccessType::ReadOnly)
+    {
+        return ArgumentMemoryLocation::HostZeroCopy;
+    }
+
+    return ArgumentMemoryLocation::Host;
+}
+
 void CUDAEngine::printComputeAPIInfo(std::ostream& outputTarget) const
 {
     outputTarget << "Platform 0: " << "NVIDIA CUDA" << std::endl;
@@ -586,6 +791,25 @@ DeviceInfo CUDAEngine::getCurrentDeviceInfo() const
 }
 
 
+std::shared_ptr<CUDAKernel> CUDAEngine::loadKernel(const KernelRuntimeData& kernelData)
+{
+    if (!kernelCacheFlag)
+    {
+        std::unique_ptr<CUDAProgram> program = createAndBuildProgram(kernelData.getSource());
+        return std::make_shared<CUDAKernel>(program->getPtxSource(), kernelData.getName());
+    }
+
+    const auto cacheKey = KernelFingerprint::compute(kernelData.getName(), kernelData.getSource(), compilerOptions, deviceIndex);
+
+    return kernelCache.getOrBuild(cacheKey, [this, &kernelData](size_t& entrySize)
+    {
+        std::unique_ptr<CUDAProgram> program = createAndBuildProgram(kernelData.getSource());
+        std::string ptxSource = program->getPtxSource();
+        entrySize = ptxSource.size();
+        return std::make_shared<CUDAKernel>(ptxSource, kernelData.getName());
+    });
+}
+
 std::unique_ptr<CUDAProgram> CUDAEngine::createAndBuildProgram(const std::string& source) const
 {
     auto program = MakeStdUnique<CUDAProgram>(source);
@@ -619,10 +843,9 @@ EventId CUDAEngine::enqueueKernel(CUDAKernel& kernel, const std::vector<size_t>&
         correctedGlobalSize.at(2) /= localSize.at(2);
     }
 
-    EventId eventId = nextEventId;
-    auto startEvent = MakeStdUnique<CUDAEvent>(eventId, kernel.getKernelName(), kernelLaunchOverhead);
-    auto endEvent = MakeStdUnique<CUDAEvent>(eventId, kernel.getKernelName(), kernelLaunchOverhead);
-    nextEventId++;
+    const EventId eventId = nextEventId++;
+    auto startEvent = createKernelEvent(eventId, kernel.getKernelName(), kernelLaunchOverhead);
+    auto endEvent = createKernelEvent(eventId, kernel.getKernelName(), kernelLaunchOverhead);
 
     Logger::getLogger().log(LoggingLevel::Debug, "Launching kernel " + kernel.getKernelName() + ", event id: " + std::to_string(eventId));
     checkCUDAError(cuEventRecord(startEvent->getEvent(), streams.at(queue)->getStream()), "cuEventRecord");
@@ -633,15 +856,20 @@ EventId CUDAEngine::enqueueKernel(CUDAKernel& kernel, const std::vector<size_t>&
         "cuLaunchKernel");
     checkCUDAError(cuEventRecord(endEvent->getEvent(), streams.at(queue)->getStream()), "cuEventRecord");
 
-    kernelEvents.insert(std::make_pair(eventId, std::make_pair(std::move(startEvent), std::move(endEvent))));
+    kernelEvents.insert(eventId, std::make_pair(std::move(startEvent), std::move(endEvent)));
     return eventId;
 }
 
 KernelResult CUDAEngine::createKernelResult(const EventId id) const
 {
-    auto eventPointer = kernelEvents.find(id);
+    std::pair<std::unique_ptr<CUDAEvent>, std::unique_ptr<CUDAEvent>> events;
+
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        events = kernelEvents.take(id);
+    }
 
-    if (eventPointer == kernelEvents.end())
+    if (events.first == nullptr)
     {
         throw std::runtime_error(std::string("Kernel event with following id does not exist or its result was already retrieved: ")
             + std::to_string(id));
@@ -649,12 +877,13 @@ KernelResult CUDAEngine::createKernelResult(const EventId id) const
 
     Logger::getLogger().log(LoggingLevel::Debug, std::string("Performing kernel synchronization for event id: ") + std::to_string(id));
 
-    // Wait until the second event in pair (the end event) finishes
-    checkCUDAError(cuEventSynchronize(eventPointer->second.second->getEvent()), "cuEventSynchronize");
-    std::string name = eventPointer->second.first->getKernelName();
-    float duration = getEventCommandDuration(eventPointer->second.first->getEvent(), eventPointer->second.second->getEvent());
-    uint64_t overhead = eventPointer->second.first->getOverhead();
-    kernelEvents.erase(id);
+    // Wait until the second event in pair (the end event) finishes, the engine lock is not held here
+    bindContext();
+    checkCUDAError(cuEventSynchronize(events.second->getEvent()), "cuEventSynchronize");
+    std::string name = events.first->getKernelName();
+    float duration = getEventCommandDuration(events.first->getEvent(), events.second->getEvent());
+    uint64_t overhead = events.first->getOverhead();
+    recycleEvents(std::move(events));
 
     KernelResult result(name, static_cast<uint64_t>(duration));
     result.setOverhead(overhead);
@@ -692,6 +921,10 @@ DeviceInfo CUDAEngine::getCUDADeviceInfo(const DeviceIndex deviceIndex) const
     result.setMaxWorkGroupSize(workGroupSize);
     result.setDeviceType(DeviceType::GPU);
 
+    int integrated;
+    checkCUDAError(cuDeviceGetAttribute(&integrated, CU_DEVICE_ATTRIBUTE_INTEGRATED, id), "cuDeviceGetAttribute");
+    result.setHostUnifiedMemory(integrated != 0);
+
     return result;
 }
 
@@ -801,24 +1034,114 @@ CUDABuffer* CUDAEngine::findBuffer(const ArgumentId id) const
 {
     if (persistentBufferFlag)
     {
-        for (const auto& buffer : persistentBuffers)
+        CUDABuffer* buffer = persistentBuffers.find(id);
+
+        if (buffer != nullptr)
         {
-            if (buffer->getKernelArgumentId() == id)
-            {
-                return buffer.get();
-            }
+            return buffer;
         }
     }
 
-    for (const auto& buffer : buffers)
+    return buffers.find(id);
+}
+
+void CUDAEngine::eraseBuffer(const ArgumentId id)
+{
+    if (buffers.erase(id))
+    {
+        residencyManager.removeBuffer(id);
+    }
+}
+
+void CUDAEngine::reserveBufferMemory(const size_t size)
+{
+    const std::vector<ArgumentId> evictedBuffers = residencyManager.getEvictionCandidates(size);
+
+    if (evictedBuffers.empty())
     {
-        if (buffer->getKernelArgumentId() == id)
+        return;
+    }
+
+    // Contents of spilled buffers are downloaded only after all commands which may modify them are finished
+    synchronizeDevice();
+
+    for (const auto id : evictedBuffers)
+    {
+        Logger::getLogger().log(LoggingLevel::Debug, "Evicting buffer for argument " + std::to_string(id));
+
+        if (residencyManager.isSpillRequired(id))
         {
-            return buffer.get();
+            residencyManager.storeSpilledArgument(downloadArgumentObject(id, nullptr));
         }
+
+        residencyManager.evictBuffer(id);
+        eraseBuffer(id);
     }
+}
 
-    return nullptr;
+EventId CUDAEngine::uploadSpilledArgument(KernelArgument& spilledArgument, const QueueId queue)
+{
+    EventId eventId = uploadArgumentAsync(spilledArgument, queue);
+
+    // Host data of write-only arguments is not uploaded, spilled contents have to be restored explicitly
+    if (spilledArgument.getAccessType() == ArgumentAccessType::WriteOnly)
+    {
+        getArgumentOperationDuration(eventId);
+        eventId = updateArgumentAsync(spilledArgument.getId(), spilledArgument.getData(), spilledArgument.getDataSizeInBytes(), queue);
+    }
+
+    // Spilled data is released by caller, so the upload has to be finished
+    synchronizeQueue(queue);
+    return eventId;
+}
+
+void CUDAEngine::restoreSpilledBuffer(const ArgumentId id)
+{
+    std::unique_ptr<KernelArgument> spilledArgument = residencyManager.takeSpilledArgument(id);
+
+    if (spilledArgument != nullptr)
+    {
+        getArgumentOperationDuration(uploadSpilledArgument(*spilledArgument, getDefaultQueue()));
+    }
+}
+
+std::unique_ptr<CUDAEvent> CUDAEngine::createEvent(const EventId id, const bool validFlag) const
+{
+    std::unique_ptr<CUDAEvent> event = eventPool.acquire();
+
+    if (event == nullptr)
+    {
+        return MakeStdUnique<CUDAEvent>(id, validFlag);
+    }
+
+    event->reset(id, validFlag);
+    return event;
+}
+
+std::unique_ptr<CUDAEvent> CUDAEngine::createKernelEvent(const EventId id, const std::string& kernelName, const uint64_t kernelLaunchOverhead)
+    const
+{
+    std::unique_ptr<CUDAEvent> event = eventPool.acquire();
+
+    if (event == nullptr)
+    {
+        return MakeStdUnique<CUDAEvent>(id, kernelName, kernelLaunchOverhead);
+    }
+
+    event->reset(id, kernelName, kernelLaunchOverhead);
+    return event;
+}
+
+void CUDAEngine::recycleEvents(std::pair<std::unique_ptr<CUDAEvent>, std::unique_ptr<CUDAEvent>> events) const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    eventPool.release(std::move(events.first));
+    eventPool.release(std::move(events.second));
+}
+
+void CUDAEngine::bindContext() const
+{
+    checkCUDAError(cuCtxSetCurrent(context->getContext()), "cuCtxSetCurrent");
 }
 
 CUdeviceptr* CUDAEngine::loadBufferFromCache(const ArgumentId id) const
@@ -2,10 +2,11 @@
 
 #ifdef FLY_PLATFORM_CUDA
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <ostream>
-#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -16,10 +17,17 @@
 #include <fly/compute_engine/cuda/cuda_device.h>
 #include <fly/compute_engine/cuda/cuda_event.h>
 #include <fly/compute_engine/cuda/cuda_kernel.h>
+#include <fly/compute_engine/cuda/cuda_prepared_kernel.h>
 #include <fly/compute_engine/cuda/cuda_program.h>
 #include <fly/compute_engine/cuda/cuda_stream.h>
 #include <fly/compute_engine/cuda/cuda_utility.h>
+#include <fly/compute_engine/buffer_residency_manager.h>
+#include <fly/compute_engine/buffer_slot_map.h>
 #include <fly/compute_engine/compute_engine.h>
+#include <fly/compute_engine/concurrent_kernel_cache.h>
+#include <fly/compute_engine/event_pool.h>
+#include <fly/compute_engine/event_slot_map.h>
+#include <fly/compute_engine/kernel_fingerprint.h>
 
 
 namespace fly
@@ -37,6 +45,12 @@ public:
     EventId runKernelAsync(const KernelRuntimeData& kernelData, const std::vector<KernelArgument*>& argumentPointers, const QueueId queue) override;
     KernelResult getKernelResult(const EventId id, const std::vector<OutputDescriptor>& outputDescriptors) const override;
     uint64_t getKernelOverhead(const EventId id) const override;
+    void compileKernel(const KernelRuntimeData& kernelData) override;
+
+    // Prepared launch methods
+    void prepareKernel(const LaunchId id, const KernelRuntimeData& kernelData) override;
+    EventId runPreparedKernelAsync(const LaunchId id, const std::vector<KernelArgument*>& argumentPointers, const QueueId queue) override;
+    void releasePreparedKernel(const LaunchId id) override;
 
     // Utility methods
     void setCompilerOptions(const std::string& options) override;
@@ -44,6 +58,10 @@ public:
     void setAutomaticGlobalSizeCorrection(const bool flag) override;
     void setKernelCacheUsage(const bool flag) override;
     void setKernelCacheCapacity(const size_t capacity) override;
+    void setKernelCacheByteBudget(const size_t budget) override;
+    void setKernelCacheEvictionPolicy(const KernelCacheEvictionPolicy policy) override;
+    KernelCacheStatistics getKernelCacheStatistics() const override;
+    void setPersistentKernelCache(const std::string& directory, const size_t maxSizeInBytes) override;
     void clearKernelCache() override;
 
     // Queue handling methods
@@ -52,6 +70,7 @@ public:
     void synchronizeQueue(const QueueId queue) override;
     void synchronizeDevice() override;
     void clearEvents() override;
+    void enqueueEventWait(const QueueId queue, const EventId id) override;
 
     // Argument handling methods
     uint64_t uploadArgument(KernelArgument& kernelArgument) override;
@@ -70,6 +89,9 @@ public:
     void clearBuffer(const ArgumentId id) override;
     void clearBuffers() override;
     void clearBuffers(const ArgumentAccessType accessType) override;
+    ArgumentMemoryLocation getAutomaticMemoryLocation(const ArgumentAccessType accessType) const override;
+    void setDeviceMemoryBudget(const size_t budget) override;
+    DeviceMemoryStatistics getDeviceMemoryStatistics() const override;
 
     // Information retrieval methods
     void printComputeAPIInfo(std::ostream& outputTarget) const override;
@@ -85,22 +107,28 @@ private:
     GlobalSizeType globalSizeType;
     bool globalSizeCorrection;
     bool kernelCacheFlag;
-    size_t kernelCacheCapacity;
     bool persistentBufferFlag;
-    mutable EventId nextEventId;
+    mutable std::atomic<EventId> nextEventId;
+    // Guards buffers, event tables and prepared kernels. CUDA context is bound to every thread which enters the engine, driver calls of
+    // different threads then share the same context and streams. Events are synchronized with the lock released.
+    mutable std::recursive_mutex mutex;
     std::unique_ptr<CUDAContext> context;
     std::vector<std::unique_ptr<CUDAStream>> streams;
-    std::set<std::unique_ptr<CUDABuffer>> buffers;
-    std::set<std::unique_ptr<CUDABuffer>> persistentBuffers;
-    std::map<std::pair<std::string, std::string>, std::unique_ptr<CUDAKernel>> kernelCache;
-    mutable std::map<EventId, std::pair<std::unique_ptr<CUDAEvent>, std::unique_ptr<CUDAEvent>>> kernelEvents;
-    mutable std::map<EventId, std::pair<std::unique_ptr<CUDAEvent>, std::unique_ptr<CUDAEvent>>> bufferEvents;
+    BufferSlotMap<CUDABuffer> buffers;
+    BufferSlotMap<CUDABuffer> persistentBuffers;
+    BufferResidencyManager residencyManager;
+    ConcurrentKernelCache<CUDAKernel> kernelCache;
+    mutable EventSlotMap<std::pair<std::unique_ptr<CUDAEvent>, std::unique_ptr<CUDAEvent>>> kernelEvents;
+    std::map<LaunchId, std::unique_ptr<CUDAPreparedKernel>> preparedKernels;
+    mutable EventSlotMap<std::pair<std::unique_ptr<CUDAEvent>, std::unique_ptr<CUDAEvent>>> bufferEvents;
+    mutable EventPool<std::unique_ptr<CUDAEvent>> eventPool;
 #ifdef FLY_PROFILING
     std::vector<std::pair<std::string, CUpti_MetricID>> profilingMetrics;
     std::map<std::pair<std::string, std::string>, std::vector<EventId>> kernelToEventMap;
     std::map<std::pair<std::string, std::string>, CUDAProfilingState> kernelProfilingStates;
 #endif // FLY_PROFILING
 
+    std::shared_ptr<CUDAKernel> loadKernel(const KernelRuntimeData& kernelData);
     std::unique_ptr<CUDAProgram> createAndBuildProgram(const std::string& source) const;
     EventId enqueueKernel(CUDAKernel& kernel, const std::vector<size_t>& globalSize, const std::vector<size_t>& localSize,
         const std::vector<CUdeviceptr*>& kernelArguments, const size_t localMemorySize, const QueueId queue, const uint64_t kernelLaunchOverhead);
@@ -110,6 +138,14 @@ private:
     std::vector<CUdeviceptr*> getKernelArguments(const std::vector<KernelArgument*>& argumentPointers);
     size_t getSharedMemorySizeInBytes(const std::vector<KernelArgument*>& argumentPointers, const std::vector<LocalMemoryModifier>& modifiers) const;
     CUDABuffer* findBuffer(const ArgumentId id) const;
+    void eraseBuffer(const ArgumentId id);
+    void reserveBufferMemory(const size_t size);
+    EventId uploadSpilledArgument(KernelArgument& spilledArgument, const QueueId queue);
+    void restoreSpilledBuffer(const ArgumentId id);
+    std::unique_ptr<CUDAEvent> createEvent(const EventId id, const bool validFlag) const;
+    std::unique_ptr<CUDAEvent> createKernelEvent(const EventId id, const std::string& kernelName, const uint64_t kernelLaunchOverhead) const;
+    void recycleEvents(std::pair<std::unique_ptr<CUDAEvent>, std::unique_ptr<CUDAEvent>> events) const;
+    void bindContext() const;
     CUdeviceptr* loadBufferFromCache(const ArgumentId id) const;
 
 #ifdef FLY_PROFILING
@@ -35,6 +35,23 @@ public:
         checkCUDAError(cuEventDestroy(event), "cuEventDestroy");
     }
 
+    // Pooled events are reused for another operation once their result was retrieved, CUDA event is recorded again
+    void reset(const EventId id, const bool validFlag)
+    {
+        this->id = id;
+        kernelName = "";
+        this->validFlag = validFlag;
+        overhead = 0;
+    }
+
+    void reset(const EventId id, const std::string& kernelName, const uint64_t kernelLaunchOverhead)
+    {
+        this->id = id;
+        this->kernelName = kernelName;
+        validFlag = true;
+        overhead = kernelLaunchOverhead;
+    }
+
     EventId getId() const
     {
         return id;
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <fly/compute_engine/cuda/cuda_kernel.h>
+#include <fly/dto/local_memory_modifier.h>
+
+namespace fly
+{
+
+// Prepared launch pins kernel from kernel cache together with its launch geometry
+struct CUDAPreparedKernel
+{
+public:
+    CUDAPreparedKernel(std::shared_ptr<CUDAKernel> kernel, const std::vector<size_t>& globalSize, const std::vector<size_t>& localSize,
+        const std::vector<LocalMemoryModifier>& localMemoryModifiers) :
+        kernel(kernel),
+        globalSize(globalSize),
+        localSize(localSize),
+        localMemoryModifiers(localMemoryModifiers)
+    {}
+
+    std::shared_ptr<CUDAKernel> kernel;
+    std::vector<size_t> globalSize;
+    std::vector<size_t> localSize;
+    std::vector<LocalMemoryModifier> localMemoryModifiers;
+};
+
+} // namespace fly
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace fly
+{
+
+// Event objects whose results were retrieved are kept for reuse, so that native events and synchronization primitives are not created for
+// every operation. Size of the pool is bounded, surplus events are destroyed.
+template <typename EventPointer>
+class EventPool
+{
+public:
+    // Constructor
+    explicit EventPool(const size_t capacity = 256) :
+        capacity(capacity)
+    {}
+
+    // Core methods
+    // Returns empty pointer if there is no event available, caller then creates new event
+    EventPointer acquire()
+    {
+        if (events.empty())
+        {
+            return EventPointer();
+        }
+
+        EventPointer result = std::move(events.back());
+        events.pop_back();
+        return result;
+    }
+
+    void release(EventPointer event)
+    {
+        if (event != nullptr && events.size() < capacity)
+        {
+            events.push_back(std::move(event));
+        }
+    }
+
+    void clear()
+    {
+        events.clear();
+    }
+
+private:
+    // Attributes
+    size_t capacity;
+    std::vector<EventPointer> events;
+};
+
+} // namespace fly
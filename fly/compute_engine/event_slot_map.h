@@ -0,0 +1,225 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "fly/fly_types.h"
+
+namespace fly
+{
+
+// Events stored in open addressing slot array indexed by low bits of their ids. Event ids are assigned sequentially, so outstanding events
+// occupy neighbouring slots and lookup rarely probes more than a single slot. Full id is kept in every slot and acts as its generation, ids
+// of events which were already retrieved are rejected. Array grows only once it becomes half full, steady-state insertion does not allocate.
+template <typename EventType>
+class EventSlotMap
+{
+public:
+    // Constructor
+    explicit EventSlotMap(const size_t initialCapacity = 64) :
+        slots(getPowerOfTwo(initialCapacity)),
+        eventCount(0)
+    {}
+
+    // Core methods
+    void insert(const EventId id, EventType event)
+    {
+        if (2 * (eventCount + 1) > slots.size())
+        {
+            grow();
+        }
+
+        size_t index = getSlotIndex(id);
+
+        while (slots[index].occupied && slots[index].id != id)
+        {
+            index = getNextIndex(index);
+        }
+
+        if (!slots[index].occupied)
+        {
+            slots[index].id = id;
+            slots[index].occupied = true;
+            eventCount++;
+        }
+
+        slots[index].event = std::move(event);
+    }
+
+    EventType* find(const EventId id)
+    {
+        const size_t index = findSlot(id);
+        return index == slots.size() ? nullptr : &slots[index].event;
+    }
+
+    const EventType* find(const EventId id) const
+    {
+        const size_t index = findSlot(id);
+        return index == slots.size() ? nullptr : &slots[index].event;
+    }
+
+    // Removed event is handed over to caller, so that its resources can be recycled
+    EventType take(const EventId id)
+    {
+        const size_t index = findSlot(id);
+
+        if (index == slots.size())
+        {
+            return EventType();
+        }
+
+        EventType result = std::move(slots[index].event);
+        removeSlot(index);
+        return result;
+    }
+
+    bool erase(const EventId id)
+    {
+        const size_t index = findSlot(id);
+
+        if (index == slots.size())
+        {
+            return false;
+        }
+
+        removeSlot(index);
+        return true;
+    }
+
+    void clear()
+    {
+        for (auto& slot : slots)
+        {
+            slot.occupied = false;
+            slot.event = EventType();
+        }
+
+        eventCount = 0;
+    }
+
+    template <typename Function>
+    void forEach(Function function) const
+    {
+        for (const auto& slot : slots)
+        {
+            if (slot.occupied)
+            {
+                function(slot.id, slot.event);
+            }
+        }
+    }
+
+    // Getters
+    size_t size() const
+    {
+        return eventCount;
+    }
+
+    bool empty() const
+    {
+        return eventCount == 0;
+    }
+
+private:
+    struct Slot
+    {
+        Slot() :
+            id(0),
+            occupied(false),
+            event()
+        {}
+
+        EventId id;
+        bool occupied;
+        EventType event;
+    };
+
+    // Attributes
+    std::vector<Slot> slots;
+    size_t eventCount;
+
+    // Helper methods
+    size_t getSlotIndex(const EventId id) const
+    {
+        return static_cast<size_t>(id) & (slots.size() - 1);
+    }
+
+    size_t getNextIndex(const size_t index) const
+    {
+        return (index + 1) & (slots.size() - 1);
+    }
+
+    size_t findSlot(const EventId id) const
+    {
+        size_t index = getSlotIndex(id);
+
+        while (slots[index].occupied)
+        {
+            if (slots[index].id == id)
+            {
+                return index;
+            }
+
+            index = getNextIndex(index);
+        }
+
+        return slots.size();
+    }
+
+    // Following entries of the probe sequence are shifted back into the freed slot, so that lookups do not need tombstones
+    void removeSlot(size_t index)
+    {
+        slots[index].occupied = false;
+        slots[index].event = EventType();
+        eventCount--;
+
+        const size_t mask = slots.size() - 1;
+        size_t next = getNextIndex(index);
+
+        while (slots[next].occupied)
+        {
+            const size_t home = getSlotIndex(slots[next].id);
+
+            if (((next - home) & mask) >= ((next - index) & mask))
+            {
+                slots[index].id = slots[next].id;
+                slots[index].occupied = true;
+                slots[index].event = std::move(slots[next].event);
+                slots[next].occupied = false;
+                slots[next].event = EventType();
+                index = next;
+            }
+
+            next = getNextIndex(next);
+        }
+    }
+
+    void grow()
+    {
+        std::vector<Slot> previousSlots(slots.size() * 2);
+        std::swap(previousSlots, slots);
+        eventCount = 0;
+
+        for (auto& slot : previousSlots)
+        {
+            if (slot.occupied)
+            {
+                insert(slot.id, std::move(slot.event));
+            }
+        }
+    }
+
+    static size_t getPowerOfTwo(const size_t value)
+    {
+        size_t result = 1;
+
+        while (result < value)
+        {
+            result <<= 1;
+        }
+
+        return result;
+    }
+};
+
+} // namespace fly
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <fly/enum/argument_access_type.h>
+#include <fly/enum/argument_data_type.h>
+#include <fly/enum/argument_memory_location.h>
+#include <fly/kernel_argument/kernel_argument.h>
+
+namespace fly
+{
+
+class HostBuffer
+{
+public:
+    explicit HostBuffer(KernelArgument& kernelArgument, const bool zeroCopy) :
+        kernelArgumentId(kernelArgument.getId()),
+        bufferSize(kernelArgument.getDataSizeInBytes()),
+        elementSize(kernelArgument.getElementSizeInBytes()),
+        dataType(kernelArgument.getDataType()),
+        memoryLocation(kernelArgument.getMemoryLocation()),
+        accessType(kernelArgument.getAccessType()),
+        hostPointer(nullptr),
+        zeroCopy(zeroCopy)
+    {
+        if (zeroCopy)
+        {
+            hostPointer = kernelArgument.getData();
+        }
+        else
+        {
+            storage.resize(bufferSize);
+        }
+    }
+
+    void resize(const size_t newBufferSize, const bool preserveData)
+    {
+        if (zeroCopy)
+        {
+            throw std::runtime_error("Cannot resize buffer which references host memory");
+        }
+
+        if (bufferSize == newBufferSize)
+        {
+            return;
+        }
+
+        if (!preserveData)
+        {
+            std::vector<uint8_t> newStorage(newBufferSize);
+            storage.swap(newStorage);
+        }
+        else
+        {
+            storage.resize(newBufferSize);
+        }
+
+        bufferSize = newBufferSize;
+    }
+
+    void uploadData(const void* source, const size_t dataSize)
+    {
+        if (bufferSize < dataSize)
+        {
+            resize(dataSize, false);
+        }
+
+        copyData(getData(), source, dataSize);
+    }
+
+    void downloadData(void* destination, const size_t dataSize) const
+    {
+        if (bufferSize < dataSize)
+        {
+            throw std::runtime_error("Size of data to download is larger than size of buffer");
+        }
+
+        copyData(destination, getData(), dataSize);
+    }
+
+    ArgumentId getKernelArgumentId() const
+    {
+        return kernelArgumentId;
+    }
+
+    size_t getBufferSize() const
+    {
+        return bufferSize;
+    }
+
+    size_t getElementSize() const
+    {
+        return elementSize;
+    }
+
+    ArgumentDataType getDataType() const
+    {
+        return dataType;
+    }
+
+    ArgumentMemoryLocation getMemoryLocation() const
+    {
+        return memoryLocation;
+    }
+
+    ArgumentAccessType getAccessType() const
+    {
+        return accessType;
+    }
+
+    bool isZeroCopy() const
+    {
+        return zeroCopy;
+    }
+
+    void* getData()
+    {
+        if (zeroCopy)
+        {
+            return hostPointer;
+        }
+        return storage.data();
+    }
+
+    const void* getData() const
+    {
+        if (zeroCopy)
+        {
+            return hostPointer;
+        }
+        return storage.data();
+    }
+
+private:
+    ArgumentId kernelArgumentId;
+    size_t bufferSize;
+    size_t elementSize;
+    ArgumentDataType dataType;
+    ArgumentMemoryLocation memoryLocation;
+    ArgumentAccessType accessType;
+    std::vector<uint8_t> storage;
+    void* hostPointer;
+    bool zeroCopy;
+
+    static void copyData(void* destination, const void* source, const size_t dataSize)
+    {
+        // Zero-copy buffers may be downloaded into the same memory they reference
+        if (destination != source)
+        {
+            std::memcpy(destination, source, dataSize);
+        }
+    }
+};
+
+} // namespace fly
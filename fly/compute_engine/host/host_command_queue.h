@@ -0,0 +1,93 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "fly/fly_types.h"
+
+namespace fly
+{
+
+// Commands submitted to the same queue are executed in order on a dedicated dispatcher thread
+class HostCommandQueue
+{
+public:
+    explicit HostCommandQueue(const QueueId id) :
+        id(id),
+        busyFlag(false),
+        stopFlag(false)
+    {
+        dispatcher = std::thread(&HostCommandQueue::dispatchCommands, this);
+    }
+
+    ~HostCommandQueue()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopFlag = true;
+        }
+        commandCondition.notify_one();
+        dispatcher.join();
+    }
+
+    void enqueueCommand(const std::function<void()>& command)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            commands.push_back(command);
+        }
+        commandCondition.notify_one();
+    }
+
+    void synchronize()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        idleCondition.wait(lock, [this]() { return commands.empty() && !busyFlag; });
+    }
+
+    QueueId getId() const
+    {
+        return id;
+    }
+
+private:
+    QueueId id;
+    std::deque<std::function<void()>> commands;
+    std::thread dispatcher;
+    std::mutex mutex;
+    std::condition_variable commandCondition;
+    std::condition_variable idleCondition;
+    bool busyFlag;
+    bool stopFlag;
+
+    void dispatchCommands()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        while (true)
+        {
+            commandCondition.wait(lock, [this]() { return stopFlag || !commands.empty(); });
+
+            if (commands.empty())
+            {
+                return;
+            }
+
+            std::function<void()> command = std::move(commands.front());
+            commands.pop_front();
+            busyFlag = true;
+            lock.unlock();
+
+            // Commands report their own errors through events
+            command();
+
+            lock.lock();
+            busyFlag = false;
+            idleCondition.notify_all();
+        }
+    }
+};
+
+} // namespace fly
@@ -0,0 +1,1107 @@
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <fly/compute_engine/host/host_engine.h>
+#include <fly/utility/fly_utility.h>
+#include <fly/utility/logger.h>
+#include <fly/utility/timer.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace fly
+{
+
+HostEngine::HostEngine(const DeviceIndex deviceIndex, const uint32_t queueCount) :
+    deviceIndex(deviceIndex),
+    queueCount(queueCount),
+    compilerOptions(std::string("")),
+    globalSizeType(GlobalSizeType::OpenCL),
+    globalSizeCorrection(false),
+    kernelCacheFlag(true),
+    kernelCacheCapacity(10),
+    kernelCacheByteBudget(0),
+    kernelCacheEvictionPolicy(KernelCacheEvictionPolicy::LeastRecentlyUsed),
+    persistentBufferFlag(true),
+    nextEventId(0)
+{
+    if (deviceIndex != 0)
+    {
+        throw std::runtime_error(std::string("Invalid device index: ") + std::to_string(deviceIndex));
+    }
+
+    uint32_t threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0)
+    {
+        threadCount = 1;
+    }
+
+    Logger::getLogger().log(LoggingLevel::Debug, std::string("Initializing Host thread pool with ") + std::to_string(threadCount) + " threads");
+    threadPool = MakeStdUnique<HostThreadPool>(threadCount);
+
+    Logger::getLogger().log(LoggingLevel::Debug, "Initializing Host queues");
+    for (uint32_t i = 0; i < queueCount; i++)
+    {
+        auto commandQueue = MakeStdUnique<HostCommandQueue>(i);
+        commandQueues.push_back(std::move(commandQueue));
+    }
+}
+
+HostEngine::~HostEngine()
+{
+    // Pending commands may still reference buffers which are destroyed before queues
+    synchronizeDevice();
+}
+
+KernelResult HostEngine::runKernel(const KernelRuntimeData& kernelData, const std::vector<KernelArgument*>& argumentPointers,
+    const std::vector<OutputDescriptor>& outputDescriptors)
+{
+    EventId eventId = runKernelAsync(kernelData, argumentPointers, getDefaultQueue());
+    KernelResult result = getKernelResult(eventId, outputDescriptors);
+    return result;
+}
+
+EventId HostEngine::runKernelAsync(const KernelRuntimeData& kernelData, const std::vector<KernelArgument*>& argumentPointers, const QueueId queue)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    checkQueueIndex(queue);
+
+    Timer overheadTimer;
+    overheadTimer.start();
+    const HostPreparedKernel preparedKernel = createPreparedKernel(kernelData);
+    return launchKernel(preparedKernel, argumentPointers, queue, overheadTimer);
+}
+
+KernelResult HostEngine::getKernelResult(const EventId id, const std::vector<OutputDescriptor>& outputDescriptors) const
+{
+    std::shared_ptr<HostEvent> event;
+
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        event = kernelEvents.take(id);
+    }
+
+    if (event == nullptr)
+    {
+        throw std::runtime_error(std::string("Kernel event with following id does not exist or its result was already retrieved: ")
+            + std::to_string(id));
+    }
+
+    // Engine is not locked while waiting, other threads can submit work in the meantime
+    Logger::getLogger().log(LoggingLevel::Debug, std::string("Performing kernel synchronization for event id: ") + std::to_string(id));
+    event->wait();
+
+    for (const auto& descriptor : outputDescriptors)
+    {
+        downloadArgument(descriptor.getArgumentId(), descriptor.getOutputDestination(), descriptor.getOutputSizeInBytes());
+    }
+
+    KernelResult result(event->getKernelName(), event->getEventCommandDuration());
+    result.setOverhead(event->getOverhead());
+
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    recycleEvent(std::move(event));
+    return result;
+}
+
+void HostEngine::compileKernel(const KernelRuntimeData&)
+{
+    // Host kernels are compiled together with application, there is nothing to build
+}
+
+uint64_t HostEngine::getKernelOverhead(const EventId id) const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    const std::shared_ptr<HostEvent>* event = kernelEvents.find(id);
+
+    if (event == nullptr)
+    {
+        throw std::runtime_error(std::string("Kernel event with following id does not exist or its result was already retrieved: ")
+            + std::to_string(id));
+    }
+
+    return (*event)->getOverhead();
+}
+
+void HostEngine::prepareKernel(const LaunchId id, const KernelRuntimeData& kernelData)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    preparedKernels[id] = createPreparedKernel(kernelData);
+}
+
+EventId HostEngine::runPreparedKernelAsync(const LaunchId id, const std::vector<KernelArgument*>& argumentPointers, const QueueId queue)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    checkQueueIndex(queue);
+
+    Timer overheadTimer;
+    overheadTimer.start();
+
+    auto preparedPointer = preparedKernels.find(id);
+    if (preparedPointer == preparedKernels.end())
+    {
+        throw std::runtime_error(std::string("Prepared kernel launch with following id does not exist: ") + std::to_string(id));
+    }
+
+    return launchKernel(preparedPointer->second, argumentPointers, queue, overheadTimer);
+}
+
+void HostEngine::releasePreparedKernel(const LaunchId id)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    preparedKernels.erase(id);
+}
+
+void HostEngine::setCompilerOptions(const std::string& options)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    compilerOptions = options;
+}
+
+void HostEngine::setGlobalSizeType(const GlobalSizeType type)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    globalSizeType = type;
+}
+
+void HostEngine::setAutomaticGlobalSizeCorrection(const bool flag)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    globalSizeCorrection = flag;
+}
+
+void HostEngine::setKernelCacheUsage(const bool flag)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    kernelCacheFlag = flag;
+}
+
+void HostEngine::setKernelCacheCapacity(const size_t capacity)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    kernelCacheCapacity = capacity;
+}
+
+void HostEngine::setKernelCacheByteBudget(const size_t budget)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    kernelCacheByteBudget = budget;
+}
+
+void HostEngine::setKernelCacheEvictionPolicy(const KernelCacheEvictionPolicy policy)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    kernelCacheEvictionPolicy = policy;
+}
+
+KernelCacheStatistics HostEngine::getKernelCacheStatistics() const
+{
+    return KernelCacheStatistics();
+}
+
+void HostEngine::setPersistentKernelCache(const std::string& directory, const size_t)
+{
+    if (!directory.empty())
+    {
+        throw std::runtime_error("Persistent kernel cache is not supported for Host backend");
+    }
+}
+
+void HostEngine::clearKernelCache()
+{
+    // Host kernels are native functions, there is nothing compiled which could be cached
+}
+
+QueueId HostEngine::getDefaultQueue() const
+{
+    return 0;
+}
+
+std::vector<QueueId> HostEngine::getAllQueues() const
+{
+    std::vector<QueueId> result;
+
+    for (size_t i = 0; i < commandQueues.size(); i++)
+    {
+        result.push_back(static_cast<QueueId>(i));
+    }
+
+    return result;
+}
+
+void HostEngine::synchronizeQueue(const QueueId queue)
+{
+    checkQueueIndex(queue);
+    commandQueues.at(queue)->synchronize();
+}
+
+void HostEngine::synchronizeDevice()
+{
+    for (auto& commandQueue : commandQueues)
+    {
+        commandQueue->synchronize();
+    }
+}
+
+void HostEngine::clearEvents()
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    kernelEvents.clear();
+    bufferEvents.clear();
+}
+
+void HostEngine::enqueueEventWait(const QueueId queue, const EventId id)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    checkQueueIndex(queue);
+
+    const std::shared_ptr<HostEvent>* eventPointer = kernelEvents.find(id);
+
+    if (eventPointer == nullptr)
+    {
+        throw std::runtime_error(std::string("Kernel event with following id does not exist or its result was already retrieved: ")
+            + std::to_string(id));
+    }
+
+    std::shared_ptr<HostEvent> event = *eventPointer;
+
+    commandQueues.at(queue)->enqueueCommand([event]()
+    {
+        // Failure of the awaited kernel is reported by its own result, dependent commands still run
+        try
+        {
+            event->wait();
+        }
+        catch (...)
+        {}
+    });
+}
+
+uint64_t HostEngine::uploadArgument(KernelArgument& kernelArgument)
+{
+    if (kernelArgument.getUploadType() != ArgumentUploadType::Vector)
+    {
+        return 0;
+    }
+
+    EventId eventId = uploadArgumentAsync(kernelArgument, getDefaultQueue());
+    return getArgumentOperationDuration(eventId);
+}
+
+EventId HostEngine::uploadArgumentAsync(KernelArgument& kernelArgument, const QueueId queue)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    checkQueueIndex(queue);
+
+    if (findBuffer(kernelArgument.getId()) != nullptr)
+    {
+        throw std::runtime_error(std::string("Buffer with following id already exists: ") + std::to_string(kernelArgument.getId()));
+    }
+
+    if (kernelArgument.getUploadType() != ArgumentUploadType::Vector)
+    {
+        return UINT64_MAX;
+    }
+
+    std::unique_ptr<KernelArgument> spilledArgument = residencyManager.takeSpilledArgument(kernelArgument.getId());
+    if (spilledArgument != nullptr)
+    {
+        return uploadSpilledArgument(*spilledArgument, queue);
+    }
+
+    std::unique_ptr<HostBuffer> buffer = createBuffer(kernelArgument);
+    EventId eventId;
+
+    // Zero-copy buffers do not allocate any memory
+    if (!buffer->isZeroCopy())
+    {
+        reserveBufferMemory(kernelArgument.getDataSizeInBytes());
+        residencyManager.addBuffer(kernelArgument.getId(), kernelArgument.getDataSizeInBytes(), kernelArgument.getAccessType());
+    }
+
+    Logger::getLogger().log(LoggingLevel::Debug, "Uploading buffer for argument " + std::to_string(kernelArgument.getId()) + ", event id: "
+        + std::to_string(nextEventId));
+
+    if (buffer->isZeroCopy() || kernelArgument.getAccessType() == ArgumentAccessType::WriteOnly)
+    {
+        // Contents of output buffers are overwritten by kernel, so they are only filled with pattern if there is one. New buffer is not
+        // visible to any queue yet, so it can be filled directly.
+        if (!buffer->isZeroCopy() && kernelArgument.hasFillPattern())
+        {
+            kernelArgument.fillWithPattern(buffer->getData(), kernelArgument.getDataSizeInBytes());
+        }
+
+        eventId = nextEventId++;
+        bufferEvents.insert(eventId, createEvent(eventId, false));
+    }
+    else
+    {
+        HostBuffer* bufferPointer = buffer.get();
+        const void* source = kernelArgument.getData();
+        const size_t dataSize = kernelArgument.getDataSizeInBytes();
+        eventId = enqueueBufferOperation([bufferPointer, source, dataSize]() { bufferPointer->uploadData(source, dataSize); }, queue);
+    }
+
+    buffers.insert(std::move(buffer));
+    return eventId;
+}
+
+uint64_t HostEngine::updateArgument(const ArgumentId id, const void* data, const size_t dataSizeInBytes)
+{
+    EventId eventId = updateArgumentAsync(id, data, dataSizeInBytes, getDefaultQueue());
+    return getArgumentOperationDuration(eventId);
+}
+
+EventId HostEngine::updateArgumentAsync(const ArgumentId id, const void* data, const size_t dataSizeInBytes, const QueueId queue)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    checkQueueIndex(queue);
+    restoreSpilledBuffer(id);
+
+    HostBuffer* buffer = findBuffer(id);
+
+    if (buffer == nullptr)
+    {
+        throw std::runtime_error(std::string("Buffer with following id was not found: ") + std::to_string(id));
+    }
+
+    Logger::getLogger().log(LoggingLevel::Debug, "Updating buffer for argument " + std::to_string(id) + ", event id: "
+        + std::to_string(nextEventId));
+
+    const size_t dataSize = dataSizeInBytes == 0 ? buffer->getBufferSize() : dataSizeInBytes;
+    return enqueueBufferOperation([buffer, data, dataSize]() { buffer->uploadData(data, dataSize); }, queue);
+}
+
+uint64_t HostEngine::downloadArgument(const ArgumentId id, void* destination, const size_t dataSizeInBytes) const
+{
+    EventId eventId = downloadArgumentAsync(id, destination, dataSizeInBytes, getDefaultQueue());
+    return getArgumentOperationDuration(eventId);
+}
+
+EventId HostEngine::downloadArgumentAsync(const ArgumentId id, void* destination, const size_t dataSizeInBytes, const QueueId queue) const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    checkQueueIndex(queue);
+
+    HostBuffer* buffer = findBuffer(id);
+    const KernelArgument* spilledArgument = residencyManager.findSpilledArgument(id);
+
+    if (buffer == nullptr && spilledArgument == nullptr)
+    {
+        throw std::runtime_error(std::string("Buffer with following id was not found: ") + std::to_string(id));
+    }
+
+    Logger::getLogger().log(LoggingLevel::Debug, "Downloading buffer for argument " + std::to_string(id) + ", event id: "
+        + std::to_string(nextEventId));
+
+    if (buffer == nullptr)
+    {
+        // Evicted buffer is served from its spilled contents
+        const size_t dataSize = dataSizeInBytes == 0 ? spilledArgument->getDataSizeInBytes() : dataSizeInBytes;
+        std::memcpy(destination, spilledArgument->getData(), dataSize);
+
+        const EventId eventId = nextEventId++;
+        bufferEvents.insert(eventId, createEvent(eventId, false));
+        return eventId;
+    }
+
+    const size_t dataSize = dataSizeInBytes == 0 ? buffer->getBufferSize() : dataSizeInBytes;
+    return enqueueBufferOperation([buffer, destination, dataSize]() { buffer->downloadData(destination, dataSize); }, queue);
+}
+
+KernelArgument HostEngine::downloadArgumentObject(const ArgumentId id, uint64_t* downloadDuration) const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    HostBuffer* buffer = findBuffer(id);
+    const KernelArgument* spilledArgument = residencyManager.findSpilledArgument(id);
+
+    if (buffer == nullptr && spilledArgument != nullptr)
+    {
+        if (downloadDuration != nullptr)
+        {
+            *downloadDuration = 0;
+        }
+
+        return *spilledArgument;
+    }
+
+    if (buffer == nullptr)
+    {
+        throw std::runtime_error(std::string("Buffer with following id was not found: ") + std::to_string(id));
+    }
+
+    KernelArgument argument(buffer->getKernelArgumentId(), buffer->getBufferSize() / buffer->getElementSize(), buffer->getElementSize(),
+        buffer->getDataType(), buffer->getMemoryLocation(), buffer->getAccessType(), ArgumentUploadType::Vector);
+
+    Logger::getLogger().log(LoggingLevel::Debug, "Downloading buffer for argument " + std::to_string(id) + ", event id: "
+        + std::to_string(nextEventId));
+
+    void* destination = argument.getData();
+    const size_t dataSize = argument.getDataSizeInBytes();
+    EventId eventId = enqueueBufferOperation([buffer, destination, dataSize]() { buffer->downloadData(destination, dataSize); },
+        getDefaultQueue());
+
+    uint64_t duration = getArgumentOperationDuration(eventId);
+    if (downloadDuration != nullptr)
+    {
+        *downloadDuration = duration;
+    }
+
+    return argument;
+}
+
+uint64_t HostEngine::copyArgument(const ArgumentId destination, const ArgumentId source, const size_t dataSizeInBytes)
+{
+    EventId eventId = copyArgumentAsync(destination, source, dataSizeInBytes, getDefaultQueue());
+    return getArgumentOperationDuration(eventId);
+}
+
+EventId HostEngine::copyArgumentAsync(const ArgumentId destination, const ArgumentId source, const size_t dataSizeInBytes, const QueueId queue)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    checkQueueIndex(queue);
+    restoreSpilledBuffer(destination);
+    restoreSpilledBuffer(source);
+
+    HostBuffer* destinationBuffer = findBuffer(destination);
+    HostBuffer* sourceBuffer = findBuffer(source);
+
+    if (destinationBuffer == nullptr || sourceBuffer == nullptr)
+    {
+        throw std::runtime_error(std::string("One of the buffers with following ids does not exist: ") + std::to_string(destination) + ", "
+            + std::to_string(source));
+    }
+
+    if (sourceBuffer->getDataType() != destinationBuffer->getDataType())
+    {
+        throw std::runtime_error("Data type for buffers during copying operation must match");
+    }
+
+    Logger::getLogger().log(LoggingLevel::Debug, "Copying buffer for argument " + std::to_string(source) + " into buffer for argument "
+        + std::to_string(destination) + ", event id: " + std::to_string(nextEventId));
+
+    const size_t dataSize = dataSizeInBytes == 0 ? sourceBuffer->getBufferSize() : dataSizeInBytes;
+    return enqueueBufferOperation([destinationBuffer, sourceBuffer, dataSize]()
+    {
+        destinationBuffer->uploadData(sourceBuffer->getData(), dataSize);
+    }, queue);
+}
+
+uint64_t HostEngine::persistArgument(KernelArgument& kernelArgument, const bool flag)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    const bool bufferFound = persistentBuffers.find(kernelArgument.getId()) != nullptr;
+
+    if (bufferFound && !flag)
+    {
+        synchronizeDevice();
+        persistentBuffers.erase(kernelArgument.getId());
+        residencyManager.removePersistentBuffer(kernelArgument.getId());
+    }
+
+    if (flag && !bufferFound)
+    {
+        Logger::getLogger().log(LoggingLevel::Debug, "Uploading persistent buffer for argument " + std::to_string(kernelArgument.getId())
+            + ", event id: " + std::to_string(nextEventId));
+
+        std::unique_ptr<HostBuffer> buffer = createBuffer(kernelArgument);
+        EventId eventId;
+
+        if (buffer->isZeroCopy())
+        {
+            eventId = nextEventId++;
+            bufferEvents.insert(eventId, createEvent(eventId, false));
+        }
+        else
+        {
+            reserveBufferMemory(kernelArgument.getDataSizeInBytes());
+            residencyManager.addPersistentBuffer(kernelArgument.getId(), kernelArgument.getDataSizeInBytes());
+
+            HostBuffer* bufferPointer = buffer.get();
+            const void* source = kernelArgument.getData();
+            const size_t dataSize = kernelArgument.getDataSizeInBytes();
+            eventId = enqueueBufferOperation([bufferPointer, source, dataSize]() { bufferPointer->uploadData(source, dataSize); },
+                getDefaultQueue());
+        }
+
+        persistentBuffers.insert(std::move(buffer));
+        return getArgumentOperationDuration(eventId);
+    }
+
+    return 0;
+}
+
+uint64_t HostEngine::getArgumentOperationDuration(const EventId id) const
+{
+    std::shared_ptr<HostEvent> event;
+
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        event = bufferEvents.take(id);
+    }
+
+    if (event == nullptr)
+    {
+        throw std::runtime_error(std::string("Buffer event with following id does not exist or its result was already retrieved: ")
+            + std::to_string(id));
+    }
+
+    uint64_t duration = 0;
+
+    if (event->isValid())
+    {
+        Logger::getLogger().log(LoggingLevel::Debug, "Performing buffer operation synchronization for event id: " + std::to_string(id));
+        event->wait();
+        duration = event->getEventCommandDuration();
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    recycleEvent(std::move(event));
+    return duration;
+}
+
+void HostEngine::resizeArgument(const ArgumentId id, const size_t newSize, const bool preserveData)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    restoreSpilledBuffer(id);
+    HostBuffer* buffer = findBuffer(id);
+
+    if (buffer == nullptr)
+    {
+        throw std::runtime_error(std::string("Buffer with following id was not found: ") + std::to_string(id));
+    }
+
+    Logger::getLogger().log(LoggingLevel::Debug, "Resizing buffer for argument " + std::to_string(id));
+
+    if (!buffer->isZeroCopy())
+    {
+        residencyManager.touchBuffer(id);
+        if (newSize > buffer->getBufferSize())
+        {
+            reserveBufferMemory(newSize - buffer->getBufferSize());
+        }
+        residencyManager.resizeBuffer(id, newSize);
+    }
+
+    synchronizeDevice();
+    buffer->resize(newSize, preserveData);
+}
+
+void HostEngine::setPersistentBufferUsage(const bool flag)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    persistentBufferFlag = flag;
+}
+
+void HostEngine::clearBuffer(const ArgumentId id)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    residencyManager.releaseSpilledArgument(id);
+    eraseBuffer(id);
+}
+
+void HostEngine::clearBuffers()
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    synchronizeDevice();
+
+    buffers.forEach([this](const HostBuffer& buffer)
+    {
+        residencyManager.removeBuffer(buffer.getKernelArgumentId());
+    });
+
+    buffers.clear();
+    residencyManager.releaseSpilledArguments();
+}
+
+void HostEngine::clearBuffers(const ArgumentAccessType accessType)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    synchronizeDevice();
+    residencyManager.releaseSpilledArguments(accessType);
+    std::vector<ArgumentId> clearedBuffers;
+
+    buffers.forEach([&clearedBuffers, accessType](const HostBuffer& buffer)
+    {
+        if (buffer.getAccessType() == accessType)
+        {
+            clearedBuffers.push_back(buffer.getKernelArgumentId());
+        }
+    });
+
+    for (const auto id : clearedBuffers)
+    {
+        residencyManager.removeBuffer(id);
+        buffers.erase(id);
+    }
+}
+
+void HostEngine::setDeviceMemoryBudget(const size_t budget)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    residencyManager.setBudget(budget);
+}
+
+DeviceMemoryStatistics HostEngine::getDeviceMemoryStatistics() const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    return residencyManager.getStatistics();
+}
+
+ArgumentMemoryLocation HostEngine::getAutomaticMemoryLocation(const ArgumentAccessType accessType) const
+{
+    // Kernels run on host, read-only data can be used in place without making a copy. Kernel must not write to read-only arguments, since
+    // their memory belongs to the user.
+    if (accessType == ArgumentAccessType::ReadOnly)
+    {
+        return ArgumentMemoryLocation::HostZeroCopy;
+    }
+
+    return ArgumentMemoryLocation::Host;
+}
+
+void HostEngine::printComputeAPIInfo(std::ostream& outputTarget) const
+{
+    outputTarget << "Platform 0: " << getPlatformInfo().at(0).getName() << std::endl;
+    outputTarget << "Devices for platform 0:" << std::endl;
+    outputTarget << "Device 0: " << getHostDeviceInfo(0).getName() << std::endl;
+    outputTarget << std::endl;
+}
+
+std::vector<PlatformInfo> HostEngine::getPlatformInfo() const
+{
+    PlatformInfo platform(0, "Host");
+    platform.setVendor("Fly");
+    platform.setVersion(std::to_string(FLY_VERSION_MAJOR) + "." + std::to_string(FLY_VERSION_MINOR) + "." + std::to_string(FLY_VERSION_PATCH));
+    platform.setExtensions("");
+
+    return std::vector<PlatformInfo>{platform};
+}
+
+std::vector<DeviceInfo> HostEngine::getDeviceInfo(const PlatformIndex platform) const
+{
+    if (platform != 0)
+    {
+        throw std::runtime_error(std::string("Invalid platform index: ") + std::to_string(platform));
+    }
+
+    return std::vector<DeviceInfo>{getHostDeviceInfo(0)};
+}
+
+DeviceInfo HostEngine::getCurrentDeviceInfo() const
+{
+    return getHostDeviceInfo(deviceIndex);
+}
+
+void HostEngine::addKernelFunction(const std::string& kernelName, const HostKernelFunction& kernelFunction)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
+    if (!kernelFunction)
+    {
+        throw std::runtime_error(std::string("Host kernel function must be callable, kernel name: ") + kernelName);
+    }
+
+    if (kernelFunctions.find(kernelName) != kernelFunctions.end())
+    {
+        throw std::runtime_error(std::string("Host kernel function with given name already exists: ") + kernelName);
+    }
+
+    kernelFunctions[kernelName] = kernelFunction;
+}
+
+std::unique_ptr<HostBuffer> HostEngine::createBuffer(KernelArgument& kernelArgument) const
+{
+    // Only zero-copy arguments are handed over without copying, other arguments get a separate copy, so that kernel cannot modify user data
+    // and clearing the buffer between configurations restores original argument data
+    const bool zeroCopy = kernelArgument.getMemoryLocation() == ArgumentMemoryLocation::HostZeroCopy;
+    return MakeStdUnique<HostBuffer>(kernelArgument, zeroCopy);
+}
+
+EventId HostEngine::enqueueBufferOperation(const std::function<void()>& operation, const QueueId queue) const
+{
+    const EventId eventId = nextEventId++;
+    auto event = createEvent(eventId, true);
+
+    commandQueues.at(queue)->enqueueCommand([event, operation]()
+    {
+        event->start();
+        try
+        {
+            operation();
+            event->complete();
+        }
+        catch (...)
+        {
+            event->fail(std::current_exception());
+        }
+    });
+
+    bufferEvents.insert(eventId, event);
+    return eventId;
+}
+
+std::shared_ptr<HostEvent> HostEngine::createEvent(const EventId id, const bool validFlag) const
+{
+    std::shared_ptr<HostEvent> event = eventPool.acquire();
+
+    if (event == nullptr)
+    {
+        return std::make_shared<HostEvent>(id, validFlag);
+    }
+
+    event->reset(id, validFlag);
+    return event;
+}
+
+std::shared_ptr<HostEvent> HostEngine::createKernelEvent(const EventId id, const std::string& kernelName, const uint64_t kernelLaunchOverhead)
+    const
+{
+    std::shared_ptr<HostEvent> event = eventPool.acquire();
+
+    if (event == nullptr)
+    {
+        return std::make_shared<HostEvent>(id, kernelName, kernelLaunchOverhead);
+    }
+
+    event->reset(id, kernelName, kernelLaunchOverhead);
+    return event;
+}
+
+void HostEngine::recycleEvent(std::shared_ptr<HostEvent> event) const
+{
+    // Event may still be referenced by command which has not been destroyed yet by its queue
+    if (event.use_count() == 1)
+    {
+        eventPool.release(std::move(event));
+    }
+}
+
+void HostEngine::executeKernel(const HostKernelFunction& kernelFunction, const std::vector<size_t>& globalSize,
+    const std::vector<size_t>& localSize, std::vector<void*> arguments, const std::vector<std::vector<uint8_t>>& scalarValues,
+    const std::vector<size_t>& localMemorySizes, const std::vector<ParameterPair>& parameterPairs) const
+{
+    for (size_t i = 0; i < scalarValues.size(); i++)
+    {
+        if (!scalarValues.at(i).empty())
+        {
+            arguments.at(i) = const_cast<uint8_t*>(scalarValues.at(i).data());
+        }
+    }
+
+    std::vector<size_t> localMemoryOffsets;
+    size_t totalLocalMemorySize = 0;
+    for (const auto localMemorySize : localMemorySizes)
+    {
+        localMemoryOffsets.push_back(totalLocalMemorySize);
+        totalLocalMemorySize += roundUp(localMemorySize, alignof(std::max_align_t));
+    }
+
+    const size_t groupsX = globalSize.at(0) / localSize.at(0);
+    const size_t groupsY = globalSize.at(1) / localSize.at(1);
+    const size_t groupsZ = globalSize.at(2) / localSize.at(2);
+
+    threadPool->parallelFor(groupsX * groupsY * groupsZ, [&](const size_t groupIndex)
+    {
+        // Local memory and argument list are reused by each worker thread across work-groups
+        thread_local std::vector<uint8_t> localMemory;
+        thread_local std::vector<void*> groupArguments;
+        thread_local std::vector<size_t> groupId(3);
+
+        if (localMemory.size() < totalLocalMemorySize)
+        {
+            localMemory.resize(totalLocalMemorySize);
+        }
+
+        groupArguments.assign(arguments.cbegin(), arguments.cend());
+        for (size_t i = 0; i < localMemorySizes.size(); i++)
+        {
+            if (localMemorySizes.at(i) > 0)
+            {
+                groupArguments.at(i) = localMemory.data() + localMemoryOffsets.at(i);
+            }
+        }
+
+        groupId.at(0) = groupIndex % groupsX;
+        groupId.at(1) = (groupIndex / groupsX) % groupsY;
+        groupId.at(2) = groupIndex / (groupsX * groupsY);
+
+        HostKernelContext context(globalSize, localSize, groupId, groupArguments, parameterPairs);
+        kernelFunction(context);
+    });
+}
+
+DeviceInfo HostEngine::getHostDeviceInfo(const DeviceIndex deviceIndex)
+{
+    DeviceInfo result(deviceIndex, "Host CPU");
+    result.setVendor("");
+    result.setExtensions("");
+    result.setDeviceType(DeviceType::CPU);
+    result.setHostUnifiedMemory(true);
+
+    uint64_t memorySize = 0;
+    #ifdef _WIN32
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    if (GlobalMemoryStatusEx(&status))
+    {
+        memorySize = static_cast<uint64_t>(status.ullTotalPhys);
+    }
+    #else
+    const long pageCount = sysconf(_SC_PHYS_PAGES);
+    const long pageSize = sysconf(_SC_PAGE_SIZE);
+    if (pageCount > 0 && pageSize > 0)
+    {
+        memorySize = static_cast<uint64_t>(pageCount) * static_cast<uint64_t>(pageSize);
+    }
+    #endif
+
+    // Local and constant memory are ordinary host memory, so they share the global memory limit
+    result.setGlobalMemorySize(memorySize);
+    result.setLocalMemorySize(memorySize);
+    result.setMaxConstantBufferSize(memorySize);
+
+    uint32_t threadCount = std::thread::hardware_concurrency();
+    result.setMaxComputeUnits(threadCount == 0 ? 1 : threadCount);
+    result.setMaxWorkGroupSize(std::numeric_limits<size_t>::max());
+
+    return result;
+}
+
+HostBuffer* HostEngine::findBuffer(const ArgumentId id) const
+{
+    if (persistentBufferFlag)
+    {
+        HostBuffer* buffer = persistentBuffers.find(id);
+
+        if (buffer != nullptr)
+        {
+            return buffer;
+        }
+    }
+
+    return buffers.find(id);
+}
+
+void HostEngine::eraseBuffer(const ArgumentId id)
+{
+    if (buffers.find(id) != nullptr)
+    {
+        synchronizeDevice();
+        residencyManager.removeBuffer(id);
+        buffers.erase(id);
+    }
+}
+
+void HostEngine::reserveBufferMemory(const size_t size)
+{
+    const std::vector<ArgumentId> evictedBuffers = residencyManager.getEvictionCandidates(size);
+
+    if (evictedBuffers.empty())
+    {
+        return;
+    }
+
+    // Evicted buffers may still be used by commands in flight
+    synchronizeDevice();
+
+    for (const auto id : evictedBuffers)
+    {
+        Logger::getLogger().log(LoggingLevel::Debug, "Evicting buffer for argument " + std::to_string(id));
+
+        if (residencyManager.isSpillRequired(id))
+        {
+            residencyManager.storeSpilledArgument(downloadArgumentObject(id, nullptr));
+        }
+
+        residencyManager.evictBuffer(id);
+        eraseBuffer(id);
+    }
+}
+
+EventId HostEngine::uploadSpilledArgument(KernelArgument& spilledArgument, const QueueId queue)
+{
+    EventId eventId = uploadArgumentAsync(spilledArgument, queue);
+
+    // Host data of write-only arguments is not uploaded, spilled contents have to be restored explicitly
+    if (spilledArgument.getAccessType() == ArgumentAccessType::WriteOnly)
+    {
+        getArgumentOperationDuration(eventId);
+        eventId = updateArgumentAsync(spilledArgument.getId(), spilledArgument.getData(), spilledArgument.getDataSizeInBytes(), queue);
+    }
+
+    // Spilled data is released by caller, so the upload has to be finished
+    synchronizeQueue(queue);
+    return eventId;
+}
+
+void HostEngine::restoreSpilledBuffer(const ArgumentId id)
+{
+    std::unique_ptr<KernelArgument> spilledArgument = residencyManager.takeSpilledArgument(id);
+
+    if (spilledArgument != nullptr)
+    {
+        getArgumentOperationDuration(uploadSpilledArgument(*spilledArgument, getDefaultQueue()));
+    }
+}
+
+void HostEngine::checkLocalMemoryModifiers(const std::vector<KernelArgument*>& argumentPointers,
+    const std::vector<LocalMemoryModifier>& modifiers) const
+{
+    for (const auto& modifier : modifiers)
+    {
+        bool modifierArgumentFound = false;
+
+        for (const auto argument : argumentPointers)
+        {
+            if (modifier.getArgument() == argument->getId() && argument->getUploadType() == ArgumentUploadType::Local)
+            {
+                modifierArgumentFound = true;
+            }
+        }
+
+        if (!modifierArgumentFound)
+        {
+            throw std::runtime_error(std::string("No matching local memory argument found for modifier, argument id in modifier: ")
+                + std::to_string(modifier.getArgument()));
+        }
+    }
+}
+
+HostPreparedKernel HostEngine::createPreparedKernel(const KernelRuntimeData& kernelData) const
+{
+    auto functionPointer = kernelFunctions.find(kernelData.getName());
+    if (functionPointer == kernelFunctions.end())
+    {
+        throw std::runtime_error(std::string("Host kernel function with following name was not added: ") + kernelData.getName());
+    }
+
+    const std::vector<size_t>& localSize = kernelData.getLocalSize();
+    std::vector<size_t> correctedGlobalSize = kernelData.getGlobalSize();
+    if (globalSizeType != GlobalSizeType::OpenCL)
+    {
+        correctedGlobalSize.at(0) *= localSize.at(0);
+        correctedGlobalSize.at(1) *= localSize.at(1);
+        correctedGlobalSize.at(2) *= localSize.at(2);
+    }
+    if (globalSizeCorrection)
+    {
+        correctedGlobalSize = roundUpGlobalSize(correctedGlobalSize, localSize);
+    }
+
+    for (size_t i = 0; i < localSize.size(); i++)
+    {
+        if (localSize.at(i) == 0 || correctedGlobalSize.at(i) % localSize.at(i) != 0)
+        {
+            throw std::runtime_error(std::string("Global size must be a non-zero multiple of local size in dimension: ") + std::to_string(i));
+        }
+    }
+
+    HostPreparedKernel result;
+    result.kernelName = kernelData.getName();
+    result.kernelFunction = functionPointer->second;
+    result.globalSize = correctedGlobalSize;
+    result.localSize = localSize;
+    result.localMemoryModifiers = kernelData.getLocalMemoryModifiers();
+    result.parameterPairs = kernelData.getParameterPairs();
+    return result;
+}
+
+EventId HostEngine::launchKernel(const HostPreparedKernel& preparedKernel, const std::vector<KernelArgument*>& argumentPointers,
+    const QueueId queue, Timer& overheadTimer)
+{
+    checkLocalMemoryModifiers(argumentPointers, preparedKernel.localMemoryModifiers);
+    residencyManager.beginLaunch(argumentPointers);
+
+    std::vector<void*> arguments;
+    std::vector<std::vector<uint8_t>> scalarValues(argumentPointers.size());
+    std::vector<size_t> localMemorySizes(argumentPointers.size(), 0);
+
+    for (size_t i = 0; i < argumentPointers.size(); i++)
+    {
+        KernelArgument& argument = *argumentPointers.at(i);
+
+        if (argument.getUploadType() == ArgumentUploadType::Vector)
+        {
+            HostBuffer* buffer = findBuffer(argument.getId());
+            if (buffer == nullptr)
+            {
+                uploadArgument(argument);
+                buffer = findBuffer(argument.getId());
+            }
+            arguments.push_back(buffer->getData());
+        }
+        else if (argument.getUploadType() == ArgumentUploadType::Scalar)
+        {
+            // Scalar value is copied, so that later argument updates do not affect asynchronous launch
+            const uint8_t* scalarData = static_cast<const uint8_t*>(argument.getData());
+            scalarValues.at(i).assign(scalarData, scalarData + argument.getElementSizeInBytes());
+            arguments.push_back(nullptr);
+        }
+        else
+        {
+            size_t numberOfElements = argument.getNumberOfElements();
+            for (const auto& modifier : preparedKernel.localMemoryModifiers)
+            {
+                if (modifier.getArgument() == argument.getId())
+                {
+                    numberOfElements = modifier.getModifiedSize(numberOfElements);
+                }
+            }
+            localMemorySizes.at(i) = argument.getElementSizeInBytes() * numberOfElements;
+            arguments.push_back(nullptr);
+        }
+    }
+
+    overheadTimer.stop();
+
+    const EventId eventId = nextEventId++;
+    auto event = createKernelEvent(eventId, preparedKernel.kernelName, overheadTimer.getElapsedTime());
+
+    Logger::getLogger().log(LoggingLevel::Debug, "Launching kernel " + preparedKernel.kernelName + ", event id: " + std::to_string(eventId));
+
+    HostKernelFunction kernelFunction = preparedKernel.kernelFunction;
+    std::vector<size_t> correctedGlobalSize = preparedKernel.globalSize;
+    std::vector<size_t> localSize = preparedKernel.localSize;
+    std::vector<ParameterPair> parameterPairs = preparedKernel.parameterPairs;
+
+    commandQueues.at(queue)->enqueueCommand([this, event, kernelFunction, correctedGlobalSize, localSize, arguments, scalarValues,
+        localMemorySizes, parameterPairs]()
+    {
+        event->start();
+        try
+        {
+            executeKernel(kernelFunction, correctedGlobalSize, localSize, arguments, scalarValues, localMemorySizes, parameterPairs);
+            event->complete();
+        }
+        catch (const std::exception& error)
+        {
+            event->fail(std::make_exception_ptr(std::runtime_error(std::string("Host kernel execution failed: ") + error.what())));
+        }
+        catch (...)
+        {
+            event->fail(std::make_exception_ptr(std::runtime_error("Host kernel execution failed with unknown exception")));
+        }
+    });
+
+    kernelEvents.insert(eventId, event);
+    return eventId;
+}
+
+void HostEngine::checkQueueIndex(const QueueId queue) const
+{
+    if (queue >= commandQueues.size())
+    {
+        throw std::runtime_error(std::string("Invalid queue index: ") + std::to_string(queue));
+    }
+}
+
+} // namespace fly
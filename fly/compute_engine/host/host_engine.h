@@ -0,0 +1,146 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <fly/api/host_kernel_context.h>
+#include <fly/compute_engine/host/host_buffer.h>
+#include <fly/compute_engine/host/host_command_queue.h>
+#include <fly/compute_engine/host/host_event.h>
+#include <fly/compute_engine/host/host_prepared_kernel.h>
+#include <fly/compute_engine/host/host_thread_pool.h>
+#include <fly/compute_engine/buffer_residency_manager.h>
+#include <fly/compute_engine/buffer_slot_map.h>
+#include <fly/compute_engine/compute_engine.h>
+#include <fly/compute_engine/event_pool.h>
+#include <fly/compute_engine/event_slot_map.h>
+#include <fly/utility/timer.h>
+
+namespace fly
+{
+
+class HostEngine : public ComputeEngine
+{
+public:
+    // Constructor
+    explicit HostEngine(const DeviceIndex deviceIndex, const uint32_t queueCount);
+    ~HostEngine();
+
+    // Kernel handling methods
+    KernelResult runKernel(const KernelRuntimeData& kernelData, const std::vector<KernelArgument*>& argumentPointers,
+        const std::vector<OutputDescriptor>& outputDescriptors) override;
+    EventId runKernelAsync(const KernelRuntimeData& kernelData, const std::vector<KernelArgument*>& argumentPointers, const QueueId queue) override;
+    KernelResult getKernelResult(const EventId id, const std::vector<OutputDescriptor>& outputDescriptors) const override;
+    uint64_t getKernelOverhead(const EventId id) const override;
+    void compileKernel(const KernelRuntimeData& kernelData) override;
+
+    // Prepared launch methods
+    void prepareKernel(const LaunchId id, const KernelRuntimeData& kernelData) override;
+    EventId runPreparedKernelAsync(const LaunchId id, const std::vector<KernelArgument*>& argumentPointers, const QueueId queue) override;
+    void releasePreparedKernel(const LaunchId id) override;
+
+    // Utility methods
+    void setCompilerOptions(const std::string& options) override;
+    void setGlobalSizeType(const GlobalSizeType type) override;
+    void setAutomaticGlobalSizeCorrection(const bool flag) override;
+    void setKernelCacheUsage(const bool flag) override;
+    void setKernelCacheCapacity(const size_t capacity) override;
+    void setKernelCacheByteBudget(const size_t budget) override;
+    void setKernelCacheEvictionPolicy(const KernelCacheEvictionPolicy policy) override;
+    KernelCacheStatistics getKernelCacheStatistics() const override;
+    void setPersistentKernelCache(const std::string& directory, const size_t maxSizeInBytes) override;
+    void clearKernelCache() override;
+
+    // Queue handling methods
+    QueueId getDefaultQueue() const override;
+    std::vector<QueueId> getAllQueues() const override;
+    void synchronizeQueue(const QueueId queue) override;
+    void synchronizeDevice() override;
+    void clearEvents() override;
+    void enqueueEventWait(const QueueId queue, const EventId id) override;
+
+    // Argument handling methods
+    uint64_t uploadArgument(KernelArgument& kernelArgument) override;
+    EventId uploadArgumentAsync(KernelArgument& kernelArgument, const QueueId queue) override;
+    uint64_t updateArgument(const ArgumentId id, const void* data, const size_t dataSizeInBytes) override;
+    EventId updateArgumentAsync(const ArgumentId id, const void* data, const size_t dataSizeInBytes, const QueueId queue) override;
+    uint64_t downloadArgument(const ArgumentId id, void* destination, const size_t dataSizeInBytes) const override;
+    EventId downloadArgumentAsync(const ArgumentId id, void* destination, const size_t dataSizeInBytes, const QueueId queue) const override;
+    KernelArgument downloadArgumentObject(const ArgumentId id, uint64_t* downloadDuration) const override;
+    uint64_t copyArgument(const ArgumentId destination, const ArgumentId source, const size_t dataSizeInBytes) override;
+    EventId copyArgumentAsync(const ArgumentId destination, const ArgumentId source, const size_t dataSizeInBytes, const QueueId queue) override;
+    uint64_t persistArgument(KernelArgument& kernelArgument, const bool flag) override;
+    uint64_t getArgumentOperationDuration(const EventId id) const override;
+    void resizeArgument(const ArgumentId id, const size_t newSize, const bool preserveData) override;
+    void setPersistentBufferUsage(const bool flag) override;
+    void clearBuffer(const ArgumentId id) override;
+    void clearBuffers() override;
+    void clearBuffers(const ArgumentAccessType accessType) override;
+    ArgumentMemoryLocation getAutomaticMemoryLocation(const ArgumentAccessType accessType) const override;
+    void setDeviceMemoryBudget(const size_t budget) override;
+    DeviceMemoryStatistics getDeviceMemoryStatistics() const override;
+
+    // Information retrieval methods
+    void printComputeAPIInfo(std::ostream& outputTarget) const override;
+    std::vector<PlatformInfo> getPlatformInfo() const override;
+    std::vector<DeviceInfo> getDeviceInfo(const PlatformIndex platform) const override;
+    DeviceInfo getCurrentDeviceInfo() const override;
+
+    // Host kernel methods
+    void addKernelFunction(const std::string& kernelName, const HostKernelFunction& kernelFunction);
+
+private:
+    // Attributes
+    DeviceIndex deviceIndex;
+    uint32_t queueCount;
+    std::string compilerOptions;
+    GlobalSizeType globalSizeType;
+    bool globalSizeCorrection;
+    bool kernelCacheFlag;
+    size_t kernelCacheCapacity;
+    size_t kernelCacheByteBudget;
+    KernelCacheEvictionPolicy kernelCacheEvictionPolicy;
+    bool persistentBufferFlag;
+    mutable std::atomic<EventId> nextEventId;
+    // Guards buffers, events and prepared kernels, public methods may call each other. Events are waited for with the lock released.
+    mutable std::recursive_mutex mutex;
+    std::unique_ptr<HostThreadPool> threadPool;
+    std::vector<std::unique_ptr<HostCommandQueue>> commandQueues;
+    std::map<std::string, HostKernelFunction> kernelFunctions;
+    BufferSlotMap<HostBuffer> buffers;
+    BufferSlotMap<HostBuffer> persistentBuffers;
+    BufferResidencyManager residencyManager;
+    mutable EventSlotMap<std::shared_ptr<HostEvent>> kernelEvents;
+    mutable EventSlotMap<std::shared_ptr<HostEvent>> bufferEvents;
+    mutable EventPool<std::shared_ptr<HostEvent>> eventPool;
+    std::map<LaunchId, HostPreparedKernel> preparedKernels;
+
+    // Helper methods
+    std::unique_ptr<HostBuffer> createBuffer(KernelArgument& kernelArgument) const;
+    HostPreparedKernel createPreparedKernel(const KernelRuntimeData& kernelData) const;
+    EventId launchKernel(const HostPreparedKernel& preparedKernel, const std::vector<KernelArgument*>& argumentPointers, const QueueId queue,
+        Timer& overheadTimer);
+    EventId enqueueBufferOperation(const std::function<void()>& operation, const QueueId queue) const;
+    std::shared_ptr<HostEvent> createEvent(const EventId id, const bool validFlag) const;
+    std::shared_ptr<HostEvent> createKernelEvent(const EventId id, const std::string& kernelName, const uint64_t kernelLaunchOverhead) const;
+    void recycleEvent(std::shared_ptr<HostEvent> event) const;
+    void executeKernel(const HostKernelFunction& kernelFunction, const std::vector<size_t>& globalSize, const std::vector<size_t>& localSize,
+        std::vector<void*> arguments, const std::vector<std::vector<uint8_t>>& scalarValues, const std::vector<size_t>& localMemorySizes,
+        const std::vector<ParameterPair>& parameterPairs) const;
+    static DeviceInfo getHostDeviceInfo(const DeviceIndex deviceIndex);
+    HostBuffer* findBuffer(const ArgumentId id) const;
+    void eraseBuffer(const ArgumentId id);
+    void reserveBufferMemory(const size_t size);
+    EventId uploadSpilledArgument(KernelArgument& spilledArgument, const QueueId queue);
+    void restoreSpilledBuffer(const ArgumentId id);
+    void checkLocalMemoryModifiers(const std::vector<KernelArgument*>& argumentPointers, const std::vector<LocalMemoryModifier>& modifiers) const;
+    void checkQueueIndex(const QueueId queue) const;
+};
+
+} // namespace fly
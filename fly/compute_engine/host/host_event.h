@@ -0,0 +1,128 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include "fly/fly_types.h"
+
+namespace fly
+{
+
+class HostEvent
+{
+public:
+    HostEvent(const EventId id, const bool validFlag) :
+        id(id),
+        kernelName(""),
+        overhead(0),
+        validFlag(validFlag),
+        completedFlag(!validFlag),
+        exception(nullptr)
+    {}
+
+    HostEvent(const EventId id, const std::string& kernelName, const uint64_t kernelLaunchOverhead) :
+        id(id),
+        kernelName(kernelName),
+        overhead(kernelLaunchOverhead),
+        validFlag(true),
+        completedFlag(false),
+        exception(nullptr)
+    {}
+
+    // Pooled events are reused for another operation once their result was retrieved
+    void reset(const EventId id, const bool validFlag)
+    {
+        reset(id, "", 0, validFlag);
+    }
+
+    void reset(const EventId id, const std::string& kernelName, const uint64_t kernelLaunchOverhead)
+    {
+        reset(id, kernelName, kernelLaunchOverhead, true);
+    }
+
+    EventId getId() const
+    {
+        return id;
+    }
+
+    const std::string& getKernelName() const
+    {
+        return kernelName;
+    }
+
+    uint64_t getOverhead() const
+    {
+        return overhead;
+    }
+
+    bool isValid() const
+    {
+        return validFlag;
+    }
+
+    void start()
+    {
+        startTime = std::chrono::steady_clock::now();
+    }
+
+    void complete()
+    {
+        endTime = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(mutex);
+        completedFlag = true;
+        condition.notify_all();
+    }
+
+    void fail(const std::exception_ptr error)
+    {
+        endTime = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(mutex);
+        exception = error;
+        completedFlag = true;
+        condition.notify_all();
+    }
+
+    void wait() const
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this]() { return completedFlag; });
+
+        if (exception != nullptr)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    uint64_t getEventCommandDuration() const
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count());
+    }
+
+private:
+    EventId id;
+    std::string kernelName;
+    uint64_t overhead;
+    bool validFlag;
+    bool completedFlag;
+    std::exception_ptr exception;
+    std::chrono::steady_clock::time_point startTime;
+    std::chrono::steady_clock::time_point endTime;
+    mutable std::mutex mutex;
+    mutable std::condition_variable condition;
+
+    void reset(const EventId id, const std::string& kernelName, const uint64_t kernelLaunchOverhead, const bool validFlag)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->id = id;
+        this->kernelName = kernelName;
+        overhead = kernelLaunchOverhead;
+        this->validFlag = validFlag;
+        completedFlag = !validFlag;
+        exception = nullptr;
+    }
+};
+
+} // namespace fly
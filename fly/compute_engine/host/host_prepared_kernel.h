@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fly/api/host_kernel_context.h>
+#include <fly/api/parameter_pair.h>
+#include <fly/dto/local_memory_modifier.h>
+
+namespace fly
+{
+
+// Kernel function and launch geometry resolved for single configuration, global size is already corrected and validated
+struct HostPreparedKernel
+{
+public:
+    std::string kernelName;
+    HostKernelFunction kernelFunction;
+    std::vector<size_t> globalSize;
+    std::vector<size_t> localSize;
+    std::vector<LocalMemoryModifier> localMemoryModifiers;
+    std::vector<ParameterPair> parameterPairs;
+};
+
+} // namespace fly
@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <fly/compute_engine/host/host_thread_pool.h>
+
+namespace fly
+{
+
+HostThreadPool::HostThreadPool(const uint32_t threadCount) :
+    pendingRanges(0),
+    nextWorkerQueue(0),
+    stopFlag(false)
+{
+    const uint32_t workerCount = std::max(threadCount, 1u);
+
+    for (uint32_t i = 0; i < workerCount; i++)
+    {
+        workerQueues.push_back(std::unique_ptr<HostWorkerQueue>(new HostWorkerQueue()));
+    }
+
+    for (uint32_t i = 0; i < workerCount; i++)
+    {
+        threads.emplace_back(&HostThreadPool::workerLoop, this, i);
+    }
+}
+
+HostThreadPool::~HostThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopFlag = true;
+    }
+    sleepCondition.notify_all();
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+void HostThreadPool::parallelFor(const size_t taskCount, const std::function<void(const size_t)>& task)
+{
+    if (taskCount == 0)
+    {
+        return;
+    }
+
+    const size_t workerCount = workerQueues.size();
+    const size_t grainSize = std::max(taskCount / (workerCount * 8), static_cast<size_t>(1));
+    HostJob job(task, taskCount, grainSize);
+
+    // Initial ranges are spread over all workers, remaining load balancing is done by stealing
+    const size_t rangeCount = std::min(taskCount, workerCount);
+    const uint32_t firstWorker = nextWorkerQueue.fetch_add(1) % static_cast<uint32_t>(workerCount);
+
+    for (size_t i = 0; i < rangeCount; i++)
+    {
+        HostWorkerQueue& queue = *workerQueues.at((firstWorker + i) % workerCount);
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.ranges.push_back(HostTaskRange{&job, taskCount * i / rangeCount, taskCount * (i + 1) / rangeCount});
+        pendingRanges++;
+    }
+    wakeWorkers(true);
+
+    std::unique_lock<std::mutex> lock(job.mutex);
+    job.condition.wait(lock, [&job]() { return job.finishedFlag; });
+
+    if (job.exception != nullptr)
+    {
+        std::rethrow_exception(job.exception);
+    }
+}
+
+uint32_t HostThreadPool::getThreadCount() const
+{
+    return static_cast<uint32_t>(threads.size());
+}
+
+void HostThreadPool::workerLoop(const uint32_t workerIndex)
+{
+    while (true)
+    {
+        HostTaskRange range;
+        if (popRange(workerIndex, range))
+        {
+            executeRange(workerIndex, range);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepCondition.wait(lock, [this]() { return stopFlag || pendingRanges > 0; });
+
+        if (stopFlag && pendingRanges == 0)
+        {
+            return;
+        }
+    }
+}
+
+bool HostThreadPool::popRange(const uint32_t workerIndex, HostTaskRange& range)
+{
+    const size_t workerCount = workerQueues.size();
+
+    // Owner takes the most recently split range, thieves take the oldest (largest) one
+    for (size_t i = 0; i < workerCount; i++)
+    {
+        HostWorkerQueue& queue = *workerQueues.at((workerIndex + i) % workerCount);
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (queue.ranges.empty())
+        {
+            continue;
+        }
+
+        if (i == 0)
+        {
+            range = queue.ranges.back();
+            queue.ranges.pop_back();
+        }
+        else
+        {
+            range = queue.ranges.front();
+            queue.ranges.pop_front();
+        }
+
+        pendingRanges--;
+        return true;
+    }
+
+    return false;
+}
+
+void HostThreadPool::pushRange(const uint32_t workerIndex, const HostTaskRange& range)
+{
+    {
+        HostWorkerQueue& queue = *workerQueues.at(workerIndex);
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.ranges.push_back(range);
+        pendingRanges++;
+    }
+    wakeWorkers(false);
+}
+
+void HostThreadPool::executeRange(const uint32_t workerIndex, HostTaskRange range)
+{
+    HostJob* job = range.job;
+
+    while (range.end - range.begin > job->grainSize)
+    {
+        const size_t middle = range.begin + (range.end - range.begin) / 2;
+        pushRange(workerIndex, HostTaskRange{job, middle, range.end});
+        range.end = middle;
+    }
+
+    const size_t executedTasks = range.end - range.begin;
+
+    try
+    {
+        for (size_t i = range.begin; i < range.end; i++)
+        {
+            job->task(i);
+        }
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        if (job->exception == nullptr)
+        {
+            job->exception = std::current_exception();
+        }
+    }
+
+    // Job object lives on the stack of submitting thread, it must not be touched after it is marked as finished
+    if (job->remainingTasks.fetch_sub(executedTasks) == executedTasks)
+    {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        job->finishedFlag = true;
+        job->condition.notify_all();
+    }
+}
+
+void HostThreadPool::wakeWorkers(const bool allWorkers)
+{
+    // Acquiring the mutex orders notification after predicate check of workers which are about to sleep
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+
+    if (allWorkers)
+    {
+        sleepCondition.notify_all();
+    }
+    else
+    {
+        sleepCondition.notify_one();
+    }
+}
+
+} // namespace fly
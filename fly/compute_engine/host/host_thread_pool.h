@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fly
+{
+
+class HostThreadPool
+{
+public:
+    // Constructor
+    explicit HostThreadPool(const uint32_t threadCount);
+    ~HostThreadPool();
+
+    // Core methods
+    void parallelFor(const size_t taskCount, const std::function<void(const size_t)>& task);
+
+    // Getters
+    uint32_t getThreadCount() const;
+
+private:
+    struct HostJob
+    {
+        explicit HostJob(const std::function<void(const size_t)>& task, const size_t taskCount, const size_t grainSize) :
+            task(task),
+            grainSize(grainSize),
+            remainingTasks(taskCount),
+            exception(nullptr),
+            finishedFlag(false)
+        {}
+
+        const std::function<void(const size_t)>& task;
+        size_t grainSize;
+        std::atomic<size_t> remainingTasks;
+        std::exception_ptr exception;
+        bool finishedFlag;
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+
+    struct HostTaskRange
+    {
+        HostJob* job;
+        size_t begin;
+        size_t end;
+    };
+
+    struct HostWorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<HostTaskRange> ranges;
+    };
+
+    // Attributes
+    std::vector<std::thread> threads;
+    std::vector<std::unique_ptr<HostWorkerQueue>> workerQueues;
+    std::atomic<size_t> pendingRanges;
+    std::atomic<uint32_t> nextWorkerQueue;
+    std::mutex sleepMutex;
+    std::condition_variable sleepCondition;
+    bool stopFlag;
+
+    // Helper methods
+    void workerLoop(const uint32_t workerIndex);
+    bool popRange(const uint32_t workerIndex, HostTaskRange& range);
+    void pushRange(const uint32_t workerIndex, const HostTaskRange& range);
+    void executeRange(const uint32_t workerIndex, HostTaskRange range);
+    void wakeWorkers(const bool allWorkers);
+};
+
+} // namespace fly
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <fly/api/kernel_cache_statistics.h>
+#include <fly/enum/kernel_cache_eviction_policy.h>
+
+namespace fly
+{
+
+// Bounded cache of compiled kernels shared by compute engines. Entries are kept in recency order, most recently used entry is first.
+template <typename Key, typename Value, typename Hash = std::hash<Key>> class KernelCache
+{
+public:
+    // Constructor
+    explicit KernelCache(const size_t capacity) :
+        capacity(capacity),
+        byteBudget(0),
+        evictionPolicy(KernelCacheEvictionPolicy::LeastRecentlyUsed),
+        inflationValue(0),
+        sizeInBytes(0),
+        hitCount(0),
+        missCount(0),
+        evictionCount(0)
+    {}
+
+    // Core methods
+    Value* find(const Key& key)
+    {
+        auto indexPointer = index.find(key);
+
+        if (indexPointer == index.end())
+        {
+            missCount++;
+            return nullptr;
+        }
+
+        hitCount++;
+        auto entry = indexPointer->second;
+        entry->priority = inflationValue + entry->buildTime;
+        entries.splice(entries.begin(), entries, entry);
+        return &entry->value;
+    }
+
+    // Newly inserted entry is always kept, even if it alone exceeds the byte budget
+    Value& insert(const Key& key, Value value, const size_t entrySize, const uint64_t buildTime)
+    {
+        erase(key);
+        evictEntries(1, entrySize);
+
+        entries.emplace_front(key, std::move(value), entrySize, buildTime, inflationValue + buildTime);
+        index.insert(std::make_pair(key, entries.begin()));
+        sizeInBytes += entrySize;
+        return entries.front().value;
+    }
+
+    void erase(const Key& key)
+    {
+        auto indexPointer = index.find(key);
+
+        if (indexPointer != index.end())
+        {
+            sizeInBytes -= indexPointer->second->entrySize;
+            entries.erase(indexPointer->second);
+            index.erase(indexPointer);
+        }
+    }
+
+    void clear()
+    {
+        index.clear();
+        entries.clear();
+        inflationValue = 0;
+        sizeInBytes = 0;
+    }
+
+    // Setters
+    void setCapacity(const size_t capacity)
+    {
+        this->capacity = capacity;
+        evictEntries(0, 0);
+    }
+
+    void setByteBudget(const size_t byteBudget)
+    {
+        this->byteBudget = byteBudget;
+        evictEntries(0, 0);
+    }
+
+    void setEvictionPolicy(const KernelCacheEvictionPolicy evictionPolicy)
+    {
+        this->evictionPolicy = evictionPolicy;
+    }
+
+    // Getters
+    size_t getSize() const
+    {
+        return entries.size();
+    }
+
+    KernelCacheStatistics getStatistics() const
+    {
+        return KernelCacheStatistics(hitCount, missCount, evictionCount, entries.size(), sizeInBytes);
+    }
+
+private:
+    struct KernelCacheEntry
+    {
+        KernelCacheEntry(const Key& key, Value value, const size_t entrySize, const uint64_t buildTime, const uint64_t priority) :
+            key(key),
+            value(std::move(value)),
+            entrySize(entrySize),
+            buildTime(buildTime),
+            priority(priority)
+        {}
+
+        Key key;
+        Value value;
+        size_t entrySize;
+        uint64_t buildTime;
+        uint64_t priority;
+    };
+
+    using EntryIterator = typename std::list<KernelCacheEntry>::iterator;
+
+    // Attributes
+    size_t capacity;
+    size_t byteBudget;
+    KernelCacheEvictionPolicy evictionPolicy;
+    uint64_t inflationValue;
+    size_t sizeInBytes;
+    uint64_t hitCount;
+    uint64_t missCount;
+    uint64_t evictionCount;
+    std::list<KernelCacheEntry> entries;
+    std::unordered_map<Key, EntryIterator, Hash> index;
+
+    // Helper methods
+    void evictEntries(const size_t incomingCount, const size_t incomingSize)
+    {
+        while (!entries.empty() && (entries.size() + incomingCount > capacity || (byteBudget > 0 && sizeInBytes + incomingSize > byteBudget)))
+        {
+            EntryIterator victim = selectVictim();
+
+            // GreedyDual ageing, priorities of entries inserted later are raised by priority of evicted entry
+            if (evictionPolicy == KernelCacheEvictionPolicy::CostAware)
+            {
+                inflationValue = victim->priority;
+            }
+
+            sizeInBytes -= victim->entrySize;
+            index.erase(victim->key);
+            entries.erase(victim);
+            evictionCount++;
+        }
+    }
+
+    EntryIterator selectVictim()
+    {
+        EntryIterator victim = std::prev(entries.end());
+
+        if (evictionPolicy == KernelCacheEvictionPolicy::CostAware)
+        {
+            // Scanning from the least recently used entry resolves ties in favour of recency
+            for (auto entry = entries.rbegin(); entry != entries.rend(); ++entry)
+            {
+                if (entry->priority < victim->priority)
+                {
+                    victim = std::prev(entry.base());
+                }
+            }
+        }
+
+        return victim;
+    }
+};
+
+} // namespace fly
@@ -0,0 +1,330 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <fly/compute_engine/kernel_disk_cache.h>
+#include <fly/utility/logger.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <direct.h>
+#include <process.h>
+#include <sys/stat.h>
+#include <sys/utime.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <utime.h>
+#endif
+
+namespace fly
+{
+
+static const char cacheFileMagic[8] = { 'F', 'L', 'Y', 'K', 'B', 'I', 'N', '1' };
+static const std::string cacheFileExtension = ".bin";
+
+struct KernelDiskCacheHeader
+{
+    char magic[8];
+    uint64_t keyLow;
+    uint64_t keyHigh;
+    uint64_t dataSize;
+    uint64_t checksumLow;
+    uint64_t checksumHigh;
+};
+
+static void createDirectory(const std::string& directory)
+{
+#ifdef _WIN32
+    _mkdir(directory.c_str());
+#else
+    mkdir(directory.c_str(), 0755);
+#endif
+}
+
+static bool replaceFile(const std::string& source, const std::string& destination)
+{
+#ifdef _WIN32
+    return MoveFileExA(source.c_str(), destination.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return std::rename(source.c_str(), destination.c_str()) == 0;
+#endif
+}
+
+static void touchFile(const std::string& file)
+{
+#ifdef _WIN32
+    _utime(file.c_str(), nullptr);
+#else
+    utime(file.c_str(), nullptr);
+#endif
+}
+
+static std::string getTemporaryFileSuffix()
+{
+    static std::atomic<uint64_t> counter(0);
+#ifdef _WIN32
+    const int processId = _getpid();
+#else
+    const int processId = static_cast<int>(getpid());
+#endif
+    return std::string(".tmp.") + std::to_string(processId) + "." + std::to_string(counter++);
+}
+
+// Returns number of bytes between current position and end of file, position is left unchanged
+static uint64_t getRemainingFileSize(FILE* file)
+{
+    const long position = std::ftell(file);
+
+    if (position < 0 || std::fseek(file, 0, SEEK_END) != 0)
+    {
+        return 0;
+    }
+
+    const long end = std::ftell(file);
+    std::fseek(file, position, SEEK_SET);
+    return end > position ? static_cast<uint64_t>(end - position) : 0;
+}
+
+// Returns (modification time, size, path) of all cache files inside directory
+static std::vector<std::pair<std::pair<int64_t, uint64_t>, std::string>> listCacheFiles(const std::string& directory)
+{
+    std::vector<std::pair<std::pair<int64_t, uint64_t>, std::string>> result;
+
+#ifdef _WIN32
+    WIN32_FIND_DATAA findData;
+    HANDLE findHandle = FindFirstFileA((directory + "\\*" + cacheFileExtension).c_str(), &findData);
+
+    if (findHandle == INVALID_HANDLE_VALUE)
+    {
+        return result;
+    }
+
+    do
+    {
+        if ((findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0)
+        {
+            const int64_t time = (static_cast<int64_t>(findData.ftLastWriteTime.dwHighDateTime) << 32) | findData.ftLastWriteTime.dwLowDateTime;
+            const uint64_t size = (static_cast<uint64_t>(findData.nFileSizeHigh) << 32) | findData.nFileSizeLow;
+            result.push_back(std::make_pair(std::make_pair(time, size), directory + "/" + findData.cFileName));
+        }
+    }
+    while (FindNextFileA(findHandle, &findData) != 0);
+
+    FindClose(findHandle);
+#else
+    DIR* directoryHandle = opendir(directory.c_str());
+
+    if (directoryHandle == nullptr)
+    {
+        return result;
+    }
+
+    while (dirent* entry = readdir(directoryHandle))
+    {
+        const std::string name(entry->d_name);
+
+        if (name.size() <= cacheFileExtension.size()
+            || name.compare(name.size() - cacheFileExtension.size(), cacheFileExtension.size(), cacheFileExtension) != 0)
+        {
+            continue;
+        }
+
+        const std::string path = directory + "/" + name;
+        struct stat fileStatus;
+
+        if (stat(path.c_str(), &fileStatus) == 0 && S_ISREG(fileStatus.st_mode))
+        {
+            result.push_back(std::make_pair(std::make_pair(static_cast<int64_t>(fileStatus.st_mtime), static_cast<uint64_t>(fileStatus.st_size)),
+                path));
+        }
+    }
+
+    closedir(directoryHandle);
+#endif
+
+    return result;
+}
+
+KernelDiskCache::KernelDiskCache() :
+    directory(""),
+    maxSizeInBytes(0)
+{}
+
+bool KernelDiskCache::load(const KernelFingerprint& key, std::vector<uint8_t>& data) const
+{
+    if (!isEnabled())
+    {
+        return false;
+    }
+
+    const std::string path = getFilePath(key);
+    FILE* file = std::fopen(path.c_str(), "rb");
+
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    KernelDiskCacheHeader header;
+    bool valid = std::fread(&header, sizeof(header), 1, file) == 1
+        && std::memcmp(header.magic, cacheFileMagic, sizeof(cacheFileMagic)) == 0
+        && header.keyLow == key.getLow()
+        && header.keyHigh == key.getHigh();
+
+    // Size stored in header is checked against actual file size, so that corrupted header cannot cause a huge allocation
+    valid = valid && header.dataSize == getRemainingFileSize(file);
+
+    if (valid)
+    {
+        data.resize(static_cast<size_t>(header.dataSize));
+        valid = data.empty() || std::fread(data.data(), 1, data.size(), file) == data.size();
+    }
+
+    std::fclose(file);
+
+    if (valid)
+    {
+        const KernelFingerprint checksum = KernelFingerprint::compute(data.data(), data.size());
+        valid = checksum.getLow() == header.checksumLow && checksum.getHigh() == header.checksumHigh;
+    }
+
+    if (!valid)
+    {
+        Logger::getLogger().log(LoggingLevel::Warning, std::string("Removing corrupted kernel cache file: ") + path);
+        data.clear();
+        std::remove(path.c_str());
+        return false;
+    }
+
+    // Refreshing modification time keeps recently used files from being trimmed
+    touchFile(path);
+    Logger::getLogger().log(LoggingLevel::Debug, std::string("Loaded kernel from persistent cache: ") + path);
+    return true;
+}
+
+void KernelDiskCache::store(const KernelFingerprint& key, const std::vector<uint8_t>& data) const
+{
+    if (!isEnabled() || data.empty())
+    {
+        return;
+    }
+
+    if (maxSizeInBytes > 0 && data.size() + sizeof(KernelDiskCacheHeader) > maxSizeInBytes)
+    {
+        return;
+    }
+
+    const std::string path = getFilePath(key);
+    const std::string temporaryPath = path + getTemporaryFileSuffix();
+    const KernelFingerprint checksum = KernelFingerprint::compute(data.data(), data.size());
+
+    KernelDiskCacheHeader header;
+    std::memcpy(header.magic, cacheFileMagic, sizeof(cacheFileMagic));
+    header.keyLow = key.getLow();
+    header.keyHigh = key.getHigh();
+    header.dataSize = static_cast<uint64_t>(data.size());
+    header.checksumLow = checksum.getLow();
+    header.checksumHigh = checksum.getHigh();
+
+    FILE* file = std::fopen(temporaryPath.c_str(), "wb");
+
+    if (file == nullptr)
+    {
+        Logger::getLogger().log(LoggingLevel::Warning, std::string("Unable to write kernel cache file: ") + temporaryPath);
+        return;
+    }
+
+    bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 && std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    written = std::fclose(file) == 0 && written;
+
+    // File becomes visible under its final name only once it is complete, concurrent readers never see partial data
+    if (!written || !replaceFile(temporaryPath, path))
+    {
+        Logger::getLogger().log(LoggingLevel::Warning, std::string("Unable to write kernel cache file: ") + path);
+        std::remove(temporaryPath.c_str());
+        return;
+    }
+
+    trimToMaxSize();
+}
+
+void KernelDiskCache::erase(const KernelFingerprint& key) const
+{
+    if (isEnabled())
+    {
+        std::remove(getFilePath(key).c_str());
+    }
+}
+
+void KernelDiskCache::setDirectory(const std::string& directory, const size_t maxSizeInBytes)
+{
+    this->directory = directory;
+    this->maxSizeInBytes = maxSizeInBytes;
+
+    if (isEnabled())
+    {
+        createDirectory(directory);
+        trimToMaxSize();
+    }
+}
+
+bool KernelDiskCache::isEnabled() const
+{
+    return !directory.empty();
+}
+
+const std::string& KernelDiskCache::getDirectory() const
+{
+    return directory;
+}
+
+std::string KernelDiskCache::getFilePath(const KernelFingerprint& key) const
+{
+    return directory + "/" + key.toString() + cacheFileExtension;
+}
+
+void KernelDiskCache::trimToMaxSize() const
+{
+    if (maxSizeInBytes == 0)
+    {
+        return;
+    }
+
+    auto files = listCacheFiles(directory);
+    uint64_t totalSize = 0;
+
+    for (const auto& file : files)
+    {
+        totalSize += file.first.second;
+    }
+
+    if (totalSize <= maxSizeInBytes)
+    {
+        return;
+    }
+
+    // Least recently used files are removed first
+    std::sort(files.begin(), files.end());
+
+    for (const auto& file : files)
+    {
+        if (totalSize <= maxSizeInBytes)
+        {
+            break;
+        }
+
+        if (std::remove(file.second.c_str()) == 0)
+        {
+            totalSize -= file.first.second;
+        }
+    }
+}
+
+} // namespace fly
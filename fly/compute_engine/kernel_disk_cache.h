@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <fly/compute_engine/kernel_fingerprint.h>
+
+namespace fly
+{
+
+// Persistent cache of compiled kernel artifacts stored as one file per fingerprint inside user-specified directory. Files are
+// written atomically and validated on load, any failure of the cache only results in artifact being rebuilt.
+class KernelDiskCache
+{
+public:
+    // Constructor
+    KernelDiskCache();
+
+    // Core methods
+    bool load(const KernelFingerprint& key, std::vector<uint8_t>& data) const;
+    void store(const KernelFingerprint& key, const std::vector<uint8_t>& data) const;
+    void erase(const KernelFingerprint& key) const;
+
+    // Setters
+    void setDirectory(const std::string& directory, const size_t maxSizeInBytes);
+
+    // Getters
+    bool isEnabled() const;
+    const std::string& getDirectory() const;
+
+private:
+    // Attributes
+    std::string directory;
+    size_t maxSizeInBytes;
+
+    // Helper methods
+    std::string getFilePath(const KernelFingerprint& key) const;
+    void trimToMaxSize() const;
+};
+
+} // namespace fly
@@ -0,0 +1,167 @@
+#include <cstring>
+#include <fly/compute_engine/kernel_fingerprint.h>
+
+namespace fly
+{
+
+// Seeded variant of MurmurHash3 x64 128-bit, state of previous field is used as seed of the next one
+static uint64_t rotateLeft(const uint64_t value, const int shift)
+{
+    return (value << shift) | (value >> (64 - shift));
+}
+
+static uint64_t finalizeMix(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+static void hashData(const void* data, const size_t length, uint64_t& h1, uint64_t& h2)
+{
+    const uint64_t c1 = 0x87c37b91114253d5ULL;
+    const uint64_t c2 = 0x4cf5ad432745937fULL;
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    const size_t blockCount = length / 16;
+
+    for (size_t i = 0; i < blockCount; ++i)
+    {
+        uint64_t k1;
+        uint64_t k2;
+        std::memcpy(&k1, bytes + i * 16, sizeof(uint64_t));
+        std::memcpy(&k2, bytes + i * 16 + 8, sizeof(uint64_t));
+
+        k1 *= c1;
+        k1 = rotateLeft(k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+        h1 = rotateLeft(h1, 27);
+        h1 += h2;
+        h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= c2;
+        k2 = rotateLeft(k2, 33);
+        k2 *= c1;
+        h2 ^= k2;
+        h2 = rotateLeft(h2, 31);
+        h2 += h1;
+        h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    const uint8_t* tail = bytes + blockCount * 16;
+    const size_t tailLength = length & 15;
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+
+    for (size_t i = tailLength; i > 8; --i)
+    {
+        k2 ^= static_cast<uint64_t>(tail[i - 1]) << ((i - 9) * 8);
+    }
+    for (size_t i = tailLength < 8 ? tailLength : 8; i > 0; --i)
+    {
+        k1 ^= static_cast<uint64_t>(tail[i - 1]) << ((i - 1) * 8);
+    }
+
+    if (tailLength > 8)
+    {
+        k2 *= c2;
+        k2 = rotateLeft(k2, 33);
+        k2 *= c1;
+        h2 ^= k2;
+    }
+    if (tailLength > 0)
+    {
+        k1 *= c1;
+        k1 = rotateLeft(k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+    }
+
+    h1 ^= static_cast<uint64_t>(length);
+    h2 ^= static_cast<uint64_t>(length);
+    h1 += h2;
+    h2 += h1;
+    h1 = finalizeMix(h1);
+    h2 = finalizeMix(h2);
+    h1 += h2;
+    h2 += h1;
+}
+
+KernelFingerprint::KernelFingerprint() :
+    low(0),
+    high(0)
+{}
+
+KernelFingerprint::KernelFingerprint(const uint64_t low, const uint64_t high) :
+    low(low),
+    high(high)
+{}
+
+KernelFingerprint KernelFingerprint::compute(const std::string& kernelName, const std::string& source, const std::string& compilerOptions,
+    const uint64_t deviceId)
+{
+    uint64_t h1 = deviceId;
+    uint64_t h2 = deviceId;
+
+    hashData(kernelName.data(), kernelName.size(), h1, h2);
+    hashData(source.data(), source.size(), h1, h2);
+    hashData(compilerOptions.data(), compilerOptions.size(), h1, h2);
+
+    return KernelFingerprint(h1, h2);
+}
+
+KernelFingerprint KernelFingerprint::compute(const void* data, const size_t dataSize)
+{
+    uint64_t h1 = 0;
+    uint64_t h2 = 0;
+    hashData(data, dataSize, h1, h2);
+    return KernelFingerprint(h1, h2);
+}
+
+uint64_t KernelFingerprint::getLow() const
+{
+    return low;
+}
+
+uint64_t KernelFingerprint::getHigh() const
+{
+    return high;
+}
+
+std::string KernelFingerprint::toString() const
+{
+    const char* digits = "0123456789abcdef";
+    std::string result(32, '0');
+
+    for (size_t i = 0; i < 16; ++i)
+    {
+        result[15 - i] = digits[(high >> (i * 4)) & 0xf];
+        result[31 - i] = digits[(low >> (i * 4)) & 0xf];
+    }
+
+    return result;
+}
+
+bool KernelFingerprint::operator==(const KernelFingerprint& other) const
+{
+    return low == other.low && high == other.high;
+}
+
+bool KernelFingerprint::operator!=(const KernelFingerprint& other) const
+{
+    return !(*this == other);
+}
+
+bool KernelFingerprint::operator<(const KernelFingerprint& other) const
+{
+    if (high != other.high)
+    {
+        return high < other.high;
+    }
+    return low < other.low;
+}
+
+} // namespace fly
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace fly
+{
+
+// 128-bit content hash identifying compiled kernel, used as key of kernel caches instead of complete kernel source
+class KernelFingerprint
+{
+public:
+    // Constructor
+    KernelFingerprint();
+    explicit KernelFingerprint(const uint64_t low, const uint64_t high);
+
+    // Core methods
+    static KernelFingerprint compute(const std::string& kernelName, const std::string& source, const std::string& compilerOptions,
+        const uint64_t deviceId);
+    static KernelFingerprint compute(const void* data, const size_t dataSize);
+
+    // Getters
+    uint64_t getLow() const;
+    uint64_t getHigh() const;
+    std::string toString() const;
+
+    // Operators
+    bool operator==(const KernelFingerprint& other) const;
+    bool operator!=(const KernelFingerprint& other) const;
+    bool operator<(const KernelFingerprint& other) const;
+
+private:
+    // Attributes
+    uint64_t low;
+    uint64_t high;
+};
+
+struct KernelFingerprintHash
+{
+    size_t operator()(const KernelFingerprint& fingerprint) const
+    {
+        // Both halves are already well mixed
+        return static_cast<size_t>(fingerprint.getLow() ^ fingerprint.getHigh());
+    }
+};
+
+} // namespace fly
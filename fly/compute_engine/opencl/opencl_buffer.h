@@ -32,17 +32,14 @@ public:
         hostPointer(nullptr),
         zeroCopy(zeroCopy)
     {
-        if (memoryLocation == ArgumentMemoryLocation::Host)
+        if (zeroCopy && (memoryLocation == ArgumentMemoryLocation::Host || memoryLocation == ArgumentMemoryLocation::HostZeroCopy))
         {
-            if (!zeroCopy)
-            {
-                openclMemoryFlag = openclMemoryFlag | CL_MEM_ALLOC_HOST_PTR;
-            }
-            else
-            {
-                openclMemoryFlag = openclMemoryFlag | CL_MEM_USE_HOST_PTR;
-                hostPointer = kernelArgument.getData();
-            }
+            openclMemoryFlag = openclMemoryFlag | CL_MEM_USE_HOST_PTR;
+            hostPointer = kernelArgument.getData();
+        }
+        else if (memoryLocation == ArgumentMemoryLocation::Host)
+        {
+            openclMemoryFlag = openclMemoryFlag | CL_MEM_ALLOC_HOST_PTR;
         }
 
         cl_int result;
@@ -143,6 +140,17 @@ public:
         checkOpenCLError(result, "clEnqueueCopyBuffer");
     }
 
+    static bool isFillPatternSizeSupported(const size_t patternSize)
+    {
+        return patternSize <= 128 && (patternSize & (patternSize - 1)) == 0;
+    }
+
+    void fillData(cl_command_queue queue, const void* pattern, const size_t patternSize, cl_event* recordingEvent)
+    {
+        cl_int result = clEnqueueFillBuffer(queue, buffer, pattern, patternSize, 0, bufferSize, 0, nullptr, recordingEvent);
+        checkOpenCLError(result, "clEnqueueFillBuffer");
+    }
+
     void downloadData(cl_command_queue queue, void* destination, const size_t dataSize, cl_event* recordingEvent) const
     {
         if (bufferSize < dataSize)
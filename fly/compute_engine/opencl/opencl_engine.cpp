@@ -1,5 +1,7 @@
 #ifdef FLY_PLATFORM_OPENCL
 
+#include <algorithm>
+#include <cstring>
 #include <fly/compute_engine/opencl/opencl_engine.h>
 #include <fly/utility/fly_utility.h>
 #include <fly/utility/logger.h>
@@ -16,9 +18,9 @@ OpenCLEngine::OpenCLEngine(const PlatformIndex platformIndex, const DeviceIndex
     globalSizeType(GlobalSizeType::OpenCL),
     globalSizeCorrection(false),
     kernelCacheFlag(true),
-    kernelCacheCapacity(10),
     persistentBufferFlag(true),
-    nextEventId(0)
+    nextEventId(0),
+    kernelCache(10)
 {
     auto platforms = getOpenCLPlatforms();
     if (platformIndex >= platforms.size())
@@ -33,6 +35,12 @@ OpenCLEngine::OpenCLEngine(const PlatformIndex platformIndex, const DeviceIndex
     }
 
     cl_device_id device = devices.at(deviceIndex).getId();
+    cl_platform_id platform = platforms.at(platformIndex).getId();
+
+    // Binaries produced by different driver are not reused from persistent cache
+    deviceDescriptor = getPlatformInfoString(platform, CL_PLATFORM_NAME) + "|" + getPlatformInfoString(platform, CL_PLATFORM_VERSION) + "|"
+        + getDeviceInfoString(device, CL_DEVICE_NAME) + "|" + getDeviceInfoString(device, CL_DEVICE_VERSION) + "|"
+        + getDeviceInfoString(device, CL_DRIVER_VERSION);
 
     Logger::getLogger().log(LoggingLevel::Debug, "Initializing OpenCL context");
     context = MakeStdUnique<OpenCLContext>(platforms.at(platformIndex).getId(), std::vector<cl_device_id>{device});
@@ -58,34 +66,14 @@ EventId OpenCLEngine::runKernelAsync(const KernelRuntimeData& kernelData, const
     Timer overheadTimer;
     overheadTimer.start();
 
-    OpenCLKernel* kernel;
-    std::unique_ptr<OpenCLKernel> kernelUnique;
-    std::unique_ptr<OpenCLProgram> program;
-
-    if (kernelCacheFlag)
-    {
-        if (kernelCache.find(std::make_pair(kernelData.getName(), kernelData.getSource())) == kernelCache.end())
-        {
-            if (kernelCache.size() >= kernelCacheCapacity)
-            {
-                clearKernelCache();
-            }
-            std::unique_ptr<OpenCLProgram> cacheProgram = createAndBuildProgram(kernelData.getSource());
-            auto cacheKernel = MakeStdUnique<OpenCLKernel>(cacheProgram->getProgram(), kernelData.getName());
-            kernelCache.insert(std::make_pair(std::make_pair(kernelData.getName(), kernelData.getSource()), std::make_pair(std::move(cacheKernel),
-                std::move(cacheProgram))));
-        }
-        auto cachePointer = kernelCache.find(std::make_pair(kernelData.getName(), kernelData.getSource()));
-        kernel = cachePointer->second.first.get();
-    }
-    else
-    {
-        program = createAndBuildProgram(kernelData.getSource());
-        kernelUnique = MakeStdUnique<OpenCLKernel>(program->getProgram(), kernelData.getName());
-        kernel = kernelUnique.get();
-    }
+    // Entry is held until the kernel is enqueued, even if it gets evicted from cache by another thread meanwhile. Cache does not need
+    // the engine lock, so a program build does not stall launches and transfers of other threads.
+    std::shared_ptr<OpenCLKernelCacheEntry> kernelEntry = loadKernel(kernelData);
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    OpenCLKernel* kernel = kernelEntry->kernel.get();
 
     checkLocalMemoryModifiers(argumentPointers, kernelData.getLocalMemoryModifiers());
+    residencyManager.beginLaunch(argumentPointers);
     kernel->resetKernelArguments();
 
     for (const auto argument : argumentPointers)
@@ -107,9 +95,14 @@ EventId OpenCLEngine::runKernelAsync(const KernelRuntimeData& kernelData, const
 
 KernelResult OpenCLEngine::getKernelResult(const EventId id, const std::vector<OutputDescriptor>& outputDescriptors) const
 {
-    auto eventPointer = kernelEvents.find(id);
+    std::unique_ptr<OpenCLEvent> event;
+
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        event = kernelEvents.take(id);
+    }
 
-    if (eventPointer == kernelEvents.end())
+    if (event == nullptr)
     {
         throw std::runtime_error(std::string("Kernel event with following id does not exist or its result was already retrieved: ")
             + std::to_string(id));
@@ -117,11 +110,15 @@ KernelResult OpenCLEngine::getKernelResult(const EventId id, const std::vector<O
 
     Logger::getLogger().log(LoggingLevel::Debug, std::string("Performing kernel synchronization for event id: ") + std::to_string(id));
 
-    checkOpenCLError(clWaitForEvents(1, eventPointer->second->getEvent()), "clWaitForEvents");
-    std::string name = eventPointer->second->getKernelName();
-    cl_ulong duration = eventPointer->second->getEventCommandDuration();
-    uint64_t overhead = eventPointer->second->getOverhead();
-    kernelEvents.erase(id);
+    checkOpenCLError(clWaitForEvents(1, event->getEvent()), "clWaitForEvents");
+    std::string name = event->getKernelName();
+    cl_ulong duration = event->getEventCommandDuration();
+    uint64_t overhead = event->getOverhead();
+
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        eventPool.release(std::move(event));
+    }
 
     for (const auto& descriptor : outputDescriptors)
     {
@@ -133,36 +130,125 @@ KernelResult OpenCLEngine::getKernelResult(const EventId id, const std::vector<O
     return result;
 }
 
+void OpenCLEngine::compileKernel(const KernelRuntimeData& kernelData)
+{
+    loadKernel(kernelData);
+}
+
+void OpenCLEngine::prepareKernel(const LaunchId id, const KernelRuntimeData& kernelData)
+{
+    std::shared_ptr<OpenCLKernelCacheEntry> kernelEntry = loadKernel(kernelData);
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    preparedKernels[id] = MakeStdUnique<OpenCLPreparedKernel>(kernelEntry, kernelData.getName(), kernelData.getGlobalSize(),
+        kernelData.getLocalSize(), kernelData.getLocalMemoryModifiers());
+}
+
+EventId OpenCLEngine::runPreparedKernelAsync(const LaunchId id, const std::vector<KernelArgument*>& argumentPointers, const QueueId queue)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    Timer overheadTimer;
+    overheadTimer.start();
+
+    auto preparedPointer = preparedKernels.find(id);
+    if (preparedPointer == preparedKernels.end())
+    {
+        throw std::runtime_error(std::string("Prepared kernel launch with following id does not exist: ") + std::to_string(id));
+    }
+
+    OpenCLPreparedKernel& preparedKernel = *preparedPointer->second;
+
+    if (preparedKernel.boundArguments.size() != argumentPointers.size())
+    {
+        checkLocalMemoryModifiers(argumentPointers, preparedKernel.localMemoryModifiers);
+        preparedKernel.boundArguments.assign(argumentPointers.size(), std::vector<uint8_t>{});
+    }
+
+    residencyManager.beginLaunch(argumentPointers);
+
+    for (size_t i = 0; i < argumentPointers.size(); ++i)
+    {
+        KernelArgument& argument = *argumentPointers[i];
+        const cl_uint index = static_cast<cl_uint>(i);
+
+        if (argument.getUploadType() == ArgumentUploadType::Vector)
+        {
+            OpenCLBuffer* buffer = findBuffer(argument.getId());
+            if (buffer == nullptr)
+            {
+                uploadArgument(argument);
+                buffer = findBuffer(argument.getId());
+            }
+
+            cl_mem clBuffer = buffer->getBuffer();
+            bindPreparedArgument(preparedKernel, index, &clBuffer, sizeof(cl_mem), false);
+        }
+        else if (argument.getUploadType() == ArgumentUploadType::Scalar)
+        {
+            bindPreparedArgument(preparedKernel, index, argument.getData(), argument.getElementSizeInBytes(), false);
+        }
+        else
+        {
+            size_t numberOfElements = argument.getNumberOfElements();
+            for (const auto& modifier : preparedKernel.localMemoryModifiers)
+            {
+                if (modifier.getArgument() == argument.getId())
+                {
+                    numberOfElements = modifier.getModifiedSize(numberOfElements);
+                }
+            }
+
+            const size_t localSizeInBytes = argument.getElementSizeInBytes() * numberOfElements;
+            bindPreparedArgument(preparedKernel, index, &localSizeInBytes, sizeof(size_t), true);
+        }
+    }
+
+    overheadTimer.stop();
+
+    return enqueueKernel(*preparedKernel.kernel, preparedKernel.globalSize, preparedKernel.localSize, queue, overheadTimer.getElapsedTime());
+}
+
+void OpenCLEngine::releasePreparedKernel(const LaunchId id)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    preparedKernels.erase(id);
+}
+
 uint64_t OpenCLEngine::getKernelOverhead(const EventId id) const
 {
-    auto eventPointer = kernelEvents.find(id);
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    const std::unique_ptr<OpenCLEvent>* event = kernelEvents.find(id);
 
-    if (eventPointer == kernelEvents.end())
+    if (event == nullptr)
     {
         throw std::runtime_error(std::string("Kernel event with following id does not exist or its result was already retrieved: ")
             + std::to_string(id));
     }
 
-    return eventPointer->second->getOverhead();
+    return (*event)->getOverhead();
 }
 
 void OpenCLEngine::setCompilerOptions(const std::string& options)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     compilerOptions = options;
 }
 
 void OpenCLEngine::setGlobalSizeType(const GlobalSizeType type)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     globalSizeType = type;
 }
 
 void OpenCLEngine::setAutomaticGlobalSizeCorrection(const bool flag)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     globalSizeCorrection = flag;
 }
 
 void OpenCLEngine::setKernelCacheUsage(const bool flag)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
     if (!flag)
     {
         clearKernelCache();
@@ -172,7 +258,27 @@ void OpenCLEngine::setKernelCacheUsage(const bool flag)
 
 void OpenCLEngine::setKernelCacheCapacity(const size_t capacity)
 {
-    kernelCacheCapacity = capacity;
+    kernelCache.setCapacity(capacity);
+}
+
+void OpenCLEngine::setKernelCacheByteBudget(const size_t budget)
+{
+    kernelCache.setByteBudget(budget);
+}
+
+void OpenCLEngine::setKernelCacheEvictionPolicy(const KernelCacheEvictionPolicy policy)
+{
+    kernelCache.setEvictionPolicy(policy);
+}
+
+KernelCacheStatistics OpenCLEngine::getKernelCacheStatistics() const
+{
+    return kernelCache.getStatistics();
+}
+
+void OpenCLEngine::setPersistentKernelCache(const std::string& directory, const size_t maxSizeInBytes)
+{
+    binaryCache.setDirectory(directory, maxSizeInBytes);
 }
 
 void OpenCLEngine::clearKernelCache()
@@ -217,10 +323,32 @@ void OpenCLEngine::synchronizeDevice()
 
 void OpenCLEngine::clearEvents()
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     kernelEvents.clear();
     bufferEvents.clear();
 }
 
+void OpenCLEngine::enqueueEventWait(const QueueId queue, const EventId id)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
+    if (queue >= commandQueues.size())
+    {
+        throw std::runtime_error(std::string("Invalid command queue index: ") + std::to_string(queue));
+    }
+
+    std::unique_ptr<OpenCLEvent>* event = kernelEvents.find(id);
+
+    if (event == nullptr)
+    {
+        throw std::runtime_error(std::string("Kernel event with following id does not exist or its result was already retrieved: ")
+            + std::to_string(id));
+    }
+
+    checkOpenCLError(clEnqueueBarrierWithWaitList(commandQueues.at(queue)->getQueue(), 1, (*event)->getEvent(), nullptr),
+        "clEnqueueBarrierWithWaitList");
+}
+
 uint64_t OpenCLEngine::uploadArgument(KernelArgument& kernelArgument)
 {
     if (kernelArgument.getUploadType() != ArgumentUploadType::Vector)
@@ -234,6 +362,8 @@ uint64_t OpenCLEngine::uploadArgument(KernelArgument& kernelArgument)
 
 EventId OpenCLEngine::uploadArgumentAsync(KernelArgument& kernelArgument, const QueueId queue)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
     if (queue >= commandQueues.size())
     {
         throw std::runtime_error(std::string("Invalid queue index: ") + std::to_string(queue));
@@ -249,8 +379,21 @@ EventId OpenCLEngine::uploadArgumentAsync(KernelArgument& kernelArgument, const
         return UINT64_MAX;
     }
 
+    std::unique_ptr<KernelArgument> spilledArgument = residencyManager.takeSpilledArgument(kernelArgument.getId());
+    if (spilledArgument != nullptr)
+    {
+        return uploadSpilledArgument(*spilledArgument, queue);
+    }
+
+    // Zero-copy buffers use host memory of argument
+    if (kernelArgument.getMemoryLocation() != ArgumentMemoryLocation::HostZeroCopy)
+    {
+        reserveBufferMemory(kernelArgument.getDataSizeInBytes());
+        residencyManager.addBuffer(kernelArgument.getId(), kernelArgument.getDataSizeInBytes(), kernelArgument.getAccessType());
+    }
+
     std::unique_ptr<OpenCLBuffer> buffer = nullptr;
-    EventId eventId = nextEventId;
+    const EventId eventId = nextEventId++;
 
     Logger::getLogger().log(LoggingLevel::Debug, "Uploading buffer for argument " + std::to_string(kernelArgument.getId()) + ", event id: "
         + std::to_string(eventId));
@@ -258,21 +401,45 @@ EventId OpenCLEngine::uploadArgumentAsync(KernelArgument& kernelArgument, const
     if (kernelArgument.getMemoryLocation() == ArgumentMemoryLocation::HostZeroCopy)
     {
         buffer = MakeStdUnique<OpenCLBuffer>(context->getContext(), kernelArgument, true);
-        bufferEvents.insert(std::make_pair(eventId, MakeStdUnique<OpenCLEvent>(eventId, false)));
+        bufferEvents.insert(eventId, createEvent(eventId, false));
+    }
+    else if (kernelArgument.getAccessType() == ArgumentAccessType::WriteOnly)
+    {
+        // Contents of output buffers are overwritten by kernel, host data is not transferred
+        buffer = MakeStdUnique<OpenCLBuffer>(context->getContext(), kernelArgument, false);
+
+        if (kernelArgument.hasFillPattern() && OpenCLBuffer::isFillPatternSizeSupported(kernelArgument.getFillPatternPeriod()))
+        {
+            auto profilingEvent = createEvent(eventId, true);
+            buffer->fillData(commandQueues.at(queue)->getQueue(), kernelArgument.getFillPattern().data(), kernelArgument.getFillPatternPeriod(),
+                profilingEvent->getEvent());
+
+            profilingEvent->setReleaseFlag();
+            bufferEvents.insert(eventId, std::move(profilingEvent));
+        }
+        else
+        {
+            if (kernelArgument.hasFillPattern())
+            {
+                std::vector<uint8_t> filledData(kernelArgument.getDataSizeInBytes());
+                kernelArgument.fillWithPattern(filledData.data(), filledData.size());
+                buffer->uploadData(commandQueues.at(queue)->getQueue(), filledData.data(), filledData.size(), nullptr);
+            }
+            bufferEvents.insert(eventId, createEvent(eventId, false));
+        }
     }
     else
     {
         buffer = MakeStdUnique<OpenCLBuffer>(context->getContext(), kernelArgument, false);
-        auto profilingEvent = MakeStdUnique<OpenCLEvent>(eventId, true);
+        auto profilingEvent = createEvent(eventId, true);
         buffer->uploadData(commandQueues.at(queue)->getQueue(), kernelArgument.getData(), kernelArgument.getDataSizeInBytes(),
             profilingEvent->getEvent());
 
         profilingEvent->setReleaseFlag();
-        bufferEvents.insert(std::make_pair(eventId, std::move(profilingEvent)));
+        bufferEvents.insert(eventId, std::move(profilingEvent));
     }
 
     buffers.insert(std::move(buffer)); // buffer data will be stolen
-    nextEventId++;
     return eventId;
 }
 
@@ -284,11 +451,14 @@ uint64_t OpenCLEngine::updateArgument(const ArgumentId id, const void* data, con
 
 EventId OpenCLEngine::updateArgumentAsync(const ArgumentId id, const void* data, const size_t dataSizeInBytes, const QueueId queue)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
     if (queue >= commandQueues.size())
     {
         throw std::runtime_error(std::string("Invalid queue index: ") + std::to_string(queue));
     }
 
+    restoreSpilledBuffer(id);
     OpenCLBuffer* buffer = findBuffer(id);
 
     if (buffer == nullptr)
@@ -296,8 +466,8 @@ EventId OpenCLEngine::updateArgumentAsync(const ArgumentId id, const void* data,
         throw std::runtime_error(std::string("Buffer with following id was not found: ") + std::to_string(id));
     }
 
-    EventId eventId = nextEventId;
-    auto profilingEvent = MakeStdUnique<OpenCLEvent>(eventId, true);
+    const EventId eventId = nextEventId++;
+    auto profilingEvent = createEvent(eventId, true);
     
     Logger::getLogger().log(LoggingLevel::Debug, "Updating buffer for argument " + std::to_string(id) + ", event id: " + std::to_string(eventId));
 
@@ -311,8 +481,7 @@ EventId OpenCLEngine::updateArgumentAsync(const ArgumentId id, const void* data,
     }
 
     profilingEvent->setReleaseFlag();
-    bufferEvents.insert(std::make_pair(eventId, std::move(profilingEvent)));
-    nextEventId++;
+    bufferEvents.insert(eventId, std::move(profilingEvent));
     return eventId;
 }
 
@@ -324,20 +493,36 @@ uint64_t OpenCLEngine::downloadArgument(const ArgumentId id, void* destination,
 
 EventId OpenCLEngine::downloadArgumentAsync(const ArgumentId id, void* destination, const size_t dataSizeInBytes, const QueueId queue) const
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
     if (queue >= commandQueues.size())
     {
         throw std::runtime_error(std::string("Invalid queue index: ") + std::to_string(queue));
     }
 
     OpenCLBuffer* buffer = findBuffer(id);
+    const KernelArgument* spilledArgument = residencyManager.findSpilledArgument(id);
 
-    if (buffer == nullptr)
+    if (buffer == nullptr && spilledArgument == nullptr)
     {
         throw std::runtime_error(std::string("Buffer with following id was not found: ") + std::to_string(id));
     }
 
-    EventId eventId = nextEventId;
-    auto profilingEvent = MakeStdUnique<OpenCLEvent>(eventId, true);
+    const EventId eventId = nextEventId++;
+
+    if (buffer == nullptr)
+    {
+        // Evicted buffer is served from its spilled contents
+        Logger::getLogger().log(LoggingLevel::Debug, "Downloading spilled buffer for argument " + std::to_string(id) + ", event id: "
+            + std::to_string(eventId));
+
+        const size_t dataSize = dataSizeInBytes == 0 ? spilledArgument->getDataSizeInBytes() : dataSizeInBytes;
+        std::memcpy(destination, spilledArgument->getData(), dataSize);
+        bufferEvents.insert(eventId, createEvent(eventId, false));
+        return eventId;
+    }
+
+    auto profilingEvent = createEvent(eventId, true);
 
     Logger::getLogger().log(LoggingLevel::Debug, "Downloading buffer for argument " + std::to_string(id) + ", event id: " + std::to_string(eventId));
 
@@ -351,14 +536,25 @@ EventId OpenCLEngine::downloadArgumentAsync(const ArgumentId id, void* destinati
     }
 
     profilingEvent->setReleaseFlag();
-    bufferEvents.insert(std::make_pair(eventId, std::move(profilingEvent)));
-    nextEventId++;
+    bufferEvents.insert(eventId, std::move(profilingEvent));
     return eventId;
 }
 
 KernelArgument OpenCLEngine::downloadArgumentObject(const ArgumentId id, uint64_t* downloadDuration) const
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     OpenCLBuffer* buffer = findBuffer(id);
+    const KernelArgument* spilledArgument = residencyManager.findSpilledArgument(id);
+
+    if (buffer == nullptr && spilledArgument != nullptr)
+    {
+        if (downloadDuration != nullptr)
+        {
+            *downloadDuration = 0;
+        }
+
+        return *spilledArgument;
+    }
 
     if (buffer == nullptr)
     {
@@ -368,16 +564,15 @@ KernelArgument OpenCLEngine::downloadArgumentObject(const ArgumentId id, uint64_
     KernelArgument argument(buffer->getKernelArgumentId(), buffer->getBufferSize() / buffer->getElementSize(), buffer->getElementSize(),
         buffer->getDataType(), buffer->getMemoryLocation(), buffer->getAccessType(), ArgumentUploadType::Vector);
 
-    EventId eventId = nextEventId;
-    auto profilingEvent = MakeStdUnique<OpenCLEvent>(eventId, true);
+    const EventId eventId = nextEventId++;
+    auto profilingEvent = createEvent(eventId, true);
 
     Logger::getLogger().log(LoggingLevel::Debug, "Downloading buffer for argument " + std::to_string(id) + ", event id: " + std::to_string(eventId));
     buffer->downloadData(commandQueues.at(getDefaultQueue())->getQueue(), argument.getData(), argument.getDataSizeInBytes(),
         profilingEvent->getEvent());
 
     profilingEvent->setReleaseFlag();
-    bufferEvents.insert(std::make_pair(eventId, std::move(profilingEvent)));
-    nextEventId++;
+    bufferEvents.insert(eventId, std::move(profilingEvent));
 
     uint64_t duration = getArgumentOperationDuration(eventId);
     if (downloadDuration != nullptr)
@@ -396,11 +591,16 @@ uint64_t OpenCLEngine::copyArgument(const ArgumentId destination, const Argument
 
 EventId OpenCLEngine::copyArgumentAsync(const ArgumentId destination, const ArgumentId source, const size_t dataSizeInBytes, const QueueId queue)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
     if (queue >= commandQueues.size())
     {
         throw std::runtime_error(std::string("Invalid queue index: ") + std::to_string(queue));
     }
 
+    restoreSpilledBuffer(destination);
+    restoreSpilledBuffer(source);
+
     OpenCLBuffer* destinationBuffer = findBuffer(destination);
     OpenCLBuffer* sourceBuffer = findBuffer(source);
 
@@ -415,8 +615,8 @@ EventId OpenCLEngine::copyArgumentAsync(const ArgumentId destination, const Argu
         throw std::runtime_error("Data type for buffers during copying operation must match");
     }
 
-    EventId eventId = nextEventId;
-    auto profilingEvent = MakeStdUnique<OpenCLEvent>(eventId, true);
+    const EventId eventId = nextEventId++;
+    auto profilingEvent = createEvent(eventId, true);
 
     Logger::getLogger().log(LoggingLevel::Debug, "Copying buffer for argument " + std::to_string(source) + " into buffer for argument "
         + std::to_string(destination) + ", event id: " + std::to_string(eventId));
@@ -432,37 +632,31 @@ EventId OpenCLEngine::copyArgumentAsync(const ArgumentId destination, const Argu
     }
 
     profilingEvent->setReleaseFlag();
-    bufferEvents.insert(std::make_pair(eventId, std::move(profilingEvent)));
-    nextEventId++;
+    bufferEvents.insert(eventId, std::move(profilingEvent));
     return eventId;
 }
 
 uint64_t OpenCLEngine::persistArgument(KernelArgument& kernelArgument, const bool flag)
 {
-    bool bufferFound = false;
-    auto iterator = persistentBuffers.cbegin();
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    const bool bufferFound = persistentBuffers.find(kernelArgument.getId()) != nullptr;
 
-    while (iterator != persistentBuffers.cend())
+    if (bufferFound && !flag)
     {
-        if (iterator->get()->getKernelArgumentId() == kernelArgument.getId())
-        {
-            bufferFound = true;
-            if (!flag)
-            {
-                persistentBuffers.erase(iterator);
-            }
-            break;
-        }
-        else
-        {
-            ++iterator;
-        }
+        persistentBuffers.erase(kernelArgument.getId());
+        residencyManager.removePersistentBuffer(kernelArgument.getId());
     }
     
     if (flag && !bufferFound)
     {
+        if (kernelArgument.getMemoryLocation() != ArgumentMemoryLocation::HostZeroCopy)
+        {
+            reserveBufferMemory(kernelArgument.getDataSizeInBytes());
+            residencyManager.addPersistentBuffer(kernelArgument.getId(), kernelArgument.getDataSizeInBytes());
+        }
+
         std::unique_ptr<OpenCLBuffer> buffer = nullptr;
-        EventId eventId = nextEventId;
+        const EventId eventId = nextEventId++;
 
         Logger::getLogger().log(LoggingLevel::Debug, "Uploading persistent buffer for argument " + std::to_string(kernelArgument.getId())
             + ", event id: " + std::to_string(eventId));
@@ -470,21 +664,20 @@ uint64_t OpenCLEngine::persistArgument(KernelArgument& kernelArgument, const boo
         if (kernelArgument.getMemoryLocation() == ArgumentMemoryLocation::HostZeroCopy)
         {
             buffer = MakeStdUnique<OpenCLBuffer>(context->getContext(), kernelArgument, true);
-            bufferEvents.insert(std::make_pair(eventId, MakeStdUnique<OpenCLEvent>(eventId, false)));
+            bufferEvents.insert(eventId, createEvent(eventId, false));
         }
         else
         {
             buffer = MakeStdUnique<OpenCLBuffer>(context->getContext(), kernelArgument, false);
-            auto profilingEvent = MakeStdUnique<OpenCLEvent>(eventId, true);
+            auto profilingEvent = createEvent(eventId, true);
             buffer->uploadData(commandQueues.at(getDefaultQueue())->getQueue(), kernelArgument.getData(), kernelArgument.getDataSizeInBytes(),
                 profilingEvent->getEvent());
 
             profilingEvent->setReleaseFlag();
-            bufferEvents.insert(std::make_pair(eventId, std::move(profilingEvent)));
+            bufferEvents.insert(eventId, std::move(profilingEvent));
         }
 
         persistentBuffers.insert(std::move(buffer)); // buffer data will be stolen
-        nextEventId++;
 
         return getArgumentOperationDuration(eventId);
     }
@@ -494,31 +687,41 @@ uint64_t OpenCLEngine::persistArgument(KernelArgument& kernelArgument, const boo
 
 uint64_t OpenCLEngine::getArgumentOperationDuration(const EventId id) const
 {
-    auto eventPointer = bufferEvents.find(id);
+    std::unique_ptr<OpenCLEvent> event;
+
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        event = bufferEvents.take(id);
+    }
 
-    if (eventPointer == bufferEvents.end())
+    if (event == nullptr)
     {
         throw std::runtime_error(std::string("Buffer event with following id does not exist or its result was already retrieved: ")
             + std::to_string(id));
     }
 
-    if (!eventPointer->second->isValid())
+    if (!event->isValid())
     {
-        bufferEvents.erase(id);
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        eventPool.release(std::move(event));
         return 0;
     }
 
     Logger::getLogger().log(LoggingLevel::Debug, "Performing buffer operation synchronization for event id: " + std::to_string(id));
 
-    checkOpenCLError(clWaitForEvents(1, eventPointer->second->getEvent()), "clWaitForEvents");
-    cl_ulong duration = eventPointer->second->getEventCommandDuration();
-    bufferEvents.erase(id);
+    checkOpenCLError(clWaitForEvents(1, event->getEvent()), "clWaitForEvents");
+    cl_ulong duration = event->getEventCommandDuration();
+
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    eventPool.release(std::move(event));
 
     return static_cast<uint64_t>(duration);
 }
 
 void OpenCLEngine::resizeArgument(const ArgumentId id, const size_t newSize, const bool preserveData)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    restoreSpilledBuffer(id);
     OpenCLBuffer* buffer = findBuffer(id);
 
     if (buffer == nullptr)
@@ -527,52 +730,92 @@ void OpenCLEngine::resizeArgument(const ArgumentId id, const size_t newSize, con
     }
 
     Logger::getLogger().log(LoggingLevel::Debug, "Resizing buffer for argument " + std::to_string(id));
+
+    if (buffer->getMemoryLocation() != ArgumentMemoryLocation::HostZeroCopy)
+    {
+        residencyManager.touchBuffer(id);
+        if (newSize > buffer->getBufferSize())
+        {
+            reserveBufferMemory(newSize - buffer->getBufferSize());
+        }
+        residencyManager.resizeBuffer(id, newSize);
+    }
+
     buffer->resize(commandQueues.at(getDefaultQueue())->getQueue(), newSize, preserveData);
 }
 
 void OpenCLEngine::setPersistentBufferUsage(const bool flag)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     persistentBufferFlag = flag;
 }
 
 void OpenCLEngine::clearBuffer(const ArgumentId id)
 {
-    auto iterator = buffers.cbegin();
-
-    while (iterator != buffers.cend())
-    {
-        if (iterator->get()->getKernelArgumentId() == id)
-        {
-            buffers.erase(iterator);
-            return;
-        }
-        else
-        {
-            ++iterator;
-        }
-    }
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    residencyManager.releaseSpilledArgument(id);
+    eraseBuffer(id);
 }
 
 void OpenCLEngine::clearBuffers()
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    buffers.forEach([this](const OpenCLBuffer& buffer)
+    {
+        residencyManager.removeBuffer(buffer.getKernelArgumentId());
+    });
+
     buffers.clear();
+    residencyManager.releaseSpilledArguments();
 }
 
 void OpenCLEngine::clearBuffers(const ArgumentAccessType accessType)
 {
-    auto iterator = buffers.cbegin();
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    residencyManager.releaseSpilledArguments(accessType);
+    std::vector<ArgumentId> clearedBuffers;
 
-    while (iterator != buffers.cend())
+    buffers.forEach([&clearedBuffers, accessType](const OpenCLBuffer& buffer)
     {
-        if (iterator->get()->getOpenclMemoryFlag() == getOpenCLMemoryType(accessType))
-        {
-            iterator = buffers.erase(iterator);
-        }
-        else
+        if (buffer.getOpenclMemoryFlag() == getOpenCLMemoryType(accessType))
         {
-            ++iterator;
+            clearedBuffers.push_back(buffer.getKernelArgumentId());
         }
+    });
+
+    for (const auto id : clearedBuffers)
+    {
+        residencyManager.removeBuffer(id);
+        buffers.erase(id);
+    }
+}
+
+void OpenCLEngine::setDeviceMemoryBudget(const size_t budget)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    residencyManager.setBudget(budget);
+}
+
+DeviceMemoryStatistics OpenCLEngine::getDeviceMemoryStatistics() const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    return residencyManager.getStatistics();
+}
+
+ArgumentMemoryLocation OpenCLEngine::getAutomaticMemoryLocation(const ArgumentAccessType accessType) const
+{
+    if (!getCurrentDeviceInfo().hasHostUnifiedMemory())
+    {
+        return ArgumentMemoryLocation::Device;
+    }
+
+    // Device reads host memory directly, so read-only data does not need to be copied at all
+    if (accessType == ArgumentAccessType::ReadOnly)
+    {
+        return ArgumentMemoryLocation::HostZeroCopy;
     }
+
+    return ArgumentMemoryLocation::Host;
 }
 
 void OpenCLEngine::printComputeAPIInfo(std::ostream& outputTarget) const
@@ -628,11 +871,64 @@ DeviceInfo OpenCLEngine::getCurrentDeviceInfo() const
 
 std::unique_ptr<OpenCLProgram> OpenCLEngine::createAndBuildProgram(const std::string& source) const
 {
+    if (!binaryCache.isEnabled())
+    {
+        auto program = MakeStdUnique<OpenCLProgram>(source, context->getContext(), context->getDevices());
+        program->build(compilerOptions);
+        return program;
+    }
+
+    const KernelFingerprint binaryKey = KernelFingerprint::compute(deviceDescriptor, source, compilerOptions, 0);
+    std::vector<uint8_t> binary;
+
+    if (binaryCache.load(binaryKey, binary))
+    {
+        try
+        {
+            auto program = MakeStdUnique<OpenCLProgram>(binary, source, context->getContext(), context->getDevices());
+            program->build(compilerOptions);
+            return program;
+        }
+        catch (const std::runtime_error& error)
+        {
+            // Binary may be rejected by driver even when its version string did not change
+            Logger::getLogger().log(LoggingLevel::Warning, std::string("Cached OpenCL program binary was rejected, rebuilding from source: ")
+                + error.what());
+            binaryCache.erase(binaryKey);
+        }
+    }
+
     auto program = MakeStdUnique<OpenCLProgram>(source, context->getContext(), context->getDevices());
     program->build(compilerOptions);
+    binaryCache.store(binaryKey, program->getBinary());
     return program;
 }
 
+std::shared_ptr<OpenCLKernelCacheEntry> OpenCLEngine::loadKernel(const KernelRuntimeData& kernelData)
+{
+    if (!kernelCacheFlag)
+    {
+        return buildKernel(kernelData);
+    }
+
+    const uint64_t deviceId = (static_cast<uint64_t>(platformIndex) << 32) | deviceIndex;
+    const auto cacheKey = KernelFingerprint::compute(kernelData.getName(), kernelData.getSource(), compilerOptions, deviceId);
+
+    return kernelCache.getOrBuild(cacheKey, [this, &kernelData](size_t& entrySize)
+    {
+        std::shared_ptr<OpenCLKernelCacheEntry> entry = buildKernel(kernelData);
+        entrySize = entry->program->getBinarySize();
+        return entry;
+    });
+}
+
+std::shared_ptr<OpenCLKernelCacheEntry> OpenCLEngine::buildKernel(const KernelRuntimeData& kernelData) const
+{
+    std::unique_ptr<OpenCLProgram> program = createAndBuildProgram(kernelData.getSource());
+    auto kernel = MakeStdUnique<OpenCLKernel>(program->getProgram(), kernelData.getName());
+    return std::make_shared<OpenCLKernelCacheEntry>(std::move(program), std::move(kernel));
+}
+
 void OpenCLEngine::setKernelArgument(OpenCLKernel& kernel, KernelArgument& argument)
 {
     if (argument.getUploadType() == ArgumentUploadType::Vector)
@@ -668,6 +964,29 @@ void OpenCLEngine::setKernelArgument(OpenCLKernel& kernel, KernelArgument& argum
     kernel.setKernelArgumentLocal(argument.getElementSizeInBytes() * numberOfElements);
 }
 
+void OpenCLEngine::bindPreparedArgument(OpenCLPreparedKernel& preparedKernel, const cl_uint index, const void* value, const size_t valueSize,
+    const bool localMemory) const
+{
+    std::vector<uint8_t>& boundValue = preparedKernel.boundArguments[index];
+    const uint8_t* valueBytes = static_cast<const uint8_t*>(value);
+
+    if (boundValue.size() == valueSize && std::equal(boundValue.begin(), boundValue.end(), valueBytes))
+    {
+        return;
+    }
+
+    if (localMemory)
+    {
+        preparedKernel.kernel->setKernelArgumentAt(index, nullptr, *static_cast<const size_t*>(value));
+    }
+    else
+    {
+        preparedKernel.kernel->setKernelArgumentAt(index, value, valueSize);
+    }
+
+    boundValue.assign(valueBytes, valueBytes + valueSize);
+}
+
 EventId OpenCLEngine::enqueueKernel(OpenCLKernel& kernel, const std::vector<size_t>& globalSize, const std::vector<size_t>& localSize,
     const QueueId queue, const uint64_t kernelLaunchOverhead) const
 {
@@ -688,9 +1007,8 @@ EventId OpenCLEngine::enqueueKernel(OpenCLKernel& kernel, const std::vector<size
         correctedGlobalSize = roundUpGlobalSize(correctedGlobalSize, localSize);
     }
 
-    EventId eventId = nextEventId;
-    auto profilingEvent = MakeStdUnique<OpenCLEvent>(eventId, kernel.getKernelName(), kernelLaunchOverhead);
-    nextEventId++;
+    const EventId eventId = nextEventId++;
+    auto profilingEvent = createKernelEvent(eventId, kernel.getKernelName(), kernelLaunchOverhead);
 
     Logger::getLogger().log(LoggingLevel::Debug, "Launching kernel " + kernel.getKernelName() + ", event id: " + std::to_string(eventId));
     cl_int result = clEnqueueNDRangeKernel(commandQueues.at(queue)->getQueue(), kernel.getKernel(),
@@ -698,7 +1016,7 @@ EventId OpenCLEngine::enqueueKernel(OpenCLKernel& kernel, const std::vector<size
     checkOpenCLError(result, "clEnqueueNDRangeKernel");
 
     profilingEvent->setReleaseFlag();
-    kernelEvents.insert(std::make_pair(eventId, std::move(profilingEvent)));
+    kernelEvents.insert(eventId, std::move(profilingEvent));
     return eventId;
 }
 
@@ -749,6 +1067,10 @@ DeviceInfo OpenCLEngine::getOpenCLDeviceInfo(const PlatformIndex platform, const
     checkOpenCLError(clGetDeviceInfo(id, CL_DEVICE_TYPE, sizeof(cl_device_type), &deviceType, nullptr));
     result.setDeviceType(getDeviceType(deviceType));
 
+    cl_bool hostUnifiedMemory;
+    checkOpenCLError(clGetDeviceInfo(id, CL_DEVICE_HOST_UNIFIED_MEMORY, sizeof(cl_bool), &hostUnifiedMemory, nullptr));
+    result.setHostUnifiedMemory(hostUnifiedMemory == CL_TRUE || deviceType == CL_DEVICE_TYPE_CPU);
+
     return result;
 }
 
@@ -809,24 +1131,102 @@ OpenCLBuffer* OpenCLEngine::findBuffer(const ArgumentId id) const
 {
     if (persistentBufferFlag)
     {
-        for (const auto& buffer : persistentBuffers)
+        OpenCLBuffer* buffer = persistentBuffers.find(id);
+
+        if (buffer != nullptr)
         {
-            if (buffer->getKernelArgumentId() == id)
-            {
-                return buffer.get();
-            }
+            return buffer;
         }
     }
 
-    for (const auto& buffer : buffers)
+    return buffers.find(id);
+}
+
+void OpenCLEngine::eraseBuffer(const ArgumentId id)
+{
+    if (buffers.erase(id))
+    {
+        residencyManager.removeBuffer(id);
+    }
+}
+
+void OpenCLEngine::reserveBufferMemory(const size_t size)
+{
+    const std::vector<ArgumentId> evictedBuffers = residencyManager.getEvictionCandidates(size);
+
+    if (evictedBuffers.empty())
     {
-        if (buffer->getKernelArgumentId() == id)
+        return;
+    }
+
+    // Contents of spilled buffers are downloaded only after all commands which may modify them are finished
+    synchronizeDevice();
+
+    for (const auto id : evictedBuffers)
+    {
+        Logger::getLogger().log(LoggingLevel::Debug, "Evicting buffer for argument " + std::to_string(id));
+
+        if (residencyManager.isSpillRequired(id))
         {
-            return buffer.get();
+            residencyManager.storeSpilledArgument(downloadArgumentObject(id, nullptr));
         }
+
+        residencyManager.evictBuffer(id);
+        eraseBuffer(id);
+    }
+}
+
+EventId OpenCLEngine::uploadSpilledArgument(KernelArgument& spilledArgument, const QueueId queue)
+{
+    EventId eventId = uploadArgumentAsync(spilledArgument, queue);
+
+    // Host data of write-only arguments is not uploaded, spilled contents have to be restored explicitly
+    if (spilledArgument.getAccessType() == ArgumentAccessType::WriteOnly)
+    {
+        getArgumentOperationDuration(eventId);
+        eventId = updateArgumentAsync(spilledArgument.getId(), spilledArgument.getData(), spilledArgument.getDataSizeInBytes(), queue);
+    }
+
+    // Spilled data is released by caller, so the upload has to be finished
+    synchronizeQueue(queue);
+    return eventId;
+}
+
+void OpenCLEngine::restoreSpilledBuffer(const ArgumentId id)
+{
+    std::unique_ptr<KernelArgument> spilledArgument = residencyManager.takeSpilledArgument(id);
+
+    if (spilledArgument != nullptr)
+    {
+        getArgumentOperationDuration(uploadSpilledArgument(*spilledArgument, getDefaultQueue()));
+    }
+}
+
+std::unique_ptr<OpenCLEvent> OpenCLEngine::createEvent(const EventId id, const bool validFlag) const
+{
+    std::unique_ptr<OpenCLEvent> event = eventPool.acquire();
+
+    if (event == nullptr)
+    {
+        return MakeStdUnique<OpenCLEvent>(id, validFlag);
+    }
+
+    event->reset(id, validFlag);
+    return event;
+}
+
+std::unique_ptr<OpenCLEvent> OpenCLEngine::createKernelEvent(const EventId id, const std::string& kernelName,
+    const uint64_t kernelLaunchOverhead) const
+{
+    std::unique_ptr<OpenCLEvent> event = eventPool.acquire();
+
+    if (event == nullptr)
+    {
+        return MakeStdUnique<OpenCLEvent>(id, kernelName, kernelLaunchOverhead);
     }
 
-    return nullptr;
+    event->reset(id, kernelName, kernelLaunchOverhead);
+    return event;
 }
 
 void OpenCLEngine::setKernelArgumentVector(OpenCLKernel& kernel, const OpenCLBuffer& buffer) const
@@ -2,10 +2,11 @@
 
 #ifdef FLY_PLATFORM_OPENCL
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <ostream>
-#include <set>
 #include <string>
 #include <vector>
 #include <fly/compute_engine/opencl/opencl_buffer.h>
@@ -14,9 +15,18 @@
 #include <fly/compute_engine/opencl/opencl_device.h>
 #include <fly/compute_engine/opencl/opencl_event.h>
 #include <fly/compute_engine/opencl/opencl_kernel.h>
+#include <fly/compute_engine/opencl/opencl_kernel_cache_entry.h>
 #include <fly/compute_engine/opencl/opencl_platform.h>
+#include <fly/compute_engine/opencl/opencl_prepared_kernel.h>
 #include <fly/compute_engine/opencl/opencl_program.h>
+#include <fly/compute_engine/buffer_residency_manager.h>
+#include <fly/compute_engine/buffer_slot_map.h>
 #include <fly/compute_engine/compute_engine.h>
+#include <fly/compute_engine/concurrent_kernel_cache.h>
+#include <fly/compute_engine/event_pool.h>
+#include <fly/compute_engine/event_slot_map.h>
+#include <fly/compute_engine/kernel_disk_cache.h>
+#include <fly/compute_engine/kernel_fingerprint.h>
 
 namespace fly
 {
@@ -33,6 +43,12 @@ public:
     EventId runKernelAsync(const KernelRuntimeData& kernelData, const std::vector<KernelArgument*>& argumentPointers, const QueueId queue) override;
     KernelResult getKernelResult(const EventId id, const std::vector<OutputDescriptor>& outputDescriptors) const override;
     uint64_t getKernelOverhead(const EventId id) const override;
+    void compileKernel(const KernelRuntimeData& kernelData) override;
+
+    // Prepared launch methods
+    void prepareKernel(const LaunchId id, const KernelRuntimeData& kernelData) override;
+    EventId runPreparedKernelAsync(const LaunchId id, const std::vector<KernelArgument*>& argumentPointers, const QueueId queue) override;
+    void releasePreparedKernel(const LaunchId id) override;
 
     // Utility methods
     void setCompilerOptions(const std::string& options) override;
@@ -40,6 +56,10 @@ public:
     void setAutomaticGlobalSizeCorrection(const bool flag) override;
     void setKernelCacheUsage(const bool flag) override;
     void setKernelCacheCapacity(const size_t capacity) override;
+    void setKernelCacheByteBudget(const size_t budget) override;
+    void setKernelCacheEvictionPolicy(const KernelCacheEvictionPolicy policy) override;
+    KernelCacheStatistics getKernelCacheStatistics() const override;
+    void setPersistentKernelCache(const std::string& directory, const size_t maxSizeInBytes) override;
     void clearKernelCache() override;
 
     // Queue handling methods
@@ -48,6 +68,7 @@ public:
     void synchronizeQueue(const QueueId queue) override;
     void synchronizeDevice() override;
     void clearEvents() override;
+    void enqueueEventWait(const QueueId queue, const EventId id) override;
 
     // Argument handling methods
     uint64_t uploadArgument(KernelArgument& kernelArgument) override;
@@ -66,6 +87,9 @@ public:
     void clearBuffer(const ArgumentId id) override;
     void clearBuffers() override;
     void clearBuffers(const ArgumentAccessType accessType) override;
+    ArgumentMemoryLocation getAutomaticMemoryLocation(const ArgumentAccessType accessType) const override;
+    void setDeviceMemoryBudget(const size_t budget) override;
+    DeviceMemoryStatistics getDeviceMemoryStatistics() const override;
 
     // Information retrieval methods
     void printComputeAPIInfo(std::ostream& outputTarget) const override;
@@ -84,20 +108,31 @@ private:
     GlobalSizeType globalSizeType;
     bool globalSizeCorrection;
     bool kernelCacheFlag;
-    size_t kernelCacheCapacity;
     bool persistentBufferFlag;
-    mutable EventId nextEventId;
+    mutable std::atomic<EventId> nextEventId;
+    // Cached kernel objects are shared, their arguments are set and enqueued while holding the lock. Synchronous operations are composed
+    // of asynchronous ones, so the lock is recursive. Events are waited for outside of it.
+    mutable std::recursive_mutex mutex;
     std::unique_ptr<OpenCLContext> context;
     std::vector<std::unique_ptr<OpenCLCommandQueue>> commandQueues;
-    std::set<std::unique_ptr<OpenCLBuffer>> buffers;
-    std::set<std::unique_ptr<OpenCLBuffer>> persistentBuffers;
-    std::map<std::pair<std::string, std::string>, std::pair<std::unique_ptr<OpenCLKernel>, std::unique_ptr<OpenCLProgram>>> kernelCache;
-    mutable std::map<EventId, std::unique_ptr<OpenCLEvent>> kernelEvents;
-    mutable std::map<EventId, std::unique_ptr<OpenCLEvent>> bufferEvents;
+    BufferSlotMap<OpenCLBuffer> buffers;
+    BufferSlotMap<OpenCLBuffer> persistentBuffers;
+    BufferResidencyManager residencyManager;
+    ConcurrentKernelCache<OpenCLKernelCacheEntry> kernelCache;
+    KernelDiskCache binaryCache;
+    std::string deviceDescriptor;
+    mutable EventSlotMap<std::unique_ptr<OpenCLEvent>> kernelEvents;
+    std::map<LaunchId, std::unique_ptr<OpenCLPreparedKernel>> preparedKernels;
+    mutable EventSlotMap<std::unique_ptr<OpenCLEvent>> bufferEvents;
+    mutable EventPool<std::unique_ptr<OpenCLEvent>> eventPool;
 
     // Helper methods
+    std::shared_ptr<OpenCLKernelCacheEntry> loadKernel(const KernelRuntimeData& kernelData);
+    std::shared_ptr<OpenCLKernelCacheEntry> buildKernel(const KernelRuntimeData& kernelData) const;
     void setKernelArgument(OpenCLKernel& kernel, KernelArgument& argument);
     void setKernelArgument(OpenCLKernel& kernel, KernelArgument& argument, const std::vector<LocalMemoryModifier>& modifiers);
+    void bindPreparedArgument(OpenCLPreparedKernel& preparedKernel, const cl_uint index, const void* value, const size_t valueSize,
+        const bool localMemory) const;
     EventId enqueueKernel(OpenCLKernel& kernel, const std::vector<size_t>& globalSize, const std::vector<size_t>& localSize,
         const QueueId queue, const uint64_t kernelLaunchOverhead) const;
     static PlatformInfo getOpenCLPlatformInfo(const PlatformIndex platform);
@@ -106,6 +141,12 @@ private:
     static std::vector<OpenCLDevice> getOpenCLDevices(const OpenCLPlatform& platform);
     static DeviceType getDeviceType(const cl_device_type deviceType);
     OpenCLBuffer* findBuffer(const ArgumentId id) const;
+    void eraseBuffer(const ArgumentId id);
+    void reserveBufferMemory(const size_t size);
+    EventId uploadSpilledArgument(KernelArgument& spilledArgument, const QueueId queue);
+    void restoreSpilledBuffer(const ArgumentId id);
+    std::unique_ptr<OpenCLEvent> createEvent(const EventId id, const bool validFlag) const;
+    std::unique_ptr<OpenCLEvent> createKernelEvent(const EventId id, const std::string& kernelName, const uint64_t kernelLaunchOverhead) const;
     void setKernelArgumentVector(OpenCLKernel& kernel, const OpenCLBuffer& buffer) const;
     bool loadBufferFromCache(const ArgumentId id, OpenCLKernel& kernel) const;
     void checkLocalMemoryModifiers(const std::vector<KernelArgument*>& argumentPointers, const std::vector<LocalMemoryModifier>& modifiers) const;
@@ -36,6 +36,17 @@ public:
         }
     }
 
+    // Pooled events are reused for another operation once their result was retrieved, previous OpenCL event is released
+    void reset(const EventId id, const bool validFlag)
+    {
+        reset(id, "", 0, validFlag);
+    }
+
+    void reset(const EventId id, const std::string& kernelName, const uint64_t kernelLaunchOverhead)
+    {
+        reset(id, kernelName, kernelLaunchOverhead, true);
+    }
+
     EventId getId() const
     {
         return id;
@@ -83,6 +94,20 @@ private:
     bool validFlag;
     bool releaseFlag;
     cl_event event;
+
+    void reset(const EventId id, const std::string& kernelName, const uint64_t kernelLaunchOverhead, const bool validFlag)
+    {
+        if (releaseFlag)
+        {
+            checkOpenCLError(clReleaseEvent(event), "clReleaseEvent");
+        }
+
+        this->id = id;
+        this->kernelName = kernelName;
+        overhead = kernelLaunchOverhead;
+        this->validFlag = validFlag;
+        releaseFlag = false;
+    }
 };
 
 } // namespace fly
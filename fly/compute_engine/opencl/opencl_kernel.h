@@ -43,6 +43,12 @@ public:
         argumentsCount++;
     }
 
+    // Sets argument at explicit index, value is nullptr for local memory arguments
+    void setKernelArgumentAt(const cl_uint index, const void* value, const size_t valueSize)
+    {
+        checkOpenCLError(clSetKernelArg(kernel, index, valueSize, value), "clSetKernelArg");
+    }
+
     void resetKernelArguments()
     {
         argumentsCount = 0;
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <memory>
+#include <fly/compute_engine/opencl/opencl_kernel.h>
+#include <fly/compute_engine/opencl/opencl_program.h>
+
+namespace fly
+{
+
+struct OpenCLKernelCacheEntry
+{
+public:
+    OpenCLKernelCacheEntry(std::unique_ptr<OpenCLProgram> program, std::unique_ptr<OpenCLKernel> kernel) :
+        program(std::move(program)),
+        kernel(std::move(kernel))
+    {}
+
+    std::unique_ptr<OpenCLProgram> program;
+    std::unique_ptr<OpenCLKernel> kernel;
+};
+
+} // namespace fly
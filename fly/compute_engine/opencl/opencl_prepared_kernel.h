@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <fly/compute_engine/opencl/opencl_kernel.h>
+#include <fly/compute_engine/opencl/opencl_kernel_cache_entry.h>
+#include <fly/dto/local_memory_modifier.h>
+#include <fly/fly_types.h>
+
+namespace fly
+{
+
+// Prepared launch pins program from kernel cache and owns separate kernel object. Argument table of the kernel object is therefore
+// not modified by other launches, so that only arguments whose values changed since the previous launch need to be set again.
+struct OpenCLPreparedKernel
+{
+public:
+    OpenCLPreparedKernel(std::shared_ptr<OpenCLKernelCacheEntry> cacheEntry, const std::string& kernelName, const std::vector<size_t>& globalSize,
+        const std::vector<size_t>& localSize, const std::vector<LocalMemoryModifier>& localMemoryModifiers) :
+        cacheEntry(cacheEntry),
+        kernel(MakeStdUnique<OpenCLKernel>(cacheEntry->program->getProgram(), kernelName)),
+        globalSize(globalSize),
+        localSize(localSize),
+        localMemoryModifiers(localMemoryModifiers)
+    {}
+
+    std::shared_ptr<OpenCLKernelCacheEntry> cacheEntry;
+    std::unique_ptr<OpenCLKernel> kernel;
+    std::vector<size_t> globalSize;
+    std::vector<size_t> localSize;
+    std::vector<LocalMemoryModifier> localMemoryModifiers;
+    // Value last set for each argument index, buffer handle for vectors and size in bytes for local memory
+    std::vector<std::vector<uint8_t>> boundArguments;
+};
+
+} // namespace fly
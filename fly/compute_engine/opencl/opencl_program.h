@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <fly/compute_engine/opencl/opencl_common.h>
@@ -23,6 +25,32 @@ public:
         checkOpenCLError(result, "clCreateProgramWithSource");
     }
 
+    // Program is created from binary previously retrieved with getBinary(), source is kept only for informational purposes
+    explicit OpenCLProgram(const std::vector<uint8_t>& binary, const std::string& source, const cl_context context,
+        const std::vector<cl_device_id>& devices) :
+        source(source),
+        context(context),
+        devices(devices)
+    {
+        if (devices.size() != 1)
+        {
+            throw std::runtime_error("OpenCL program can be created from binary only for single device");
+        }
+
+        cl_int result;
+        cl_int binaryStatus = CL_SUCCESS;
+        size_t binarySize = binary.size();
+        const unsigned char* binaryPointer = binary.data();
+        program = clCreateProgramWithBinary(context, 1, &devices.at(0), &binarySize, &binaryPointer, &binaryStatus, &result);
+
+        if (result == CL_SUCCESS && binaryStatus != CL_SUCCESS)
+        {
+            clReleaseProgram(program);
+            result = binaryStatus;
+        }
+        checkOpenCLError(result, "clCreateProgramWithBinary");
+    }
+
     ~OpenCLProgram()
     {
         checkOpenCLError(clReleaseProgram(program), "clReleaseProgram");
@@ -50,6 +78,31 @@ public:
         return infoString;
     }
 
+    size_t getBinarySize() const
+    {
+        std::vector<size_t> binarySizes(devices.size());
+        checkOpenCLError(clGetProgramInfo(program, CL_PROGRAM_BINARY_SIZES, binarySizes.size() * sizeof(size_t), binarySizes.data(), nullptr),
+            "clGetProgramInfo");
+
+        size_t result = 0;
+        for (const auto binarySize : binarySizes)
+        {
+            result += binarySize;
+        }
+        return result;
+    }
+
+    std::vector<uint8_t> getBinary() const
+    {
+        size_t binarySize;
+        checkOpenCLError(clGetProgramInfo(program, CL_PROGRAM_BINARY_SIZES, sizeof(size_t), &binarySize, nullptr), "clGetProgramInfo");
+
+        std::vector<uint8_t> binary(binarySize);
+        unsigned char* binaryPointer = binary.data();
+        checkOpenCLError(clGetProgramInfo(program, CL_PROGRAM_BINARIES, sizeof(unsigned char*), &binaryPointer, nullptr), "clGetProgramInfo");
+        return binary;
+    }
+
     cl_context getContext() const
     {
         return context;
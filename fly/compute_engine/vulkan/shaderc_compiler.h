@@ -3,13 +3,11 @@
 #include <cstdint>
 #include <stdexcept>
 #include <string>
-#include <fly/api/parameter_pair.h>
 #include "shaderc_fly/shaderrc_fly.hpp"
 
 namespace fly
 {
 
-
 class ShadercCompiler
 {
 public:
@@ -19,51 +17,63 @@ public:
         return instance;
     }
 
+    // Local size is spliced into legacy shaders which contain //{DEFINE_LOCAL_SIZE} marker, other shaders receive local size and tuning
+    // parameters through specialization constants, so that their SPIR-V does not depend on configuration
     std::vector<uint32_t> compile(const std::string& name, const std::string& source, const VkShaderStageFlagBits kind,
-        const std::vector<size_t>& localSize, const std::vector<ParameterPair>& parameterPairs)
+        const std::vector<size_t>& localSize)
     {
-        std::string marco_str = "";
-        marco_str =  marco_str + "#define LOCAL_SIZE_X "+ std::to_string(localSize[0]) +"\n";
-        marco_str =  marco_str + "#define LOCAL_SIZE_Y "+ std::to_string(localSize[1]) +"\n";
-        marco_str =  marco_str + "#define LOCAL_SIZE_Z "+ std::to_string(localSize[2]) +"\n";
-        
-        
-        std::string preprocessedSource = replaceAll(source, "//{DEFINE_LOCAL_SIZE}", marco_str);
-        
-        
+        std::string preprocessedSource = source;
+
+        if (usesLocalSizeDefines(source))
+        {
+            std::string marco_str = "";
+            marco_str =  marco_str + "#define LOCAL_SIZE_X "+ std::to_string(localSize[0]) +"\n";
+            marco_str =  marco_str + "#define LOCAL_SIZE_Y "+ std::to_string(localSize[1]) +"\n";
+            marco_str =  marco_str + "#define LOCAL_SIZE_Z "+ std::to_string(localSize[2]) +"\n";
+            preprocessedSource = replaceAll(source, localSizeMarker, marco_str);
+        }
+
         std::vector<uint32_t> compiledSource = compileShader(name, preprocessedSource, kind);
         return compiledSource;
     }
 
+    static bool usesLocalSizeDefines(const std::string& source)
+    {
+        return source.find(localSizeMarker) != std::string::npos;
+    }
+
     ShadercCompiler(const ShadercCompiler&) = delete;
     ShadercCompiler(ShadercCompiler&&) = delete;
     void operator=(const ShadercCompiler&) = delete;
     void operator=(ShadercCompiler&&) = delete;
 
 private:
-   
+    static constexpr const char* localSizeMarker = "//{DEFINE_LOCAL_SIZE}";
+
+    // Process-wide glslang state is initialized only once, so that shaders can be compiled from multiple threads concurrently, e.g. by
+    // workers of kernel compile service during precompilation of configurations
     ShadercCompiler()
     {
-       
+        init_glslang();
     }
 
-
+    ~ShadercCompiler()
+    {
+        finalize_glslang();
+    }
 
     std::vector<uint32_t> compileShader(const std::string& name, const std::string& source, const VkShaderStageFlagBits kind)
     {
-        
-        // Convert GLSL to SPIR-V
-        init_glslang();
         std::vector<unsigned int> spv;
+        std::string log;
 
-        bool  retVal = GLSLtoSPV(kind , source, spv);
-        assert(retVal);
-        finalize_glslang();
-        
-        return spv;
+        if (!GLSLtoSPV(kind, source, spv, log))
+        {
+            throw std::runtime_error(std::string("Failed to compile shader ") + name + ":\n" + log);
+        }
 
+        return spv;
     }
-
 };
 
 } // namespace fly
@@ -26,6 +26,7 @@ static android_app *Android_application = nullptr;
 #elif (defined(VK_USE_PLATFORM_IOS_MVK) || defined(VK_USE_PLATFORM_MACOS_MVK))
 
 
+#include <mutex>
 #include <MoltenVKGLSLToSPIRVConverter/GLSLToSPIRVConverter.h>
 
 #else
@@ -45,7 +46,10 @@ namespace fly {
     
     void finalize_glslang() {}
     
-    bool GLSLtoSPV(const VkShaderStageFlagBits shader_type,std::string pshader, std::vector<unsigned int> &spirv) {
+    // MoltenVK converter is not documented as thread-safe, conversions are therefore serialized
+    static std::mutex converterMutex;
+    
+    bool GLSLtoSPV(const VkShaderStageFlagBits shader_type, const std::string &pshader, std::vector<unsigned int> &spirv, std::string &log) {
         MVKShaderStage shaderStage;
         switch (shader_type) {
             case VK_SHADER_STAGE_VERTEX_BIT:
@@ -72,11 +76,11 @@ namespace fly {
         }
         
         
+        std::lock_guard<std::mutex> lock(converterMutex);
         mvk::GLSLToSPIRVConverter glslConverter;
         glslConverter.setGLSL(pshader);
         bool wasConverted = glslConverter.convert(shaderStage, false, false);
-        const std::string logstr =   glslConverter.getResultLog();
-        std::cout << " glslConverter.convert  log : " << logstr << std::endl;
+        log = glslConverter.getResultLog();
         
         if (wasConverted) {
             spirv = glslConverter.getSPIRV();
@@ -191,6 +195,16 @@ namespace fly {
         Resources.limits.generalConstantMatrixVectorIndexing = 1;
     }
     
+    // Resource limits are built once and shared by all compilations
+    const TBuiltInResource &get_resources() {
+        static const TBuiltInResource Resources = []() {
+            TBuiltInResource result = {};
+            init_resources(result);
+            return result;
+        }();
+        return Resources;
+    }
+    
     EShLanguage FindLanguage(const VkShaderStageFlagBits shader_type) {
         switch (shader_type) {
             case VK_SHADER_STAGE_VERTEX_BIT:
@@ -256,26 +270,25 @@ namespace fly {
     
     //
     // Compile a given string containing GLSL into SPV for use by VK
-    // Return value of false means an error was encountered.
+    // Return value of false means an error was encountered, compiler messages are stored in log.
+    // TShader and TProgram are owned by the calling thread, glslang keeps its pool allocator in thread-local storage, so that
+    // multiple threads can compile concurrently after the process was initialized.
     //
-    bool GLSLtoSPV(const VkShaderStageFlagBits shader_type, std::string pshader, std::vector<unsigned int> &spirv) {
+    bool GLSLtoSPV(const VkShaderStageFlagBits shader_type, const std::string &pshader, std::vector<unsigned int> &spirv, std::string &log) {
 #ifndef __ANDROID__
         EShLanguage stage = FindLanguage(shader_type);
         glslang::TShader shader(stage);
         glslang::TProgram program;
         const char *shaderStrings[1];
-        TBuiltInResource Resources = {};
-        init_resources(Resources);
         
         // Enable SPIR-V and Vulkan rules when parsing GLSL
         EShMessages messages = (EShMessages)(EShMsgSpvRules | EShMsgVulkanRules);
         
-        shaderStrings[0] = pshader;
+        shaderStrings[0] = pshader.c_str();
         shader.setStrings(shaderStrings, 1);
         
-        if (!shader.parse(&Resources, 100, false, messages)) {
-            puts(shader.getInfoLog());
-            puts(shader.getInfoDebugLog());
+        if (!shader.parse(&get_resources(), 100, false, messages)) {
+            log = std::string(shader.getInfoLog()) + shader.getInfoDebugLog();
             return false;  // something didn't work
         }
         
@@ -286,20 +299,18 @@ namespace fly {
         //
         
         if (!program.link(messages)) {
-            puts(shader.getInfoLog());
-            puts(shader.getInfoDebugLog());
-            fflush(stdout);
+            log = std::string(program.getInfoLog()) + program.getInfoDebugLog();
             return false;
         }
         
         glslang::GlslangToSpv(*program.getIntermediate(stage), spirv);
 #else
-        // On Android, use shaderc instead.
-        shaderc::Compiler compiler;
+        // On Android, use shaderc instead. Compiler instance is kept for each thread, it is not reused across threads.
+        static thread_local shaderc::Compiler compiler;
         shaderc::SpvCompilationResult module =
-        compiler.CompileGlslToSpv(pshader, strlen(pshader), MapShadercType(shader_type), "shader");
+        compiler.CompileGlslToSpv(pshader.c_str(), pshader.size(), MapShadercType(shader_type), "shader");
         if (module.GetCompilationStatus() != shaderc_compilation_status_success) {
-            LOGE("Error: Id=%d, Msg=%s", module.GetCompilationStatus(), module.GetErrorMessage().c_str());
+            log = module.GetErrorMessage();
             return false;
         }
         spirv.assign(module.cbegin(), module.cend());
@@ -22,7 +22,8 @@ namespace fly {
     
     void finalize_glslang();
     
-    bool GLSLtoSPV(const VkShaderStageFlagBits shader_type, std::string pshader, std::vector<unsigned int> &spirv);
+    // Safe to call from multiple threads once init_glslang() was called, compiler messages are returned through log
+    bool GLSLtoSPV(const VkShaderStageFlagBits shader_type, const std::string &pshader, std::vector<unsigned int> &spirv, std::string &log);
 
     
 }
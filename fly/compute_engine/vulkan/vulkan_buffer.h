@@ -1,7 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <cstring>
 #include <vulkan/vulkan.h>
+#include <fly/compute_engine/vulkan/vulkan_memory_allocator.h>
 #include <fly/compute_engine/vulkan/vulkan_physical_device.h>
 #include <fly/compute_engine/vulkan/vulkan_utility.h>
 #include <fly/kernel_argument/kernel_argument.h>
@@ -22,8 +25,9 @@ public:
         accessType(source.getAccessType()),
         device(device),
         physicalDevice(&physicalDevice),
-        bufferMemory(nullptr),
-        usageFlags(usageFlags)
+        allocator(nullptr),
+        usageFlags(usageFlags),
+        serialNumber(generateSerialNumber())
     {
         const VkBufferCreateInfo bufferCreateInfo =
         {
@@ -50,8 +54,39 @@ public:
         accessType(kernelArgument.getAccessType()),
         device(device),
         physicalDevice(&physicalDevice),
-        bufferMemory(nullptr),
-        usageFlags(usageFlags)
+        allocator(nullptr),
+        usageFlags(usageFlags),
+        serialNumber(generateSerialNumber())
+    {
+        const VkBufferCreateInfo bufferCreateInfo =
+        {
+            VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            nullptr,
+            0,
+            bufferSize,
+            usageFlags,
+            VK_SHARING_MODE_EXCLUSIVE,
+            0,
+            nullptr
+        };
+
+        checkVulkanError(vkCreateBuffer(device, &bufferCreateInfo, nullptr, &buffer), "vkCreateBuffer");
+    }
+
+    // Buffer which is not associated with any kernel argument, e.g. staging ring
+    explicit VulkanBuffer(VkDevice device, const VulkanPhysicalDevice& physicalDevice, const VkBufferUsageFlags usageFlags,
+        const VkDeviceSize bufferSize) :
+        device(device),
+        physicalDevice(&physicalDevice),
+        allocator(nullptr),
+        bufferSize(bufferSize),
+        usageFlags(usageFlags),
+        elementSize(1),
+        kernelArgumentId(0),
+        dataType(ArgumentDataType::UnsignedChar),
+        memoryLocation(ArgumentMemoryLocation::Host),
+        accessType(ArgumentAccessType::ReadWrite),
+        serialNumber(generateSerialNumber())
     {
         const VkBufferCreateInfo bufferCreateInfo =
         {
@@ -72,9 +107,9 @@ public:
     {
         vkDestroyBuffer(device, buffer, nullptr);
 
-        if (bufferMemory != nullptr)
+        if (allocator != nullptr)
         {
-            vkFreeMemory(device, bufferMemory, nullptr);
+            allocator->free(allocation);
         }
     }
 
@@ -85,37 +120,26 @@ public:
         return requirements;
     }
 
-    void allocateMemory(const VkMemoryPropertyFlags properties)
+    void allocateMemory(VulkanMemoryAllocator& memoryAllocator, const VkMemoryPropertyFlags properties)
     {
-        VkMemoryRequirements memoryRequirements = getMemoryRequirements();
-        uint32_t memoryTypeIndex = physicalDevice->getCompatibleMemoryTypeIndex(memoryRequirements.memoryTypeBits, properties);
-
-        const VkMemoryAllocateInfo memoryAllocateInfo =
-        {
-            VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-            nullptr,
-            memoryRequirements.size,
-            memoryTypeIndex
-        };
-
-        checkVulkanError(vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &bufferMemory), "vkAllocateMemory");
-        checkVulkanError(vkBindBufferMemory(device, buffer, bufferMemory, 0), "vkBindBufferMemory");
+        allocation = memoryAllocator.allocate(getMemoryRequirements(), properties);
+        allocator = &memoryAllocator;
+        checkVulkanError(vkBindBufferMemory(device, buffer, allocation.memory, allocation.offset), "vkBindBufferMemory");
     }
 
     void uploadData(const void* source, const VkDeviceSize dataSize)
     {
-        void* data;
-        checkVulkanError(vkMapMemory(device, bufferMemory, 0, dataSize, 0, &data), "vkMapMemory");
-        std::memcpy(data, source, static_cast<size_t>(dataSize));
-        vkUnmapMemory(device, bufferMemory);
+        std::memcpy(getMappedData(), source, static_cast<size_t>(dataSize));
+    }
+
+    void fillData(const KernelArgument& kernelArgument, const VkDeviceSize dataSize)
+    {
+        kernelArgument.fillWithPattern(getMappedData(), static_cast<size_t>(dataSize));
     }
 
     void downloadData(void* target, const VkDeviceSize dataSize)
     {
-        void* data;
-        checkVulkanError(vkMapMemory(device, bufferMemory, 0, dataSize, 0, &data), "vkMapMemory");
-        std::memcpy(target, data, static_cast<size_t>(dataSize));
-        vkUnmapMemory(device, bufferMemory);
+        std::memcpy(target, getMappedData(), static_cast<size_t>(dataSize));
     }
 
     void recordCopyDataCommand(VkCommandBuffer commandBuffer, VkBuffer sourceBuffer, const VkDeviceSize dataSize)
@@ -140,6 +164,21 @@ public:
         checkVulkanError(vkEndCommandBuffer(commandBuffer), "vkEndCommandBuffer");
     }
 
+    void recordFillDataCommand(VkCommandBuffer commandBuffer, const uint32_t data)
+    {
+        const VkCommandBufferBeginInfo commandBufferBeginInfo =
+        {
+            VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+            nullptr,
+            VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+            nullptr
+        };
+
+        checkVulkanError(vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo), "vkBeginCommandBuffer");
+        vkCmdFillBuffer(commandBuffer, buffer, 0, VK_WHOLE_SIZE, data);
+        checkVulkanError(vkEndCommandBuffer(commandBuffer), "vkEndCommandBuffer");
+    }
+
     VkDevice getDevice() const
     {
         return device;
@@ -160,6 +199,12 @@ public:
         return bufferSize;
     }
 
+    // Vulkan may hand out handle of destroyed buffer to a new one, cached bindings are therefore keyed by serial number which is never reused
+    uint64_t getSerialNumber() const
+    {
+        return serialNumber;
+    }
+
     VkBufferUsageFlags getUsageFlags() const
     {
         return usageFlags;
@@ -190,11 +235,17 @@ public:
         return accessType;
     }
 
+    const VulkanMemoryAllocation& getAllocation() const
+    {
+        return allocation;
+    }
+
 private:
     VkDevice device;
     const VulkanPhysicalDevice* physicalDevice;
     VkBuffer buffer;
-    VkDeviceMemory bufferMemory;
+    VulkanMemoryAllocator* allocator;
+    VulkanMemoryAllocation allocation;
     VkDeviceSize bufferSize;
     VkBufferUsageFlags usageFlags;
     size_t elementSize;
@@ -202,6 +253,23 @@ private:
     ArgumentDataType dataType;
     ArgumentMemoryLocation memoryLocation;
     ArgumentAccessType accessType;
+    uint64_t serialNumber;
+
+    static uint64_t generateSerialNumber()
+    {
+        static std::atomic<uint64_t> nextSerialNumber(1);
+        return nextSerialNumber++;
+    }
+
+    void* getMappedData() const
+    {
+        if (allocator == nullptr || allocation.mappedData == nullptr)
+        {
+            throw std::runtime_error("Vulkan buffer memory is not host visible");
+        }
+
+        return allocation.mappedData;
+    }
 };
 
 } // namespace fly
@@ -0,0 +1,289 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <vulkan/vulkan.h>
+#include <fly/compute_engine/vulkan/vulkan_buffer.h>
+#include <fly/compute_engine/vulkan/vulkan_command_context.h>
+#include <fly/compute_engine/vulkan/vulkan_pipeline_cache_entry.h>
+#include <fly/compute_engine/vulkan/vulkan_queue.h>
+#include <fly/compute_engine/vulkan/vulkan_semaphore.h>
+#include <fly/compute_engine/vulkan/vulkan_utility.h>
+#include "fly/fly_types.h"
+
+namespace fly
+{
+
+// Dispatches and buffer transfers issued to the same queue are recorded into single command buffer, which is submitted once. Pipeline
+// barrier is inserted only in front of command which accesses buffer range written or read by earlier commands recorded since the last
+// barrier. First command of each batch is always preceded by barrier, since earlier batches on the same queue may still be running.
+// Downloads are finished by copying data from staging memory to their destinations once batch completes.
+class VulkanCommandBatch
+{
+public:
+    static const size_t maximumCommandCount = 64;
+
+    // Constructor
+    explicit VulkanCommandBatch(std::unique_ptr<VulkanCommandContext> context, const uint64_t id, const QueueId queue) :
+        context(std::move(context)),
+        id(id),
+        queue(queue),
+        commandCount(0),
+        submitted(false)
+    {}
+
+    // Core methods
+    void recordCopy(VkBuffer source, const VkDeviceSize sourceOffset, VkBuffer destination, const VkDeviceSize destinationOffset,
+        const VkDeviceSize size)
+    {
+        beginCommand({BufferRange{source, sourceOffset, size}}, {BufferRange{destination, destinationOffset, size}});
+
+        const VkBufferCopy copyRegion =
+        {
+            sourceOffset,
+            destinationOffset,
+            size
+        };
+
+        vkCmdCopyBuffer(context->getCommandBuffer(), source, destination, 1, &copyRegion);
+    }
+
+    void recordFill(const VulkanBuffer& buffer, const uint32_t data)
+    {
+        beginCommand({}, {BufferRange{buffer.getBuffer(), 0, buffer.getBufferSize()}});
+        vkCmdFillBuffer(context->getCommandBuffer(), buffer.getBuffer(), 0, VK_WHOLE_SIZE, data);
+    }
+
+    void recordDispatch(std::shared_ptr<VulkanPipelineCacheEntry> pipelineEntry, const size_t descriptorSetIndex,
+        const std::vector<VulkanBuffer*>& arguments, const std::vector<uint8_t>& pushConstantData, const std::vector<size_t>& globalSize,
+        VkQueryPool queryPool, const uint32_t firstQuery)
+    {
+        std::vector<BufferRange> reads;
+        std::vector<BufferRange> writes;
+
+        for (const auto* argument : arguments)
+        {
+            if (argument == nullptr)
+            {
+                continue;
+            }
+
+            const BufferRange range{argument->getBuffer(), 0, argument->getBufferSize()};
+
+            if (argument->getAccessType() != ArgumentAccessType::WriteOnly)
+            {
+                reads.push_back(range);
+            }
+            if (argument->getAccessType() != ArgumentAccessType::ReadOnly)
+            {
+                writes.push_back(range);
+            }
+        }
+
+        beginCommand(reads, writes);
+        pipelineEntry->pipeline->recordDispatchShaderCommand(context->getCommandBuffer(), descriptorSetIndex, pushConstantData, globalSize,
+            queryPool, firstQuery);
+        pipelineEntry->pipeline->acquireDescriptorSet(descriptorSetIndex);
+        descriptorSetUses.push_back(std::make_pair(pipelineEntry, descriptorSetIndex));
+    }
+
+    void addDownload(const void* source, void* destination, const size_t size)
+    {
+        downloads.push_back(PendingDownload{source, destination, size});
+    }
+
+    void addEvent(const EventId eventId)
+    {
+        events.push_back(eventId);
+    }
+
+    void addStagingBuffer(std::unique_ptr<VulkanBuffer> buffer)
+    {
+        stagingBuffers.push_back(std::move(buffer));
+    }
+
+    void addWaitSemaphores(std::vector<std::unique_ptr<VulkanSemaphore>>& semaphores)
+    {
+        for (auto& semaphore : semaphores)
+        {
+            waitSemaphores.push_back(std::move(semaphore));
+        }
+
+        semaphores.clear();
+    }
+
+    void submit(const VulkanQueue& targetQueue)
+    {
+        std::vector<VkSemaphore> semaphores;
+
+        for (const auto& semaphore : waitSemaphores)
+        {
+            semaphores.push_back(semaphore->getSemaphore());
+        }
+
+        checkVulkanError(vkEndCommandBuffer(context->getCommandBuffer()), "vkEndCommandBuffer");
+        targetQueue.submitSingleCommand(context->getCommandBuffer(), context->getFence().getFence(), semaphores);
+        submitted = true;
+    }
+
+    bool isComplete() const
+    {
+        return context->getFence().isSignaled();
+    }
+
+    void complete()
+    {
+        context->getFence().wait();
+
+        for (const auto& download : downloads)
+        {
+            std::memcpy(download.destination, download.source, download.size);
+        }
+
+        for (const auto& use : descriptorSetUses)
+        {
+            use.first->pipeline->releaseDescriptorSet(use.second);
+        }
+
+        downloads.clear();
+        descriptorSetUses.clear();
+    }
+
+    // Context can be reused by another batch once this batch is completed or was never submitted
+    std::unique_ptr<VulkanCommandContext> releaseContext()
+    {
+        return std::move(context);
+    }
+
+    // Getters
+    uint64_t getId() const
+    {
+        return id;
+    }
+
+    QueueId getQueue() const
+    {
+        return queue;
+    }
+
+    bool isEmpty() const
+    {
+        return commandCount == 0;
+    }
+
+    bool isFull() const
+    {
+        return commandCount >= maximumCommandCount;
+    }
+
+    bool isSubmitted() const
+    {
+        return submitted;
+    }
+
+    const std::vector<EventId>& getEvents() const
+    {
+        return events;
+    }
+
+private:
+    struct BufferRange
+    {
+        VkBuffer buffer;
+        VkDeviceSize offset;
+        VkDeviceSize size;
+    };
+
+    struct PendingDownload
+    {
+        const void* source;
+        void* destination;
+        size_t size;
+    };
+
+    // Attributes
+    std::unique_ptr<VulkanCommandContext> context;
+    uint64_t id;
+    QueueId queue;
+    size_t commandCount;
+    bool submitted;
+    std::vector<BufferRange> readRanges;
+    std::vector<BufferRange> writtenRanges;
+    std::vector<PendingDownload> downloads;
+    std::vector<EventId> events;
+    std::vector<std::unique_ptr<VulkanBuffer>> stagingBuffers;
+    std::vector<std::pair<std::shared_ptr<VulkanPipelineCacheEntry>, size_t>> descriptorSetUses;
+    std::vector<std::unique_ptr<VulkanSemaphore>> waitSemaphores;
+
+    // Helper methods
+    void beginCommand(const std::vector<BufferRange>& reads, const std::vector<BufferRange>& writes)
+    {
+        VkCommandBuffer command = context->getCommandBuffer();
+
+        // Submissions to the same queue may overlap, accesses of earlier batches are ordered by barrier in front of the first command
+        bool dependent = commandCount == 0;
+
+        if (commandCount == 0)
+        {
+            const VkCommandBufferBeginInfo commandBufferBeginInfo =
+            {
+                VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+                nullptr,
+                VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+                nullptr
+            };
+
+            checkVulkanError(vkBeginCommandBuffer(command, &commandBufferBeginInfo), "vkBeginCommandBuffer");
+        }
+
+        for (const auto& range : reads)
+        {
+            dependent = dependent || overlaps(writtenRanges, range);
+        }
+        for (const auto& range : writes)
+        {
+            dependent = dependent || overlaps(writtenRanges, range) || overlaps(readRanges, range);
+        }
+
+        if (dependent)
+        {
+            const VkAccessFlags accessFlags = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_READ_BIT
+                | VK_ACCESS_TRANSFER_WRITE_BIT;
+            const VkPipelineStageFlags stageFlags = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
+
+            const VkMemoryBarrier memoryBarrier =
+            {
+                VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+                nullptr,
+                VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
+                accessFlags
+            };
+
+            vkCmdPipelineBarrier(command, stageFlags, stageFlags, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+            readRanges.clear();
+            writtenRanges.clear();
+        }
+
+        readRanges.insert(readRanges.end(), reads.begin(), reads.end());
+        writtenRanges.insert(writtenRanges.end(), writes.begin(), writes.end());
+        ++commandCount;
+    }
+
+    static bool overlaps(const std::vector<BufferRange>& ranges, const BufferRange& range)
+    {
+        for (const auto& other : ranges)
+        {
+            if (other.buffer == range.buffer && other.offset < range.offset + range.size && range.offset < other.offset + other.size)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+};
+
+} // namespace fly
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <fly/compute_engine/vulkan/vulkan_command_buffer_holder.h>
+#include <fly/compute_engine/vulkan/vulkan_command_pool.h>
+#include <fly/compute_engine/vulkan/vulkan_fence.h>
+#include <fly/compute_engine/vulkan/vulkan_utility.h>
+
+namespace fly
+{
+
+// Command pool, command buffer and fence used by single command batch. Context is reset and reused once its batch completes, so that
+// steady-state submission does not create any Vulkan objects.
+class VulkanCommandContext
+{
+public:
+    explicit VulkanCommandContext(VkDevice device, const uint32_t queueFamilyIndex) :
+        commandPool(device, queueFamilyIndex, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT),
+        commandBuffer(device, commandPool.getCommandPool()),
+        fence(device)
+    {}
+
+    void reset()
+    {
+        checkVulkanError(vkResetCommandPool(commandPool.getDevice(), commandPool.getCommandPool(), 0), "vkResetCommandPool");
+        fence.reset();
+    }
+
+    VkCommandBuffer getCommandBuffer() const
+    {
+        return commandBuffer.getCommandBuffer();
+    }
+
+    VulkanFence& getFence()
+    {
+        return fence;
+    }
+
+    const VulkanFence& getFence() const
+    {
+        return fence;
+    }
+
+private:
+    VulkanCommandPool commandPool;
+    VulkanCommandBufferHolder commandBuffer;
+    VulkanFence fence;
+};
+
+} // namespace fly
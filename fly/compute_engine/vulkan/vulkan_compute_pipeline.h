@@ -1,11 +1,16 @@
 #pragma once
 
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 #include <vulkan/vulkan.h>
 #include <fly/compute_engine/vulkan/vulkan_buffer.h>
 #include <fly/compute_engine/vulkan/vulkan_descriptor_pool.h>
 #include <fly/compute_engine/vulkan/vulkan_descriptor_set_holder.h>
+#include <fly/compute_engine/vulkan/vulkan_shader_interface.h>
 #include <fly/compute_engine/vulkan/vulkan_utility.h>
 
 namespace fly
@@ -14,24 +19,49 @@ namespace fly
 class VulkanComputePipeline
 {
 public:
+    static const uint32_t setsPerDescriptorPool = 8;
+
     VulkanComputePipeline() :
         device(nullptr),
         pipeline(nullptr),
         pipelineLayout(nullptr),
         descriptorSetLayout(nullptr),
         shaderName(""),
-        descriptorPool(nullptr),
-        descriptorSets(nullptr)
+        pushConstantsSize(0)
     {}
 
     explicit VulkanComputePipeline(VkDevice device, VkDescriptorSetLayout descriptorSetLayout, VkShaderModule shader,
         const std::string& shaderName) :
+        VulkanComputePipeline(device, descriptorSetLayout, shader, shaderName, nullptr)
+    {}
+
+    explicit VulkanComputePipeline(VkDevice device, VkDescriptorSetLayout descriptorSetLayout, VkShaderModule shader,
+        const std::string& shaderName, VkPipelineCache pipelineCache) :
+        VulkanComputePipeline(device, descriptorSetLayout, shader, shaderName, pipelineCache, nullptr)
+    {}
+
+    explicit VulkanComputePipeline(VkDevice device, VkDescriptorSetLayout descriptorSetLayout, VkShaderModule shader,
+        const std::string& shaderName, VkPipelineCache pipelineCache, const VkSpecializationInfo* specializationInfo) :
+        VulkanComputePipeline(device, descriptorSetLayout, shader, shaderName, pipelineCache, specializationInfo, VulkanShaderInterface(), 0)
+    {}
+
+    // Push constant range covers pushConstantsSize bytes, it is only created when the shader declares push constant block
+    explicit VulkanComputePipeline(VkDevice device, VkDescriptorSetLayout descriptorSetLayout, VkShaderModule shader,
+        const std::string& shaderName, VkPipelineCache pipelineCache, const VkSpecializationInfo* specializationInfo,
+        const VulkanShaderInterface& shaderInterface, const uint32_t pushConstantsSize) :
         device(device),
         descriptorSetLayout(descriptorSetLayout),
         shaderName(shaderName),
-        descriptorPool(nullptr),
-        descriptorSets(nullptr)
+        shaderInterface(shaderInterface),
+        pushConstantsSize(shaderInterface.hasPushConstantBlock() ? pushConstantsSize : 0)
     {
+        const VkPushConstantRange pushConstantRange =
+        {
+            VK_SHADER_STAGE_COMPUTE_BIT,
+            0,
+            this->pushConstantsSize
+        };
+
         const VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo =
         {
             VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
@@ -39,8 +69,8 @@ public:
             0,
             1,
             &descriptorSetLayout,
-            0,
-            nullptr
+            this->pushConstantsSize > 0 ? 1u : 0u,
+            &pushConstantRange
         };
 
         checkVulkanError(vkCreatePipelineLayout(device, &pipelineLayoutCreateInfo, nullptr, &pipelineLayout), "vkCreatePipelineLayout");
@@ -53,7 +83,7 @@ public:
             VK_SHADER_STAGE_COMPUTE_BIT,
             shader,
             shaderName.c_str(),
-            nullptr
+            specializationInfo
         };
 
         const VkComputePipelineCreateInfo pipelineCreateInfo =
@@ -67,7 +97,7 @@ public:
             0
         };
 
-        checkVulkanError(vkCreateComputePipelines(device, nullptr, 1, &pipelineCreateInfo, nullptr, &pipeline), "vkCreateComputePipelines");
+        checkVulkanError(vkCreateComputePipelines(device, pipelineCache, 1, &pipelineCreateInfo, nullptr, &pipeline), "vkCreateComputePipelines");
     }
 
     ~VulkanComputePipeline()
@@ -99,59 +129,174 @@ public:
         return shaderName;
     }
 
-    void bindArguments(const std::vector<VulkanBuffer*>& buffers)
+    const VulkanShaderInterface& getShaderInterface() const
+    {
+        return shaderInterface;
+    }
+
+    uint32_t getPushConstantsSize() const
     {
-        const uint32_t descriptorCount = static_cast<uint32_t>(buffers.size());
+        return pushConstantsSize;
+    }
+
+    // Returns index of descriptor set which binds given buffers. Set with identical bindings is shared between dispatches, otherwise only
+    // changed bindings of set which is not used by any pending dispatch are rewritten. New set is allocated only when all sets are in use.
+    // Buffers are indexed by kernel argument, shader binding number selects the argument, scalar arguments are represented by null.
+    // Bindings are compared by buffer serial number, handle of destroyed buffer may be reused by a different buffer.
+    size_t bindArguments(const std::vector<VulkanBuffer*>& buffers)
+    {
+        const std::vector<VulkanShaderBinding>& shaderBindings = shaderInterface.getBindings();
+        std::vector<std::pair<uint64_t, VkDeviceSize>> bindings;
+
+        for (const auto& shaderBinding : shaderBindings)
+        {
+            if (shaderBinding.binding >= buffers.size() || buffers[shaderBinding.binding] == nullptr)
+            {
+                throw std::runtime_error(std::string("Binding ") + std::to_string(shaderBinding.binding) + " of shader " + shaderName
+                    + " does not correspond to vector argument");
+            }
+
+            const VulkanBuffer& buffer = *buffers[shaderBinding.binding];
+
+            if (shaderBinding.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER
+                && (buffer.getUsageFlags() & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT) == 0)
+            {
+                throw std::runtime_error(std::string("Argument bound to uniform block ") + std::to_string(shaderBinding.binding) + " of shader "
+                    + shaderName + " has to be read-only and must not exceed maximum uniform buffer range");
+            }
+
+            bindings.push_back(std::make_pair(buffer.getSerialNumber(), buffer.getBufferSize()));
+        }
+
+        for (size_t i = 0; i < descriptorSets.size(); ++i)
+        {
+            if (descriptorSets[i].bindings == bindings)
+            {
+                return i;
+            }
+        }
+
+        size_t index = descriptorSets.size();
+
+        for (size_t i = 0; i < descriptorSets.size(); ++i)
+        {
+            if (descriptorSets[i].useCount == 0)
+            {
+                index = i;
+                break;
+            }
+        }
 
-        if (descriptorPool == nullptr || descriptorPool->getDescriptorCount() != descriptorCount)
+        if (index == descriptorSets.size())
         {
-            descriptorSets.reset(nullptr);
-            descriptorPool.reset(nullptr);
-            descriptorPool = MakeStdUnique<VulkanDescriptorPool>(device, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, descriptorCount);
-            descriptorSets = MakeStdUnique<VulkanDescriptorSetHolder>(device, descriptorPool->getDescriptorPool(), descriptorSetLayout);
+            allocateDescriptorSet();
         }
 
-        for (size_t i = 0; i < buffers.size(); ++i)
+        DescriptorSetEntry& descriptorSet = descriptorSets[index];
+
+        for (size_t i = 0; i < bindings.size(); ++i)
         {
-            descriptorSets->bindBuffer(*buffers[i], VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 0, static_cast<uint32_t>(i));
+            if (descriptorSet.bindings[i] != bindings[i])
+            {
+                const VulkanShaderBinding& shaderBinding = shaderBindings[i];
+                descriptorSet.holder->bindBuffer(*buffers[shaderBinding.binding], shaderBinding.descriptorType, 0, shaderBinding.binding);
+                descriptorSet.bindings[i] = bindings[i];
+            }
         }
+
+        return index;
     }
 
-    void recordDispatchShaderCommand(VkCommandBuffer commandBuffer, const std::vector<size_t>& globalSize, VkQueryPool queryPool)
+    // Descriptor set cannot be rewritten while it is used by recorded or running dispatch
+    void acquireDescriptorSet(const size_t index)
     {
-        const VkCommandBufferBeginInfo commandBufferBeginInfo =
-        {
-            VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
-            nullptr,
-            VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
-            nullptr
-        };
+        ++descriptorSets.at(index).useCount;
+    }
 
-        std::vector<VkDescriptorSet> sets = descriptorSets->getDescriptorSets();
+    void releaseDescriptorSet(const size_t index)
+    {
+        --descriptorSets.at(index).useCount;
+    }
 
-        checkVulkanError(vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo), "vkBeginCommandBuffer");
+    // Command buffer has to be in recording state, so that multiple dispatches can be recorded into it. Push constant data is copied into
+    // command buffer during recording, scalar arguments can therefore change before the next dispatch without any buffer transfer.
+    void recordDispatchShaderCommand(VkCommandBuffer commandBuffer, const size_t descriptorSetIndex, const std::vector<uint8_t>& pushConstantData,
+        const std::vector<size_t>& globalSize, VkQueryPool queryPool, const uint32_t firstQuery)
+    {
+        std::vector<VkDescriptorSet> sets = descriptorSets.at(descriptorSetIndex).holder->getDescriptorSets();
 
         vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
         vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, static_cast<uint32_t>(sets.size()), sets.data(), 0,
             nullptr);
 
-        vkCmdResetQueryPool(commandBuffer, queryPool, 0, 2);
-        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, queryPool, 0);
+        if (!pushConstantData.empty())
+        {
+            vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, static_cast<uint32_t>(pushConstantData.size()),
+                pushConstantData.data());
+        }
+
+        vkCmdResetQueryPool(commandBuffer, queryPool, firstQuery, 2);
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, queryPool, firstQuery);
         vkCmdDispatch(commandBuffer, static_cast<uint32_t>(globalSize[0]), static_cast<uint32_t>(globalSize[1]),
             static_cast<uint32_t>(globalSize[2]));
-        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, queryPool, 1);
-
-        checkVulkanError(vkEndCommandBuffer(commandBuffer), "vkEndCommandBuffer");
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, queryPool, firstQuery + 1);
     }
 
 private:
+    struct DescriptorSetEntry
+    {
+        std::unique_ptr<VulkanDescriptorSetHolder> holder;
+        std::vector<std::pair<uint64_t, VkDeviceSize>> bindings;
+        uint32_t useCount;
+    };
+
     VkDevice device;
     VkPipeline pipeline;
     VkPipelineLayout pipelineLayout;
     VkDescriptorSetLayout descriptorSetLayout;
     std::string shaderName;
-    std::unique_ptr<VulkanDescriptorPool> descriptorPool;
-    std::unique_ptr<VulkanDescriptorSetHolder> descriptorSets;
+    VulkanShaderInterface shaderInterface;
+    uint32_t pushConstantsSize;
+    std::vector<std::unique_ptr<VulkanDescriptorPool>> descriptorPools;
+    std::vector<DescriptorSetEntry> descriptorSets;
+
+    void allocateDescriptorSet()
+    {
+        if (descriptorSets.size() == descriptorPools.size() * setsPerDescriptorPool)
+        {
+            uint32_t storageBufferCount = 0;
+            uint32_t uniformBufferCount = 0;
+
+            for (const auto& shaderBinding : shaderInterface.getBindings())
+            {
+                if (shaderBinding.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+                {
+                    ++uniformBufferCount;
+                }
+                else
+                {
+                    ++storageBufferCount;
+                }
+            }
+
+            // Pool has to contain at least one descriptor, even if the shader does not use any buffers
+            std::vector<VkDescriptorPoolSize> poolSizes;
+            poolSizes.push_back(VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, std::max(storageBufferCount, 1u) * setsPerDescriptorPool});
+
+            if (uniformBufferCount > 0)
+            {
+                poolSizes.push_back(VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, uniformBufferCount * setsPerDescriptorPool});
+            }
+
+            descriptorPools.push_back(MakeStdUnique<VulkanDescriptorPool>(device, poolSizes, setsPerDescriptorPool));
+        }
+
+        DescriptorSetEntry descriptorSet;
+        descriptorSet.holder = MakeStdUnique<VulkanDescriptorSetHolder>(device, descriptorPools.back()->getDescriptorPool(), descriptorSetLayout);
+        descriptorSet.bindings.assign(shaderInterface.getBindings().size(), std::make_pair(uint64_t(0), VkDeviceSize(0)));
+        descriptorSet.useCount = 0;
+        descriptorSets.push_back(std::move(descriptorSet));
+    }
 };
 
 } // namespace fly
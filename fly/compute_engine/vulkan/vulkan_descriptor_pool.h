@@ -1,5 +1,6 @@
 #pragma once
 
+#include <vector>
 #include <vulkan/vulkan.h>
 #include <fly/compute_engine/vulkan/vulkan_utility.h>
 
@@ -10,23 +11,31 @@ class VulkanDescriptorPool
 {
 public:
     explicit VulkanDescriptorPool(VkDevice device, const VkDescriptorType descriptorType, const uint32_t descriptorCount) :
+        VulkanDescriptorPool(device, descriptorType, descriptorCount, descriptorCount)
+    {}
+
+    explicit VulkanDescriptorPool(VkDevice device, const VkDescriptorType descriptorType, const uint32_t descriptorCount,
+        const uint32_t maxSetCount) :
+        VulkanDescriptorPool(device, std::vector<VkDescriptorPoolSize>{VkDescriptorPoolSize{descriptorType, descriptorCount}}, maxSetCount)
+    {}
+
+    explicit VulkanDescriptorPool(VkDevice device, const std::vector<VkDescriptorPoolSize>& poolSizes, const uint32_t maxSetCount) :
         device(device),
-        descriptorCount(descriptorCount)
+        descriptorCount(0)
     {
-        const VkDescriptorPoolSize poolSize =
+        for (const auto& poolSize : poolSizes)
         {
-            descriptorType,
-            descriptorCount
-        };
+            descriptorCount += poolSize.descriptorCount;
+        }
 
         const VkDescriptorPoolCreateInfo poolCreateInfo =
         {
             VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
             nullptr,
             0,
-            descriptorCount,
-            1,
-            &poolSize
+            maxSetCount,
+            static_cast<uint32_t>(poolSizes.size()),
+            poolSizes.data()
         };
 
         checkVulkanError(vkCreateDescriptorPool(device, &poolCreateInfo, nullptr, &descriptorPool), "vkCreateDescriptorPool");
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <vector>
 #include <vulkan/vulkan.h>
+#include <fly/compute_engine/vulkan/vulkan_shader_interface.h>
 #include <fly/compute_engine/vulkan/vulkan_utility.h>
 
 namespace fly
@@ -19,26 +21,30 @@ public:
         descriptorType(descriptorType),
         bindingCount(bindingCount)
     {
-        std::vector<VkDescriptorSetLayoutBinding> bindings(bindingCount);
+        std::vector<VulkanShaderBinding> shaderBindings;
         for (uint32_t i = 0; i < bindingCount; ++i)
         {
-            bindings[i].binding = i;
-            bindings[i].descriptorType = descriptorType;
-            bindings[i].descriptorCount = 1;
-            bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
-            bindings[i].pImmutableSamplers = nullptr;
+            shaderBindings.push_back(VulkanShaderBinding{i, descriptorType});
         }
 
-        const VkDescriptorSetLayoutCreateInfo layoutCreateInfo =
+        createDescriptorSetLayout(shaderBindings);
+    }
+
+    // Layout with bindings declared by shader, descriptor type is VK_DESCRIPTOR_TYPE_MAX_ENUM if bindings use different types
+    explicit VulkanDescriptorSetLayout(VkDevice device, const std::vector<VulkanShaderBinding>& shaderBindings) :
+        device(device),
+        descriptorType(shaderBindings.empty() ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : shaderBindings[0].descriptorType),
+        bindingCount(static_cast<uint32_t>(shaderBindings.size()))
+    {
+        for (const auto& shaderBinding : shaderBindings)
         {
-            VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
-            nullptr,
-            0,
-            bindingCount,
-            bindings.data()
-        };
+            if (shaderBinding.descriptorType != descriptorType)
+            {
+                descriptorType = VK_DESCRIPTOR_TYPE_MAX_ENUM;
+            }
+        }
 
-        checkVulkanError(vkCreateDescriptorSetLayout(device, &layoutCreateInfo, nullptr, &descriptorSetLayout), "vkCreateDescriptorSetLayout");
+        createDescriptorSetLayout(shaderBindings);
     }
 
     ~VulkanDescriptorSetLayout()
@@ -74,6 +80,30 @@ private:
     VkDescriptorSetLayout descriptorSetLayout;
     VkDescriptorType descriptorType;
     uint32_t bindingCount;
+
+    void createDescriptorSetLayout(const std::vector<VulkanShaderBinding>& shaderBindings)
+    {
+        std::vector<VkDescriptorSetLayoutBinding> bindings(shaderBindings.size());
+        for (size_t i = 0; i < shaderBindings.size(); ++i)
+        {
+            bindings[i].binding = shaderBindings[i].binding;
+            bindings[i].descriptorType = shaderBindings[i].descriptorType;
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+            bindings[i].pImmutableSamplers = nullptr;
+        }
+
+        const VkDescriptorSetLayoutCreateInfo layoutCreateInfo =
+        {
+            VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+            nullptr,
+            0,
+            static_cast<uint32_t>(bindings.size()),
+            bindings.data()
+        };
+
+        checkVulkanError(vkCreateDescriptorSetLayout(device, &layoutCreateInfo, nullptr, &descriptorSetLayout), "vkCreateDescriptorSetLayout");
+    }
 };
 
 } // namespace fly
@@ -1,5 +1,7 @@
 #ifdef FLY_PLATFORM_VULKAN
 
+#include <algorithm>
+#include <cstring>
 #include <limits>
 #include <fly/compute_engine/vulkan/vulkan_engine.h>
 #include <fly/utility/fly_utility.h>
@@ -16,9 +18,11 @@ VulkanEngine::VulkanEngine(const DeviceIndex deviceIndex, const uint32_t queueCo
     globalSizeType(GlobalSizeType::Vulkan),
     globalSizeCorrection(false),
     kernelCacheFlag(true),
-    kernelCacheCapacity(10),
     persistentBufferFlag(true),
-    nextEventId(0)
+    nextEventId(0),
+    pipelineCache(10),
+    shaderCache(10),
+    nextCommandBatchId(0)
 {
     std::vector<const char*> instanceExtensions;
     std::vector<const char*> validationLayers;
@@ -42,11 +46,42 @@ VulkanEngine::VulkanEngine(const DeviceIndex deviceIndex, const uint32_t queueCo
     device = MakeStdUnique<VulkanDevice>(devices.at(deviceIndex), queueCount, VK_QUEUE_COMPUTE_BIT, std::vector<const char*>{}, validationLayers);
     queues = device->getQueues();
 
-    Logger::logDebug("Initializing Vulkan command pool");
-    commandPool = MakeStdUnique<VulkanCommandPool>(device->getDevice(), device->getQueueFamilyIndex());
+    Logger::logDebug("Initializing Vulkan memory allocator");
+    memoryAllocator = MakeStdUnique<VulkanMemoryAllocator>(device->getDevice(), device->getPhysicalDevice());
+    stagingRing = MakeStdUnique<VulkanStagingRing>(device->getDevice(), device->getPhysicalDevice(), *memoryAllocator);
 
     Logger::logDebug("Initializing Vulkan query pool");
     queryPool = MakeStdUnique<VulkanQueryPool>(device->getDevice(), devices.at(deviceIndex).getProperties().limits.timestampPeriod);
+
+    // Pipeline cache data is only reusable with the same device and driver
+    const VkPhysicalDeviceProperties properties = devices.at(deviceIndex).getProperties();
+    std::string deviceDescriptor = std::string(properties.deviceName) + "|" + std::to_string(properties.vendorID) + "|"
+        + std::to_string(properties.deviceID) + "|" + std::to_string(properties.driverVersion) + "|";
+    deviceDescriptor.append(reinterpret_cast<const char*>(properties.pipelineCacheUUID), VK_UUID_SIZE);
+    pipelineCacheKey = KernelFingerprint::compute("VkPipelineCache", deviceDescriptor, "", 0);
+    driverPipelineCache = MakeStdUnique<VulkanPipelineCache>(device->getDevice(), properties, std::vector<uint8_t>{});
+}
+
+VulkanEngine::~VulkanEngine()
+{
+    try
+    {
+        // Command batches in flight own command buffers and fences which cannot be destroyed before they complete
+        synchronizeDevice();
+    }
+    catch (const std::runtime_error& error)
+    {
+        Logger::getLogger().log(LoggingLevel::Warning, std::string("Unable to finish pending Vulkan transfers: ") + error.what());
+    }
+
+    try
+    {
+        storePipelineCacheData();
+    }
+    catch (const std::runtime_error& error)
+    {
+        Logger::getLogger().log(LoggingLevel::Warning, std::string("Unable to store Vulkan pipeline cache: ") + error.what());
+    }
 }
 
 KernelResult VulkanEngine::runKernel(const KernelRuntimeData& kernelData, const std::vector<KernelArgument*>& argumentPointers,
@@ -62,50 +97,24 @@ EventId VulkanEngine::runKernelAsync(const KernelRuntimeData& kernelData, const
     Timer overheadTimer;
     overheadTimer.start();
 
-    VulkanComputePipeline* pipeline;
-    std::unique_ptr<VulkanComputePipeline> pipelineUnique;
-    std::unique_ptr<VulkanDescriptorSetLayout> layout;
-    std::unique_ptr<VulkanShaderModule> shader;
-    const uint32_t bindingCount = static_cast<uint32_t>(kernelData.getArgumentIds().size());
+    // Entry is held until the pipeline is recorded, command batch then keeps it alive until the dispatch completes. Shader compilation
+    // and pipeline creation happen before the engine is locked, only descriptor binding and recording need the lock.
+    std::shared_ptr<VulkanPipelineCacheEntry> pipelineEntry = loadPipeline(kernelData);
+    std::lock_guard<std::recursive_mutex> lock(mutex);
 
-    if (kernelCacheFlag)
-    {
-        if (pipelineCache.find(std::make_pair(kernelData.getName(), kernelData.getSource())) == pipelineCache.end())
-        {
-            if (pipelineCache.size() >= kernelCacheCapacity)
-            {
-                clearKernelCache();
-            }
-            auto cacheLayout = MakeStdUnique<VulkanDescriptorSetLayout>(device->getDevice(), VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, bindingCount);
-            auto cacheShader = MakeStdUnique<VulkanShaderModule>(device->getDevice(), kernelData.getName(), kernelData.getUnmodifiedSource(),
-                kernelData.getLocalSize(), kernelData.getParameterPairs());
-            auto cachePipeline = MakeStdUnique<VulkanComputePipeline>(device->getDevice(), cacheLayout->getDescriptorSetLayout(),
-                cacheShader->getShaderModule(), kernelData.getName());
-            auto cacheEntry = MakeStdUnique<VulkanPipelineCacheEntry>(std::move(cachePipeline), std::move(cacheLayout), std::move(cacheShader));
-            pipelineCache.insert(std::make_pair(std::make_pair(kernelData.getName(), kernelData.getSource()), std::move(cacheEntry)));
-        }
-        auto cachePointer = pipelineCache.find(std::make_pair(kernelData.getName(), kernelData.getSource()));
-        pipeline = cachePointer->second->pipeline.get();
-    }
-    else
-    {
-        layout = MakeStdUnique<VulkanDescriptorSetLayout>(device->getDevice(), VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, bindingCount);
-        shader = MakeStdUnique<VulkanShaderModule>(device->getDevice(), kernelData.getName(), kernelData.getUnmodifiedSource(),
-            kernelData.getLocalSize(), kernelData.getParameterPairs());
-        pipelineUnique = MakeStdUnique<VulkanComputePipeline>(device->getDevice(), layout->getDescriptorSetLayout(), shader->getShaderModule(),
-            kernelData.getName());
-        pipeline = pipelineUnique.get();
-    }
-
-    std::vector<VulkanBuffer*> pipelineArguments = getPipelineArguments(argumentPointers);
-    pipeline->bindArguments(pipelineArguments);
+    residencyManager.beginLaunch(argumentPointers);
+    std::vector<uint8_t> pushConstantData;
+    std::vector<VulkanBuffer*> pipelineArguments = getPipelineArguments(argumentPointers, *pipelineEntry->pipeline, pushConstantData);
+    const size_t descriptorSetIndex = pipelineEntry->pipeline->bindArguments(pipelineArguments);
     overheadTimer.stop();
 
-    return enqueuePipeline(*pipeline, kernelData.getGlobalSize(), kernelData.getLocalSize(), queue, overheadTimer.getElapsedTime());
+    return enqueuePipeline(pipelineEntry, descriptorSetIndex, pipelineArguments, pushConstantData, kernelData.getGlobalSize(),
+        kernelData.getLocalSize(), queue, overheadTimer.getElapsedTime());
 }
 
 KernelResult VulkanEngine::getKernelResult(const EventId id, const std::vector<OutputDescriptor>& outputDescriptors) const
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     KernelResult result = createKernelResult(id);
 
     for (const auto& descriptor : outputDescriptors)
@@ -116,36 +125,85 @@ KernelResult VulkanEngine::getKernelResult(const EventId id, const std::vector<O
     return result;
 }
 
+void VulkanEngine::compileKernel(const KernelRuntimeData& kernelData)
+{
+    loadPipeline(kernelData);
+}
+
+void VulkanEngine::prepareKernel(const LaunchId id, const KernelRuntimeData& kernelData)
+{
+    std::shared_ptr<VulkanPipelineCacheEntry> pipelineEntry = loadPipeline(kernelData);
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    preparedPipelines[id] = MakeStdUnique<VulkanPreparedPipeline>(pipelineEntry, kernelData.getGlobalSize(), kernelData.getLocalSize());
+}
+
+EventId VulkanEngine::runPreparedKernelAsync(const LaunchId id, const std::vector<KernelArgument*>& argumentPointers, const QueueId queue)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    Timer overheadTimer;
+    overheadTimer.start();
+
+    auto preparedPointer = preparedPipelines.find(id);
+    if (preparedPointer == preparedPipelines.end())
+    {
+        throw std::runtime_error(std::string("Prepared kernel launch with following id does not exist: ") + std::to_string(id));
+    }
+
+    const VulkanPreparedPipeline& preparedPipeline = *preparedPointer->second;
+
+    residencyManager.beginLaunch(argumentPointers);
+    std::vector<uint8_t> pushConstantData;
+    std::vector<VulkanBuffer*> pipelineArguments = getPipelineArguments(argumentPointers, *preparedPipeline.pipelineEntry->pipeline,
+        pushConstantData);
+    const size_t descriptorSetIndex = preparedPipeline.pipelineEntry->pipeline->bindArguments(pipelineArguments);
+    overheadTimer.stop();
+
+    return enqueuePipeline(preparedPipeline.pipelineEntry, descriptorSetIndex, pipelineArguments, pushConstantData, preparedPipeline.globalSize,
+        preparedPipeline.localSize, queue, overheadTimer.getElapsedTime());
+}
+
+void VulkanEngine::releasePreparedKernel(const LaunchId id)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    preparedPipelines.erase(id);
+}
+
 uint64_t VulkanEngine::getKernelOverhead(const EventId id) const
 {
-    auto eventPointer = kernelEvents.find(id);
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    const std::unique_ptr<VulkanEvent>* event = kernelEvents.find(id);
 
-    if (eventPointer == kernelEvents.end())
+    if (event == nullptr)
     {
         throw std::runtime_error(std::string("Kernel event with following id does not exist or its result was already retrieved: ")
             + std::to_string(id));
     }
 
-    return eventPointer->second->getOverhead();
+    return (*event)->getOverhead();
 }
 
 void VulkanEngine::setCompilerOptions(const std::string& options)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     compilerOptions = options;
 }
 
 void VulkanEngine::setGlobalSizeType(const GlobalSizeType type)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     globalSizeType = type;
 }
 
 void VulkanEngine::setAutomaticGlobalSizeCorrection(const bool flag)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     globalSizeCorrection = flag;
 }
 
 void VulkanEngine::setKernelCacheUsage(const bool flag)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
     if (!flag)
     {
         clearKernelCache();
@@ -155,12 +213,38 @@ void VulkanEngine::setKernelCacheUsage(const bool flag)
 
 void VulkanEngine::setKernelCacheCapacity(const size_t capacity)
 {
-    kernelCacheCapacity = capacity;
+    pipelineCache.setCapacity(capacity);
+}
+
+void VulkanEngine::setKernelCacheByteBudget(const size_t budget)
+{
+    pipelineCache.setByteBudget(budget);
+}
+
+void VulkanEngine::setKernelCacheEvictionPolicy(const KernelCacheEvictionPolicy policy)
+{
+    pipelineCache.setEvictionPolicy(policy);
+}
+
+KernelCacheStatistics VulkanEngine::getKernelCacheStatistics() const
+{
+    return pipelineCache.getStatistics();
+}
+
+void VulkanEngine::setPersistentKernelCache(const std::string& directory, const size_t maxSizeInBytes)
+{
+    storePipelineCacheData();
+    diskCache.setDirectory(directory, maxSizeInBytes);
+
+    std::vector<uint8_t> pipelineCacheData;
+    diskCache.load(pipelineCacheKey, pipelineCacheData);
+    driverPipelineCache = MakeStdUnique<VulkanPipelineCache>(device->getDevice(), device->getPhysicalDevice().getProperties(), pipelineCacheData);
 }
 
 void VulkanEngine::clearKernelCache()
 {
     pipelineCache.clear();
+    shaderCache.clear();
 }
 
 QueueId VulkanEngine::getDefaultQueue() const
@@ -182,25 +266,78 @@ std::vector<QueueId> VulkanEngine::getAllQueues() const
 
 void VulkanEngine::synchronizeQueue(const QueueId queue)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
     if (queue >= queues.size())
     {
         throw std::runtime_error(std::string("Invalid queue index: ") + std::to_string(queue));
     }
 
+    flushCommandBatch(queue);
     queues[queue].waitIdle();
+    retireQueueCommandBatches(queue);
 }
 
 void VulkanEngine::synchronizeDevice()
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    flushCommandBatches();
     device->waitIdle();
+
+    while (!submittedCommandBatches.empty())
+    {
+        retireCommandBatch(submittedCommandBatches.begin()->first);
+    }
 }
 
 void VulkanEngine::clearEvents()
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
+    // Pending downloads still have to reach their destinations and staging ranges have to be reclaimed. Wait semaphores which were not
+    // consumed by any batch may still have pending signal operations, so the device has to be idle before they are destroyed.
+    synchronizeDevice();
+
+    kernelEvents.forEach([this](const EventId, const std::unique_ptr<VulkanEvent>& event)
+    {
+        queryPool->releaseSlot(event->getQuerySlot());
+    });
+
     kernelEvents.clear();
     bufferEvents.clear();
-    eventCommands.clear();
-    stagingBuffers.clear();
+    kernelEventQueues.clear();
+    pendingWaitSemaphores.clear();
+}
+
+void VulkanEngine::enqueueEventWait(const QueueId queue, const EventId id)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
+    if (queue >= queues.size())
+    {
+        throw std::runtime_error(std::string("Invalid queue index: ") + std::to_string(queue));
+    }
+
+    const QueueId* eventQueue = kernelEventQueues.find(id);
+
+    if (eventQueue == nullptr)
+    {
+        throw std::runtime_error(std::string("Kernel event with following id does not exist or its result was already retrieved: ")
+            + std::to_string(id));
+    }
+
+    // Semaphore can only be signaled after the kernel is submitted
+    const uint64_t* batchId = commandBatchEvents.find(id);
+
+    if (batchId != nullptr)
+    {
+        submitCommandBatch(*batchId);
+    }
+
+    // Submissions to the same queue may overlap, so semaphore is used even if both commands run on the same queue
+    auto semaphore = MakeStdUnique<VulkanSemaphore>(device->getDevice());
+    queues[*eventQueue].signalSemaphore(semaphore->getSemaphore());
+    pendingWaitSemaphores[queue].push_back(std::move(semaphore));
 }
 
 uint64_t VulkanEngine::uploadArgument(KernelArgument& kernelArgument)
@@ -216,6 +353,8 @@ uint64_t VulkanEngine::uploadArgument(KernelArgument& kernelArgument)
 
 EventId VulkanEngine::uploadArgumentAsync(KernelArgument& kernelArgument, const QueueId queue)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
     if (kernelArgument.getMemoryLocation() == ArgumentMemoryLocation::HostZeroCopy)
     {
         throw std::runtime_error("Host zero-copy arguments are not supported yet for Vulkan backend");
@@ -236,48 +375,126 @@ EventId VulkanEngine::uploadArgumentAsync(KernelArgument& kernelArgument, const
         return 0;
     }
 
-    EventId eventId = nextEventId;
-    Logger::logDebug("Uploading buffer for argument " + std::to_string(kernelArgument.getId()) + ", event id: " + std::to_string(eventId));
+    // Spilled contents are copied into staging memory during the upload, so they can be released once this method returns
+    std::unique_ptr<KernelArgument> spilledArgument = residencyManager.takeSpilledArgument(kernelArgument.getId());
+    KernelArgument& uploadedArgument = spilledArgument != nullptr ? *spilledArgument : kernelArgument;
+
+    reserveBufferMemory(uploadedArgument.getDataSizeInBytes());
+    residencyManager.addBuffer(uploadedArgument.getId(), uploadedArgument.getDataSizeInBytes(), uploadedArgument.getAccessType());
+
+    const EventId eventId = nextEventId++;
+    Logger::logDebug("Uploading buffer for argument " + std::to_string(uploadedArgument.getId()) + ", event id: " + std::to_string(eventId));
+    bufferEvents.insert(eventId, createEvent(eventId, false));
 
-    VkBufferUsageFlags hostUsage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-    if (kernelArgument.getMemoryLocation() == ArgumentMemoryLocation::Host)
+    // Contents of output buffers are overwritten by kernel, host data is not transferred unless the buffer is restored from spilled contents.
+    // Fill pattern is applied on device when it can be expressed as 32-bit word, which is required by vkCmdFillBuffer.
+    const bool writeOnly = uploadedArgument.getAccessType() == ArgumentAccessType::WriteOnly && spilledArgument == nullptr;
+    const bool deviceFill = writeOnly && uploadedArgument.hasFillPattern() && uploadedArgument.getFillPatternPeriod() <= sizeof(uint32_t)
+        && uploadedArgument.getDataSizeInBytes() % sizeof(uint32_t) == 0;
+
+    if (uploadedArgument.getMemoryLocation() == ArgumentMemoryLocation::Host)
     {
-        hostUsage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
-        auto bufferEvent = MakeStdUnique<VulkanEvent>(device->getDevice(), eventId, false);
-        bufferEvents.insert(std::make_pair(eventId, std::move(bufferEvent)));
+        auto hostBuffer = MakeStdUnique<VulkanBuffer>(uploadedArgument, device->getDevice(), device->getPhysicalDevice(),
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT | getDescriptorUsage(uploadedArgument));
+
+        // Devices with unified memory can expose device local memory to host, kernels then access host buffers at full speed
+        const VulkanPhysicalDevice& physicalDevice = device->getPhysicalDevice();
+        VkMemoryPropertyFlags hostProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+        if (physicalDevice.findMemoryType(hostBuffer->getMemoryRequirements().memoryTypeBits,
+            VulkanPhysicalDevice::getUnifiedMemoryProperties()) != VK_MAX_MEMORY_TYPES)
+        {
+            hostProperties = VulkanPhysicalDevice::getUnifiedMemoryProperties();
+        }
+
+        hostBuffer->allocateMemory(*memoryAllocator, hostProperties);
+
+        if (writeOnly && uploadedArgument.hasFillPattern())
+        {
+            hostBuffer->fillData(uploadedArgument, uploadedArgument.getDataSizeInBytes());
+        }
+        else if (!writeOnly)
+        {
+            hostBuffer->uploadData(uploadedArgument.getData(), uploadedArgument.getDataSizeInBytes());
+        }
+
+        buffers.insert(std::move(hostBuffer));
+        return eventId;
+    }
+
+    VkBufferUsageFlags deviceUsage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | getDescriptorUsage(uploadedArgument);
+    if (uploadedArgument.getAccessType() != ArgumentAccessType::ReadOnly)
+    {
+        deviceUsage |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
     }
 
-    auto hostBuffer = MakeStdUnique<VulkanBuffer>(kernelArgument, device->getDevice(), device->getPhysicalDevice(), hostUsage);
-    hostBuffer->allocateMemory(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-    hostBuffer->uploadData(kernelArgument.getData(), kernelArgument.getDataSizeInBytes());
+    auto deviceBuffer = MakeStdUnique<VulkanBuffer>(uploadedArgument, device->getDevice(), device->getPhysicalDevice(), deviceUsage);
+    deviceBuffer->allocateMemory(*memoryAllocator, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
-    if (kernelArgument.getMemoryLocation() == ArgumentMemoryLocation::Device)
+    if (writeOnly && !uploadedArgument.hasFillPattern())
     {
-        VkBufferUsageFlags deviceUsage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
-        if (kernelArgument.getAccessType() != ArgumentAccessType::ReadOnly)
+        buffers.insert(std::move(deviceBuffer));
+        return eventId;
+    }
+
+    if (deviceFill)
+    {
+        uint8_t patternBytes[sizeof(uint32_t)];
+        for (size_t i = 0; i < sizeof(uint32_t); ++i)
         {
-            deviceUsage |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+            patternBytes[i] = uploadedArgument.getFillPattern()[i % uploadedArgument.getFillPatternPeriod()];
         }
 
-        auto deviceBuffer = MakeStdUnique<VulkanBuffer>(kernelArgument, device->getDevice(), device->getPhysicalDevice(), deviceUsage);
-        deviceBuffer->allocateMemory(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-        auto bufferEvent = MakeStdUnique<VulkanEvent>(device->getDevice(), eventId, true);
-        auto commandBuffer = MakeStdUnique<VulkanCommandBufferHolder>(device->getDevice(), commandPool->getCommandPool());
-        deviceBuffer->recordCopyDataCommand(commandBuffer->getCommandBuffer(), hostBuffer->getBuffer(), hostBuffer->getBufferSize());
-        queues[queue].submitSingleCommand(commandBuffer->getCommandBuffer(), bufferEvent->getFence().getFence());
+        uint32_t patternWord;
+        std::memcpy(&patternWord, patternBytes, sizeof(patternWord));
 
-        bufferEvents.insert(std::make_pair(eventId, std::move(bufferEvent)));
-        eventCommands.insert(std::make_pair(eventId, std::move(commandBuffer)));
-        stagingBuffers.insert(std::make_pair(eventId, std::move(hostBuffer)));
+        VulkanCommandBatch& batch = getCommandBatch(queue);
+        batch.recordFill(*deviceBuffer, patternWord);
+        addCommandBatchEvent(batch, eventId);
         buffers.insert(std::move(deviceBuffer));
+        return eventId;
     }
-    else if (kernelArgument.getMemoryLocation() == ArgumentMemoryLocation::Host)
+
+    // Data is staged in persistently mapped ring, transfers which do not fit into the ring receive dedicated staging buffer. Remaining
+    // write-only arguments carry fill pattern which cannot be applied on device.
+    const VkDeviceSize dataSize = deviceBuffer->getBufferSize();
+    std::unique_ptr<VulkanBuffer> stagingBuffer;
+    VkDeviceSize stagingOffset = 0;
+    void* stagingData;
+
+    if (dataSize > 0 && dataSize <= stagingRing->getCapacity())
     {
-        buffers.insert(std::move(hostBuffer));
+        stagingOffset = reserveStagingRange(dataSize, queue);
+        stagingData = stagingRing->getMappedData(stagingOffset);
+    }
+    else
+    {
+        stagingBuffer = MakeStdUnique<VulkanBuffer>(uploadedArgument, device->getDevice(), device->getPhysicalDevice(),
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+        stagingBuffer->allocateMemory(*memoryAllocator, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        stagingData = stagingBuffer->getAllocation().mappedData;
+    }
+
+    if (writeOnly)
+    {
+        uploadedArgument.fillWithPattern(stagingData, uploadedArgument.getDataSizeInBytes());
+    }
+    else
+    {
+        std::memcpy(stagingData, uploadedArgument.getData(), uploadedArgument.getDataSizeInBytes());
+    }
+
+    VulkanCommandBatch& batch = getCommandBatch(queue);
+    batch.recordCopy(stagingBuffer != nullptr ? stagingBuffer->getBuffer() : stagingRing->getBuffer(), stagingOffset,
+        deviceBuffer->getBuffer(), 0, dataSize);
+
+    if (stagingBuffer != nullptr)
+    {
+        batch.addStagingBuffer(std::move(stagingBuffer));
     }
 
-    ++nextEventId;
+    addCommandBatchEvent(batch, eventId);
+    buffers.insert(std::move(deviceBuffer));
     return eventId;
 }
 
@@ -300,19 +517,33 @@ uint64_t VulkanEngine::downloadArgument(const ArgumentId id, void* destination,
 
 EventId VulkanEngine::downloadArgumentAsync(const ArgumentId id, void* destination, const size_t dataSizeInBytes, const QueueId queue) const
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
     if (queue >= queues.size())
     {
         throw std::runtime_error(std::string("Invalid queue index: ") + std::to_string(queue));
     }
 
     VulkanBuffer* buffer = findBuffer(id);
+    const KernelArgument* spilledArgument = residencyManager.findSpilledArgument(id);
 
-    if (buffer == nullptr)
+    if (buffer == nullptr && spilledArgument == nullptr)
     {
         throw std::runtime_error(std::string("Buffer with following id was not found: ") + std::to_string(id));
     }
 
-    EventId eventId = nextEventId;
+    const EventId eventId = nextEventId++;
+
+    if (buffer == nullptr)
+    {
+        // Evicted buffer is served from its spilled contents
+        Logger::logDebug("Downloading spilled buffer for argument " + std::to_string(id) + ", event id: " + std::to_string(eventId));
+        const size_t dataSize = dataSizeInBytes == 0 ? spilledArgument->getDataSizeInBytes() : dataSizeInBytes;
+        std::memcpy(destination, spilledArgument->getData(), dataSize);
+        bufferEvents.insert(eventId, createEvent(eventId, false));
+        return eventId;
+    }
+
     Logger::logDebug("Downloading buffer for argument " + std::to_string(id) + ", event id: " + std::to_string(eventId));
     size_t actualDataSize = buffer->getBufferSize();
     if (dataSizeInBytes > 0)
@@ -320,39 +551,37 @@ EventId VulkanEngine::downloadArgumentAsync(const ArgumentId id, void* destinati
         actualDataSize = dataSizeInBytes;
     }
 
+    bufferEvents.insert(eventId, createEvent(eventId, false));
+
     if (buffer->getMemoryLocation() == ArgumentMemoryLocation::Host)
     {
+        // Host visible memory is read directly, commands submitted earlier to the same queue may still write it
+        flushCommandBatch(queue);
+        retireQueueCommandBatches(queue);
         buffer->downloadData(destination, actualDataSize);
-        auto bufferEvent = MakeStdUnique<VulkanEvent>(device->getDevice(), eventId, false);
-        bufferEvents.insert(std::make_pair(eventId, std::move(bufferEvent)));
-    }
-    else if (buffer->getMemoryLocation() == ArgumentMemoryLocation::Device)
-    {
-        auto hostBuffer = MakeStdUnique<VulkanBuffer>(*buffer, device->getDevice(), device->getPhysicalDevice(), VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-            actualDataSize);
-        hostBuffer->allocateMemory(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-        auto bufferEvent = MakeStdUnique<VulkanEvent>(device->getDevice(), eventId, true);
-        auto commandBuffer = MakeStdUnique<VulkanCommandBufferHolder>(device->getDevice(), commandPool->getCommandPool());
-        hostBuffer->recordCopyDataCommand(commandBuffer->getCommandBuffer(), buffer->getBuffer(), actualDataSize);
-        queues[queue].submitSingleCommand(commandBuffer->getCommandBuffer(), bufferEvent->getFence().getFence());
-
-        // todo: make this asynchronous
-        bufferEvent->wait();
-        hostBuffer->downloadData(destination, actualDataSize);
-
-        bufferEvents.insert(std::make_pair(eventId, std::move(bufferEvent)));
-        eventCommands.insert(std::make_pair(eventId, std::move(commandBuffer)));
-        stagingBuffers.insert(std::make_pair(eventId, std::move(hostBuffer)));
+        return eventId;
     }
 
-    nextEventId++;
+    // Destination is written once command batch completes, at the latest when the operation is synchronized
+    enqueueDownload(*buffer, destination, actualDataSize, queue, eventId);
     return eventId;
 }
 
 KernelArgument VulkanEngine::downloadArgumentObject(const ArgumentId id, uint64_t* downloadDuration) const
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     VulkanBuffer* buffer = findBuffer(id);
+    const KernelArgument* spilledArgument = residencyManager.findSpilledArgument(id);
+
+    if (buffer == nullptr && spilledArgument != nullptr)
+    {
+        if (downloadDuration != nullptr)
+        {
+            *downloadDuration = 0;
+        }
+
+        return *spilledArgument;
+    }
 
     if (buffer == nullptr)
     {
@@ -362,37 +591,9 @@ KernelArgument VulkanEngine::downloadArgumentObject(const ArgumentId id, uint64_
     KernelArgument argument(buffer->getKernelArgumentId(), buffer->getBufferSize() / buffer->getElementSize(), buffer->getElementSize(),
         buffer->getDataType(), buffer->getMemoryLocation(), buffer->getAccessType(), ArgumentUploadType::Vector);
 
-    EventId eventId = nextEventId;
-    Logger::logDebug("Downloading buffer for argument " + std::to_string(id) + ", event id: " + std::to_string(eventId));
-
-    if (buffer->getMemoryLocation() == ArgumentMemoryLocation::Host)
-    {
-        buffer->downloadData(argument.getData(), argument.getDataSizeInBytes());
-        auto bufferEvent = MakeStdUnique<VulkanEvent>(device->getDevice(), eventId, false);
-        bufferEvents.insert(std::make_pair(eventId, std::move(bufferEvent)));
-    }
-    else if (buffer->getMemoryLocation() == ArgumentMemoryLocation::Device)
-    {
-        auto hostBuffer = MakeStdUnique<VulkanBuffer>(*buffer, device->getDevice(), device->getPhysicalDevice(), VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-            argument.getDataSizeInBytes());
-        hostBuffer->allocateMemory(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-        auto bufferEvent = MakeStdUnique<VulkanEvent>(device->getDevice(), eventId, true);
-        auto commandBuffer = MakeStdUnique<VulkanCommandBufferHolder>(device->getDevice(), commandPool->getCommandPool());
-        hostBuffer->recordCopyDataCommand(commandBuffer->getCommandBuffer(), buffer->getBuffer(), argument.getDataSizeInBytes());
-        queues[getDefaultQueue()].submitSingleCommand(commandBuffer->getCommandBuffer(), bufferEvent->getFence().getFence());
-
-        bufferEvent->wait();
-        hostBuffer->downloadData(argument.getData(), argument.getDataSizeInBytes());
-
-        bufferEvents.insert(std::make_pair(eventId, std::move(bufferEvent)));
-        eventCommands.insert(std::make_pair(eventId, std::move(commandBuffer)));
-        stagingBuffers.insert(std::make_pair(eventId, std::move(hostBuffer)));
-    }
-
-    nextEventId++;
-
+    EventId eventId = downloadArgumentAsync(id, argument.getData(), argument.getDataSizeInBytes(), getDefaultQueue());
     uint64_t duration = getArgumentOperationDuration(eventId);
+
     if (downloadDuration != nullptr)
     {
         *downloadDuration = duration;
@@ -419,25 +620,24 @@ uint64_t VulkanEngine::persistArgument(KernelArgument& kernelArgument, const boo
 
 uint64_t VulkanEngine::getArgumentOperationDuration(const EventId id) const
 {
-    auto eventPointer = bufferEvents.find(id);
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    std::unique_ptr<VulkanEvent> event = bufferEvents.take(id);
 
-    if (eventPointer == bufferEvents.end())
+    if (event == nullptr)
     {
         throw std::runtime_error(std::string("Buffer event with following id does not exist or its result was already retrieved: ")
             + std::to_string(id));
     }
 
-    if (!eventPointer->second->isValid())
+    const uint64_t* batchId = commandBatchEvents.find(id);
+
+    if (batchId != nullptr)
     {
-        bufferEvents.erase(id);
-        return 0;
+        Logger::logDebug("Performing buffer operation synchronization for event id: " + std::to_string(id));
+        waitCommandBatch(*batchId);
     }
 
-    Logger::logDebug("Performing buffer operation synchronization for event id: " + std::to_string(id));
-    eventPointer->second->wait();
-    bufferEvents.erase(id);
-    eventCommands.erase(id);
-    stagingBuffers.erase(id);
+    eventPool.release(std::move(event));
 
     // todo: return correct duration
     return 0;
@@ -445,54 +645,79 @@ uint64_t VulkanEngine::getArgumentOperationDuration(const EventId id) const
 
 void VulkanEngine::resizeArgument(const ArgumentId id, const size_t newSize, const bool preserveData)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     throw std::runtime_error("Vulkan API is not yet supported");
 }
 
 void VulkanEngine::setPersistentBufferUsage(const bool flag)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
     persistentBufferFlag = flag;
 }
 
 void VulkanEngine::clearBuffer(const ArgumentId id)
 {
-    auto iterator = buffers.cbegin();
-
-    while (iterator != buffers.cend())
-    {
-        if (iterator->get()->getKernelArgumentId() == id)
-        {
-            buffers.erase(iterator);
-            return;
-        }
-        else
-        {
-            ++iterator;
-        }
-    }
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    residencyManager.releaseSpilledArgument(id);
+    eraseBuffer(id);
 }
 
 void VulkanEngine::clearBuffers()
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    buffers.forEach([this](const VulkanBuffer& buffer)
+    {
+        residencyManager.removeBuffer(buffer.getKernelArgumentId());
+    });
+
     buffers.clear();
+    residencyManager.releaseSpilledArguments();
 }
 
 void VulkanEngine::clearBuffers(const ArgumentAccessType accessType)
 {
-    auto iterator = buffers.cbegin();
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    residencyManager.releaseSpilledArguments(accessType);
+    std::vector<ArgumentId> clearedBuffers;
 
-    while (iterator != buffers.cend())
+    buffers.forEach([&clearedBuffers, accessType](const VulkanBuffer& buffer)
     {
-        if (iterator->get()->getAccessType() == accessType)
+        if (buffer.getAccessType() == accessType)
         {
-            iterator = buffers.erase(iterator);
-        }
-        else
-        {
-            ++iterator;
+            clearedBuffers.push_back(buffer.getKernelArgumentId());
         }
+    });
+
+    for (const auto id : clearedBuffers)
+    {
+        residencyManager.removeBuffer(id);
+        buffers.erase(id);
     }
 }
 
+void VulkanEngine::setDeviceMemoryBudget(const size_t budget)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    residencyManager.setBudget(budget);
+}
+
+DeviceMemoryStatistics VulkanEngine::getDeviceMemoryStatistics() const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    return residencyManager.getStatistics();
+}
+
+ArgumentMemoryLocation VulkanEngine::getAutomaticMemoryLocation(const ArgumentAccessType) const
+{
+    // Host zero-copy buffers are not supported, host visible buffers on unified memory devices are placed in device local memory instead
+    if (device->getPhysicalDevice().hasHostUnifiedMemory())
+    {
+        return ArgumentMemoryLocation::Host;
+    }
+
+    return ArgumentMemoryLocation::Device;
+}
+
 void VulkanEngine::printComputeAPIInfo(std::ostream& outputTarget) const
 {
     outputTarget << "Platform 0: " << "Vulkan" << std::endl;
@@ -542,8 +767,9 @@ DeviceInfo VulkanEngine::getCurrentDeviceInfo() const
     return getDeviceInfo(0).at(deviceIndex);
 }
 
-EventId VulkanEngine::enqueuePipeline(VulkanComputePipeline& pipeline, const std::vector<size_t>& globalSize, const std::vector<size_t>& localSize,
-    const QueueId queue, const uint64_t kernelLaunchOverhead)
+EventId VulkanEngine::enqueuePipeline(std::shared_ptr<VulkanPipelineCacheEntry> pipelineEntry, const size_t descriptorSetIndex,
+    const std::vector<VulkanBuffer*>& arguments, const std::vector<uint8_t>& pushConstantData, const std::vector<size_t>& globalSize,
+    const std::vector<size_t>& localSize, const QueueId queue, const uint64_t kernelLaunchOverhead)
 {
     if (queue >= queues.size())
     {
@@ -562,25 +788,34 @@ EventId VulkanEngine::enqueuePipeline(VulkanComputePipeline& pipeline, const std
         correctedGlobalSize.at(2) /= localSize.at(2);
     }
 
-    EventId eventId = nextEventId;
-    auto kernelEvent = MakeStdUnique<VulkanEvent>(device->getDevice(), eventId, pipeline.getShaderName(), kernelLaunchOverhead);
-    ++nextEventId;
+    const VulkanComputePipeline& pipeline = *pipelineEntry->pipeline;
+    const EventId eventId = nextEventId++;
+
+    const uint32_t querySlot = queryPool->acquireSlot();
+    VulkanCommandBatch& batch = getCommandBatch(queue);
+
+    Logger::logDebug("Launching kernel " + pipeline.getShaderName() + ", event id: " + std::to_string(eventId) + ", query slot: "
+        + std::to_string(querySlot) + ", command batch: " + std::to_string(batch.getId()));
+    batch.recordDispatch(pipelineEntry, descriptorSetIndex, arguments, pushConstantData, correctedGlobalSize, queryPool->getQueryPool(querySlot),
+        queryPool->getFirstQuery(querySlot));
 
-    Logger::logDebug("Launching kernel " + pipeline.getShaderName() + ", event id: " + std::to_string(eventId));
-    auto command = MakeStdUnique<VulkanCommandBufferHolder>(device->getDevice(), commandPool->getCommandPool());
-    pipeline.recordDispatchShaderCommand(command->getCommandBuffer(), correctedGlobalSize, queryPool->getQueryPool());
-    queues[queue].submitSingleCommand(command->getCommandBuffer(), kernelEvent->getFence().getFence());
+    kernelEvents.insert(eventId, createKernelEvent(eventId, pipeline.getShaderName(), kernelLaunchOverhead, querySlot));
+    kernelEventQueues.insert(eventId, queue);
+    addCommandBatchEvent(batch, eventId);
+
+    if (batch.isFull())
+    {
+        flushCommandBatch(queue);
+    }
 
-    kernelEvents.insert(std::make_pair(eventId, std::move(kernelEvent)));
-    eventCommands.insert(std::make_pair(eventId, std::move(command)));
     return eventId;
 }
 
 KernelResult VulkanEngine::createKernelResult(const EventId id) const
 {
-    auto eventPointer = kernelEvents.find(id);
+    std::unique_ptr<VulkanEvent>* event = kernelEvents.find(id);
 
-    if (eventPointer == kernelEvents.end())
+    if (event == nullptr)
     {
         throw std::runtime_error(std::string("Kernel event with following id does not exist or its result was already retrieved: ")
             + std::to_string(id));
@@ -588,29 +823,67 @@ KernelResult VulkanEngine::createKernelResult(const EventId id) const
 
     Logger::logDebug(std::string("Performing kernel synchronization for event id: ") + std::to_string(id));
 
-    eventPointer->second->wait();
-    const std::string& name = eventPointer->second->getKernelName();
-    const uint64_t overhead = eventPointer->second->getOverhead();
-    uint64_t duration = queryPool->getResult();
+    const uint64_t* batchId = commandBatchEvents.find(id);
+
+    if (batchId != nullptr)
+    {
+        waitCommandBatch(*batchId);
+    }
+
+    const std::string& name = (*event)->getKernelName();
+    const uint64_t overhead = (*event)->getOverhead();
+    const uint32_t querySlot = (*event)->getQuerySlot();
+    uint64_t duration = queryPool->getResult(querySlot);
+    queryPool->releaseSlot(querySlot);
 
     KernelResult result(name, duration);
     result.setOverhead(overhead);
 
-    kernelEvents.erase(id);
-    eventCommands.erase(id);
+    eventPool.release(kernelEvents.take(id));
+    kernelEventQueues.erase(id);
 
     return result;
 }
 
-std::vector<VulkanBuffer*> VulkanEngine::getPipelineArguments(const std::vector<KernelArgument*>& argumentPointers)
+std::vector<VulkanBuffer*> VulkanEngine::getPipelineArguments(const std::vector<KernelArgument*>& argumentPointers,
+    const VulkanComputePipeline& pipeline, std::vector<uint8_t>& pushConstantData)
 {
     std::vector<VulkanBuffer*> result;
+    const std::vector<uint32_t>& pushConstantOffsets = pipeline.getShaderInterface().getPushConstantOffsets();
+    size_t scalarIndex = 0;
 
     for (auto* argument : argumentPointers)
     {
-        if (argument->getUploadType() == ArgumentUploadType::Local || argument->getUploadType() == ArgumentUploadType::Scalar)
+        if (argument->getUploadType() == ArgumentUploadType::Local)
         {
-            throw std::runtime_error("Only vector arguments are currently supported for Vulkan backend");
+            throw std::runtime_error("Local memory arguments are not supported for Vulkan backend, shared memory has to be declared in shader");
+        }
+        else if (argument->getUploadType() == ArgumentUploadType::Scalar)
+        {
+            // Scalars are stored into push constant block members in the order of arguments, size of member is bounded by offset of the next
+            // member and by push constant range of the pipeline
+            if (scalarIndex >= pushConstantOffsets.size())
+            {
+                throw std::runtime_error(std::string("Scalar argument with id ") + std::to_string(argument->getId())
+                    + " does not have corresponding member in push constant block of shader " + pipeline.getShaderName());
+            }
+
+            const size_t offset = pushConstantOffsets[scalarIndex];
+            const size_t limit = scalarIndex + 1 < pushConstantOffsets.size() ? pushConstantOffsets[scalarIndex + 1]
+                : pipeline.getPushConstantsSize();
+            const size_t dataSize = argument->getDataSizeInBytes();
+
+            if (offset + dataSize > limit)
+            {
+                throw std::runtime_error(std::string("Scalar argument with id ") + std::to_string(argument->getId())
+                    + " does not fit into push constant block member of shader " + pipeline.getShaderName() + ", maximum push constants size is "
+                    + std::to_string(pipeline.getPushConstantsSize()));
+            }
+
+            pushConstantData.resize(std::max(pushConstantData.size(), offset + dataSize));
+            std::memcpy(pushConstantData.data() + offset, argument->getData(), dataSize);
+            result.push_back(nullptr);
+            ++scalarIndex;
         }
         else if (argument->getUploadType() == ArgumentUploadType::Vector)
         {
@@ -625,31 +898,421 @@ std::vector<VulkanBuffer*> VulkanEngine::getPipelineArguments(const std::vector<
         }
     }
 
+    if (scalarIndex < pushConstantOffsets.size())
+    {
+        throw std::runtime_error(std::string("Push constant block of shader ") + pipeline.getShaderName() + " has "
+            + std::to_string(pushConstantOffsets.size()) + " members, but only " + std::to_string(scalarIndex) + " scalar arguments were provided");
+    }
+
+    // Size of push constant update has to be multiple of 4 bytes
+    pushConstantData.resize((pushConstantData.size() + 3) / 4 * 4);
     return result;
 }
 
+VkBufferUsageFlags VulkanEngine::getDescriptorUsage(const KernelArgument& kernelArgument) const
+{
+    // Small read-only buffers can be bound to uniform blocks as well, which are served from constant caches on most devices
+    const VkPhysicalDeviceLimits limits = device->getPhysicalDevice().getProperties().limits;
+
+    if (kernelArgument.getAccessType() == ArgumentAccessType::ReadOnly && kernelArgument.getDataSizeInBytes() <= limits.maxUniformBufferRange)
+    {
+        return VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+    }
+
+    return VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+}
+
+std::shared_ptr<VulkanPipelineCacheEntry> VulkanEngine::loadPipeline(const KernelRuntimeData& kernelData)
+{
+    if (!kernelCacheFlag)
+    {
+        return buildPipeline(kernelData);
+    }
+
+    const auto cacheKey = KernelFingerprint::compute(kernelData.getName(), kernelData.getSource(), compilerOptions, deviceIndex);
+
+    return pipelineCache.getOrBuild(cacheKey, [this, &kernelData](size_t& entrySize)
+    {
+        std::shared_ptr<VulkanPipelineCacheEntry> entry = buildPipeline(kernelData);
+        entrySize = entry->shader->getSpirvSource().size() * sizeof(uint32_t);
+        return entry;
+    });
+}
+
+std::shared_ptr<VulkanPipelineCacheEntry> VulkanEngine::buildPipeline(const KernelRuntimeData& kernelData) const
+{
+    // Descriptor set layout and push constant range are generated from buffers and scalars declared by shader
+    std::shared_ptr<VulkanShaderModule> shader = loadShaderModule(kernelData);
+    const VulkanShaderInterface& shaderInterface = shader->getShaderInterface();
+    auto layout = MakeStdUnique<VulkanDescriptorSetLayout>(device->getDevice(), shaderInterface.getBindings());
+    const VulkanSpecialization specialization(shader->getSpecializationConstants(), kernelData.getLocalSize(), kernelData.getParameterPairs());
+    const uint32_t pushConstantsSize = device->getPhysicalDevice().getProperties().limits.maxPushConstantsSize;
+    auto pipeline = MakeStdUnique<VulkanComputePipeline>(device->getDevice(), layout->getDescriptorSetLayout(), shader->getShaderModule(),
+        kernelData.getName(), driverPipelineCache->getPipelineCache(), specialization.getSpecializationInfo(), shaderInterface, pushConstantsSize);
+    return std::make_shared<VulkanPipelineCacheEntry>(std::move(pipeline), std::move(layout), shader);
+}
+
+std::shared_ptr<VulkanShaderModule> VulkanEngine::loadShaderModule(const KernelRuntimeData& kernelData) const
+{
+    // SPIR-V does not depend on configuration, unless the shader splices local size through preprocessor definitions
+    std::string localSizeKey = "";
+
+    if (ShadercCompiler::usesLocalSizeDefines(kernelData.getUnmodifiedSource()))
+    {
+        const std::vector<size_t>& localSize = kernelData.getLocalSize();
+        localSizeKey = std::to_string(localSize[0]) + "," + std::to_string(localSize[1]) + "," + std::to_string(localSize[2]);
+    }
+
+    const KernelFingerprint spirvKey = KernelFingerprint::compute(kernelData.getName(), kernelData.getUnmodifiedSource(), localSizeKey, 0);
+
+    if (!kernelCacheFlag)
+    {
+        return createShaderModule(kernelData, spirvKey);
+    }
+
+    return shaderCache.getOrBuild(spirvKey, [this, &kernelData, &spirvKey](size_t& entrySize)
+    {
+        std::shared_ptr<VulkanShaderModule> shader = createShaderModule(kernelData, spirvKey);
+        entrySize = shader->getSpirvSource().size() * sizeof(uint32_t);
+        return shader;
+    });
+}
+
+std::unique_ptr<VulkanShaderModule> VulkanEngine::createShaderModule(const KernelRuntimeData& kernelData, const KernelFingerprint& spirvKey) const
+{
+    if (!diskCache.isEnabled())
+    {
+        return MakeStdUnique<VulkanShaderModule>(device->getDevice(), kernelData.getName(), kernelData.getUnmodifiedSource(),
+            kernelData.getLocalSize());
+    }
+
+    std::vector<uint8_t> spirvData;
+
+    if (diskCache.load(spirvKey, spirvData))
+    {
+        const uint32_t spirvMagicNumber = 0x07230203;
+        std::vector<uint32_t> spirvSource(spirvData.size() / sizeof(uint32_t));
+        std::memcpy(spirvSource.data(), spirvData.data(), spirvSource.size() * sizeof(uint32_t));
+
+        if (spirvData.size() % sizeof(uint32_t) == 0 && !spirvSource.empty() && spirvSource[0] == spirvMagicNumber)
+        {
+            return MakeStdUnique<VulkanShaderModule>(device->getDevice(), kernelData.getName(), kernelData.getUnmodifiedSource(), spirvSource);
+        }
+
+        Logger::getLogger().log(LoggingLevel::Warning, std::string("Cached SPIR-V is invalid, recompiling kernel: ") + kernelData.getName());
+        diskCache.erase(spirvKey);
+    }
+
+    auto shader = MakeStdUnique<VulkanShaderModule>(device->getDevice(), kernelData.getName(), kernelData.getUnmodifiedSource(),
+        kernelData.getLocalSize());
+
+    const std::vector<uint32_t>& spirvSource = shader->getSpirvSource();
+    spirvData.resize(spirvSource.size() * sizeof(uint32_t));
+    std::memcpy(spirvData.data(), spirvSource.data(), spirvData.size());
+    diskCache.store(spirvKey, spirvData);
+
+    return shader;
+}
+
+void VulkanEngine::storePipelineCacheData() const
+{
+    if (diskCache.isEnabled())
+    {
+        diskCache.store(pipelineCacheKey, driverPipelineCache->getData());
+    }
+}
+
 VulkanBuffer* VulkanEngine::findBuffer(const ArgumentId id) const
 {
     if (persistentBufferFlag)
     {
-        for (const auto& buffer : persistentBuffers)
+        VulkanBuffer* buffer = persistentBuffers.find(id);
+
+        if (buffer != nullptr)
+        {
+            return buffer;
+        }
+    }
+
+    return buffers.find(id);
+}
+
+void VulkanEngine::eraseBuffer(const ArgumentId id)
+{
+    if (buffers.erase(id))
+    {
+        residencyManager.removeBuffer(id);
+    }
+}
+
+void VulkanEngine::reserveBufferMemory(const size_t size)
+{
+    const std::vector<ArgumentId> evictedBuffers = residencyManager.getEvictionCandidates(size);
+
+    if (evictedBuffers.empty())
+    {
+        return;
+    }
+
+    // Evicted buffers may still be accessed by submitted command batches and their contents are spilled only after those batches complete
+    synchronizeDevice();
+
+    for (const auto id : evictedBuffers)
+    {
+        Logger::logDebug("Evicting buffer for argument " + std::to_string(id));
+
+        if (residencyManager.isSpillRequired(id))
+        {
+            residencyManager.storeSpilledArgument(downloadArgumentObject(id, nullptr));
+        }
+
+        residencyManager.evictBuffer(id);
+        eraseBuffer(id);
+    }
+}
+
+std::unique_ptr<VulkanEvent> VulkanEngine::createEvent(const EventId id, const bool validFlag) const
+{
+    std::unique_ptr<VulkanEvent> event = eventPool.acquire();
+
+    if (event == nullptr)
+    {
+        return MakeStdUnique<VulkanEvent>(device->getDevice(), id, validFlag);
+    }
+
+    event->reset(device->getDevice(), id, validFlag);
+    return event;
+}
+
+std::unique_ptr<VulkanEvent> VulkanEngine::createKernelEvent(const EventId id, const std::string& kernelName, const uint64_t kernelLaunchOverhead,
+    const uint32_t querySlot) const
+{
+    std::unique_ptr<VulkanEvent> event = eventPool.acquire();
+
+    if (event == nullptr)
+    {
+        return MakeStdUnique<VulkanEvent>(id, kernelName, kernelLaunchOverhead, querySlot);
+    }
+
+    event->reset(id, kernelName, kernelLaunchOverhead, querySlot);
+    return event;
+}
+
+void VulkanEngine::enqueueDownload(const VulkanBuffer& buffer, void* destination, const size_t dataSize, const QueueId queue,
+    const EventId eventId) const
+{
+    if (dataSize == 0)
+    {
+        return;
+    }
+
+    std::unique_ptr<VulkanBuffer> stagingBuffer;
+    VkDeviceSize stagingOffset = 0;
+    const void* stagingData;
+
+    if (dataSize <= stagingRing->getCapacity())
+    {
+        stagingOffset = reserveStagingRange(dataSize, queue);
+        stagingData = stagingRing->getMappedData(stagingOffset);
+    }
+    else
+    {
+        stagingBuffer = MakeStdUnique<VulkanBuffer>(buffer, device->getDevice(), device->getPhysicalDevice(), VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            dataSize);
+        stagingBuffer->allocateMemory(*memoryAllocator, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        stagingData = stagingBuffer->getAllocation().mappedData;
+    }
+
+    VulkanCommandBatch& batch = getCommandBatch(queue);
+    batch.recordCopy(buffer.getBuffer(), 0, stagingBuffer != nullptr ? stagingBuffer->getBuffer() : stagingRing->getBuffer(), stagingOffset,
+        dataSize);
+    batch.addDownload(stagingData, destination, dataSize);
+
+    if (stagingBuffer != nullptr)
+    {
+        batch.addStagingBuffer(std::move(stagingBuffer));
+    }
+
+    addCommandBatchEvent(batch, eventId);
+}
+
+VkDeviceSize VulkanEngine::reserveStagingRange(const VkDeviceSize size, const QueueId queue) const
+{
+    VkDeviceSize offset;
+
+    while (!stagingRing->tryReserve(size, getCommandBatch(queue).getId(), offset))
+    {
+        // Ranges of completed batches are reclaimed first, the oldest batch in flight is waited for only if that is not sufficient
+        std::vector<uint64_t> completedBatches;
+
+        for (const auto& batch : submittedCommandBatches)
+        {
+            if (batch.second->isComplete())
+            {
+                completedBatches.push_back(batch.first);
+            }
+        }
+
+        for (const auto id : completedBatches)
         {
-            if (buffer->getKernelArgumentId() == id)
+            retireCommandBatch(id);
+        }
+
+        if (completedBatches.empty())
+        {
+            flushCommandBatches();
+
+            if (submittedCommandBatches.empty())
             {
-                return buffer.get();
+                throw std::runtime_error(std::string("Unable to reserve staging memory of size: ") + std::to_string(size));
             }
+
+            retireCommandBatch(submittedCommandBatches.begin()->first);
         }
     }
 
-    for (const auto& buffer : buffers)
+    return offset;
+}
+
+VulkanCommandBatch& VulkanEngine::getCommandBatch(const QueueId queue) const
+{
+    auto batchPointer = openCommandBatches.find(queue);
+
+    if (batchPointer != openCommandBatches.end())
+    {
+        return *batchPointer->second;
+    }
+
+    std::unique_ptr<VulkanCommandContext> context;
+
+    if (commandContexts.empty())
     {
-        if (buffer->getKernelArgumentId() == id)
+        context = MakeStdUnique<VulkanCommandContext>(device->getDevice(), device->getQueueFamilyIndex());
+    }
+    else
+    {
+        context = std::move(commandContexts.back());
+        commandContexts.pop_back();
+    }
+
+    auto batch = MakeStdUnique<VulkanCommandBatch>(std::move(context), nextCommandBatchId, queue);
+    ++nextCommandBatchId;
+    VulkanCommandBatch& result = *batch;
+    openCommandBatches.insert(std::make_pair(queue, std::move(batch)));
+    return result;
+}
+
+void VulkanEngine::addCommandBatchEvent(VulkanCommandBatch& batch, const EventId eventId) const
+{
+    batch.addEvent(eventId);
+    commandBatchEvents.insert(eventId, batch.getId());
+}
+
+bool VulkanEngine::flushCommandBatch(const QueueId queue) const
+{
+    auto batchPointer = openCommandBatches.find(queue);
+
+    if (batchPointer == openCommandBatches.end())
+    {
+        return false;
+    }
+
+    std::unique_ptr<VulkanCommandBatch> batch = std::move(batchPointer->second);
+    openCommandBatches.erase(batchPointer);
+    const uint64_t id = batch->getId();
+
+    if (batch->isEmpty())
+    {
+        stagingRing->retire(id);
+        commandContexts.push_back(batch->releaseContext());
+        return false;
+    }
+
+    auto waitPointer = pendingWaitSemaphores.find(queue);
+
+    if (waitPointer != pendingWaitSemaphores.end())
+    {
+        batch->addWaitSemaphores(waitPointer->second);
+        pendingWaitSemaphores.erase(waitPointer);
+    }
+
+    Logger::logDebug("Submitting command batch " + std::to_string(id) + " with " + std::to_string(batch->getEvents().size())
+        + " operations to queue " + std::to_string(queue));
+    batch->submit(queues[queue]);
+    submittedCommandBatches.insert(std::make_pair(id, std::move(batch)));
+    return true;
+}
+
+void VulkanEngine::flushCommandBatches() const
+{
+    while (!openCommandBatches.empty())
+    {
+        flushCommandBatch(openCommandBatches.begin()->first);
+    }
+}
+
+void VulkanEngine::submitCommandBatch(const uint64_t id) const
+{
+    for (const auto& batch : openCommandBatches)
+    {
+        if (batch.second->getId() == id)
         {
-            return buffer.get();
+            flushCommandBatch(batch.first);
+            return;
         }
     }
+}
+
+void VulkanEngine::waitCommandBatch(const uint64_t id) const
+{
+    submitCommandBatch(id);
 
-    return nullptr;
+    if (submittedCommandBatches.find(id) != submittedCommandBatches.end())
+    {
+        retireCommandBatch(id);
+    }
+}
+
+void VulkanEngine::retireCommandBatch(const uint64_t id) const
+{
+    auto batchPointer = submittedCommandBatches.find(id);
+
+    if (batchPointer == submittedCommandBatches.end())
+    {
+        return;
+    }
+
+    const VulkanCommandBatch& batch = *batchPointer->second;
+    batchPointer->second->complete();
+    stagingRing->retire(id);
+
+    for (const auto eventId : batch.getEvents())
+    {
+        commandBatchEvents.erase(eventId);
+    }
+
+    std::unique_ptr<VulkanCommandContext> context = batchPointer->second->releaseContext();
+    context->reset();
+    commandContexts.push_back(std::move(context));
+    submittedCommandBatches.erase(batchPointer);
+}
+
+void VulkanEngine::retireQueueCommandBatches(const QueueId queue) const
+{
+    std::vector<uint64_t> queueBatches;
+
+    for (const auto& batch : submittedCommandBatches)
+    {
+        if (batch.second->getQueue() == queue)
+        {
+            queueBatches.push_back(batch.first);
+        }
+    }
+
+    for (const auto id : queueBatches)
+    {
+        retireCommandBatch(id);
+    }
 }
 
 } // namespace fly
@@ -2,13 +2,16 @@
 
 #ifdef FLY_PLATFORM_VULKAN
 
+#include <atomic>
 #include <memory>
-#include <set>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <vulkan/vulkan.h>
 #include <fly/compute_engine/vulkan/vulkan_buffer.h>
+#include <fly/compute_engine/vulkan/vulkan_command_batch.h>
 #include <fly/compute_engine/vulkan/vulkan_command_buffer_holder.h>
+#include <fly/compute_engine/vulkan/vulkan_command_context.h>
 #include <fly/compute_engine/vulkan/vulkan_command_pool.h>
 #include <fly/compute_engine/vulkan/vulkan_compute_pipeline.h>
 #include <fly/compute_engine/vulkan/vulkan_descriptor_pool.h>
@@ -17,14 +20,27 @@
 #include <fly/compute_engine/vulkan/vulkan_device.h>
 #include <fly/compute_engine/vulkan/vulkan_event.h>
 #include <fly/compute_engine/vulkan/vulkan_instance.h>
+#include <fly/compute_engine/vulkan/vulkan_memory_allocator.h>
+#include <fly/compute_engine/vulkan/vulkan_pipeline_cache.h>
 #include <fly/compute_engine/vulkan/vulkan_pipeline_cache_entry.h>
 #include <fly/compute_engine/vulkan/vulkan_physical_device.h>
+#include <fly/compute_engine/vulkan/vulkan_prepared_pipeline.h>
 #include <fly/compute_engine/vulkan/vulkan_query_pool.h>
 #include <fly/compute_engine/vulkan/vulkan_queue.h>
 #include <fly/compute_engine/vulkan/vulkan_semaphore.h>
+#include <fly/compute_engine/vulkan/vulkan_shader_interface.h>
 #include <fly/compute_engine/vulkan/vulkan_shader_module.h>
+#include <fly/compute_engine/vulkan/vulkan_specialization.h>
+#include <fly/compute_engine/vulkan/vulkan_staging_ring.h>
 #include <fly/compute_engine/vulkan/vulkan_utility.h>
+#include <fly/compute_engine/buffer_residency_manager.h>
+#include <fly/compute_engine/buffer_slot_map.h>
 #include <fly/compute_engine/compute_engine.h>
+#include <fly/compute_engine/concurrent_kernel_cache.h>
+#include <fly/compute_engine/event_pool.h>
+#include <fly/compute_engine/event_slot_map.h>
+#include <fly/compute_engine/kernel_disk_cache.h>
+#include <fly/compute_engine/kernel_fingerprint.h>
 
 namespace fly
 {
@@ -34,6 +50,7 @@ class VulkanEngine : public ComputeEngine
 public:
     // Constructor
     explicit VulkanEngine(const DeviceIndex deviceIndex, const uint32_t queueCount);
+    ~VulkanEngine();
 
     // Kernel handling methods
     KernelResult runKernel(const KernelRuntimeData& kernelData, const std::vector<KernelArgument*>& argumentPointers,
@@ -41,6 +58,12 @@ public:
     EventId runKernelAsync(const KernelRuntimeData& kernelData, const std::vector<KernelArgument*>& argumentPointers, const QueueId queue) override;
     KernelResult getKernelResult(const EventId id, const std::vector<OutputDescriptor>& outputDescriptors) const override;
     uint64_t getKernelOverhead(const EventId id) const override;
+    void compileKernel(const KernelRuntimeData& kernelData) override;
+
+    // Prepared launch methods
+    void prepareKernel(const LaunchId id, const KernelRuntimeData& kernelData) override;
+    EventId runPreparedKernelAsync(const LaunchId id, const std::vector<KernelArgument*>& argumentPointers, const QueueId queue) override;
+    void releasePreparedKernel(const LaunchId id) override;
 
     // Utility methods
     void setCompilerOptions(const std::string& options) override;
@@ -48,6 +71,10 @@ public:
     void setAutomaticGlobalSizeCorrection(const bool flag) override;
     void setKernelCacheUsage(const bool flag) override;
     void setKernelCacheCapacity(const size_t capacity) override;
+    void setKernelCacheByteBudget(const size_t budget) override;
+    void setKernelCacheEvictionPolicy(const KernelCacheEvictionPolicy policy) override;
+    KernelCacheStatistics getKernelCacheStatistics() const override;
+    void setPersistentKernelCache(const std::string& directory, const size_t maxSizeInBytes) override;
     void clearKernelCache() override;
 
     // Queue handling methods
@@ -56,6 +83,7 @@ public:
     void synchronizeQueue(const QueueId queue) override;
     void synchronizeDevice() override;
     void clearEvents() override;
+    void enqueueEventWait(const QueueId queue, const EventId id) override;
 
     // Argument handling methods
     uint64_t uploadArgument(KernelArgument& kernelArgument) override;
@@ -74,6 +102,9 @@ public:
     void clearBuffer(const ArgumentId id) override;
     void clearBuffers() override;
     void clearBuffers(const ArgumentAccessType accessType) override;
+    ArgumentMemoryLocation getAutomaticMemoryLocation(const ArgumentAccessType accessType) const override;
+    void setDeviceMemoryBudget(const size_t budget) override;
+    DeviceMemoryStatistics getDeviceMemoryStatistics() const override;
 
     // Information retrieval methods
     void printComputeAPIInfo(std::ostream& outputTarget) const override;
@@ -90,27 +121,65 @@ private:
     GlobalSizeType globalSizeType;
     bool globalSizeCorrection;
     bool kernelCacheFlag;
-    size_t kernelCacheCapacity;
     bool persistentBufferFlag;
-    mutable EventId nextEventId;
+    mutable std::atomic<EventId> nextEventId;
+    // Serializes recording and submission of command batches, which also covers external synchronization of queues required by Vulkan.
+    // Completed batches copy downloaded data and recycle their command contexts, so batch fences are waited for while holding the lock.
+    mutable std::recursive_mutex mutex;
     std::unique_ptr<VulkanInstance> instance;
     std::unique_ptr<VulkanDevice> device;
-    std::unique_ptr<VulkanCommandPool> commandPool;
+    std::unique_ptr<VulkanMemoryAllocator> memoryAllocator;
+    std::unique_ptr<VulkanStagingRing> stagingRing;
     std::unique_ptr<VulkanQueryPool> queryPool;
     std::vector<VulkanQueue> queues;
-    std::set<std::unique_ptr<VulkanBuffer>> buffers;
-    std::set<std::unique_ptr<VulkanBuffer>> persistentBuffers;
-    std::map<std::pair<std::string, std::string>, std::unique_ptr<VulkanPipelineCacheEntry>> pipelineCache;
-    mutable std::map<EventId, std::unique_ptr<VulkanEvent>> kernelEvents;
-    mutable std::map<EventId, std::unique_ptr<VulkanEvent>> bufferEvents;
-    mutable std::map<EventId, std::unique_ptr<VulkanCommandBufferHolder>> eventCommands;
-    mutable std::map<EventId, std::unique_ptr<VulkanBuffer>> stagingBuffers;
+    BufferSlotMap<VulkanBuffer> buffers;
+    BufferSlotMap<VulkanBuffer> persistentBuffers;
+    BufferResidencyManager residencyManager;
+    ConcurrentKernelCache<VulkanPipelineCacheEntry> pipelineCache;
+    mutable ConcurrentKernelCache<VulkanShaderModule> shaderCache;
+    std::unique_ptr<VulkanPipelineCache> driverPipelineCache;
+    KernelFingerprint pipelineCacheKey;
+    KernelDiskCache diskCache;
+    mutable EventSlotMap<std::unique_ptr<VulkanEvent>> kernelEvents;
+    mutable EventSlotMap<std::unique_ptr<VulkanEvent>> bufferEvents;
+    mutable EventSlotMap<QueueId> kernelEventQueues;
+    mutable EventPool<std::unique_ptr<VulkanEvent>> eventPool;
+    mutable std::map<QueueId, std::vector<std::unique_ptr<VulkanSemaphore>>> pendingWaitSemaphores;
+    std::map<LaunchId, std::unique_ptr<VulkanPreparedPipeline>> preparedPipelines;
+    mutable std::map<QueueId, std::unique_ptr<VulkanCommandBatch>> openCommandBatches;
+    mutable std::map<uint64_t, std::unique_ptr<VulkanCommandBatch>> submittedCommandBatches;
+    mutable EventSlotMap<uint64_t> commandBatchEvents;
+    mutable std::vector<std::unique_ptr<VulkanCommandContext>> commandContexts;
+    mutable uint64_t nextCommandBatchId;
 
-    EventId enqueuePipeline(VulkanComputePipeline& pipeline, const std::vector<size_t>& globalSize, const std::vector<size_t>& localSize,
-        const QueueId queue, const uint64_t kernelLaunchOverhead);
+    EventId enqueuePipeline(std::shared_ptr<VulkanPipelineCacheEntry> pipelineEntry, const size_t descriptorSetIndex,
+        const std::vector<VulkanBuffer*>& arguments, const std::vector<uint8_t>& pushConstantData, const std::vector<size_t>& globalSize,
+        const std::vector<size_t>& localSize, const QueueId queue, const uint64_t kernelLaunchOverhead);
     KernelResult createKernelResult(const EventId id) const;
-    std::vector<VulkanBuffer*> getPipelineArguments(const std::vector<KernelArgument*>& argumentPointers);
+    std::vector<VulkanBuffer*> getPipelineArguments(const std::vector<KernelArgument*>& argumentPointers, const VulkanComputePipeline& pipeline,
+        std::vector<uint8_t>& pushConstantData);
+    VkBufferUsageFlags getDescriptorUsage(const KernelArgument& kernelArgument) const;
     VulkanBuffer* findBuffer(const ArgumentId id) const;
+    void eraseBuffer(const ArgumentId id);
+    void reserveBufferMemory(const size_t size);
+    std::unique_ptr<VulkanEvent> createEvent(const EventId id, const bool validFlag) const;
+    std::unique_ptr<VulkanEvent> createKernelEvent(const EventId id, const std::string& kernelName, const uint64_t kernelLaunchOverhead,
+        const uint32_t querySlot) const;
+    std::shared_ptr<VulkanPipelineCacheEntry> loadPipeline(const KernelRuntimeData& kernelData);
+    std::shared_ptr<VulkanPipelineCacheEntry> buildPipeline(const KernelRuntimeData& kernelData) const;
+    std::shared_ptr<VulkanShaderModule> loadShaderModule(const KernelRuntimeData& kernelData) const;
+    std::unique_ptr<VulkanShaderModule> createShaderModule(const KernelRuntimeData& kernelData, const KernelFingerprint& spirvKey) const;
+    void storePipelineCacheData() const;
+    VkDeviceSize reserveStagingRange(const VkDeviceSize size, const QueueId queue) const;
+    void enqueueDownload(const VulkanBuffer& buffer, void* destination, const size_t dataSize, const QueueId queue, const EventId eventId) const;
+    VulkanCommandBatch& getCommandBatch(const QueueId queue) const;
+    void addCommandBatchEvent(VulkanCommandBatch& batch, const EventId eventId) const;
+    bool flushCommandBatch(const QueueId queue) const;
+    void flushCommandBatches() const;
+    void submitCommandBatch(const uint64_t id) const;
+    void waitCommandBatch(const uint64_t id) const;
+    void retireCommandBatch(const uint64_t id) const;
+    void retireQueueCommandBatches(const QueueId queue) const;
 };
 
 } // namespace fly
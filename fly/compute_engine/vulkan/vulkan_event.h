@@ -16,7 +16,8 @@ public:
         kernelName(""),
         fence(nullptr),
         validFlag(validFlag),
-        overhead(0)
+        overhead(0),
+        querySlot(0)
     {
         if (validFlag)
         {
@@ -24,14 +25,44 @@ public:
         }
     }
 
-    explicit VulkanEvent(VkDevice device, const EventId id, const std::string& kernelName, const uint64_t kernelLaunchOverhead) :
+    // Kernel events are synchronized through command batch into which the dispatch was recorded, they do not own fence
+    explicit VulkanEvent(const EventId id, const std::string& kernelName, const uint64_t kernelLaunchOverhead, const uint32_t querySlot) :
         id(id),
         kernelName(kernelName),
-        fence(MakeStdUnique<VulkanFence>(device)),
-        validFlag(true),
-        overhead(kernelLaunchOverhead)
+        fence(nullptr),
+        validFlag(false),
+        overhead(kernelLaunchOverhead),
+        querySlot(querySlot)
     {}
 
+    // Pooled events are reused for another operation once their result was retrieved, fence is kept and reset
+    void reset(VkDevice device, const EventId id, const bool validFlag)
+    {
+        this->id = id;
+        kernelName = "";
+        this->validFlag = validFlag;
+        overhead = 0;
+        querySlot = 0;
+
+        if (validFlag && fence == nullptr)
+        {
+            fence = MakeStdUnique<VulkanFence>(device);
+        }
+        else if (validFlag)
+        {
+            fence->reset();
+        }
+    }
+
+    void reset(const EventId id, const std::string& kernelName, const uint64_t kernelLaunchOverhead, const uint32_t querySlot)
+    {
+        this->id = id;
+        this->kernelName = kernelName;
+        validFlag = false;
+        overhead = kernelLaunchOverhead;
+        this->querySlot = querySlot;
+    }
+
     EventId getId() const
     {
         return id;
@@ -72,6 +103,11 @@ public:
         return overhead;
     }
 
+    uint32_t getQuerySlot() const
+    {
+        return querySlot;
+    }
+
     void wait()
     {
         if (!isValid())
@@ -88,6 +124,7 @@ private:
     std::unique_ptr<VulkanFence> fence;
     bool validFlag;
     uint64_t overhead;
+    uint32_t querySlot;
 };
 
 } // namespace fly
@@ -32,6 +32,24 @@ public:
         checkVulkanError(vkWaitForFences(device, 1, &fence, VK_TRUE, fenceTimeout), "vkWaitForFences");
     }
 
+    void reset()
+    {
+        checkVulkanError(vkResetFences(device, 1, &fence), "vkResetFences");
+    }
+
+    bool isSignaled() const
+    {
+        const VkResult result = vkGetFenceStatus(device, fence);
+
+        if (result == VK_NOT_READY)
+        {
+            return false;
+        }
+
+        checkVulkanError(result, "vkGetFenceStatus");
+        return true;
+    }
+
     VkDevice getDevice() const
     {
         return device;
@@ -0,0 +1,306 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+#include <fly/compute_engine/vulkan/vulkan_physical_device.h>
+#include <fly/compute_engine/vulkan/vulkan_utility.h>
+
+namespace fly
+{
+
+// Device memory block shared by multiple buffers, it is split into power-of-two sized ranges by buddy allocator
+struct VulkanMemoryBlock
+{
+public:
+    VkDeviceMemory memory;
+    uint32_t memoryTypeIndex;
+    void* mappedData;
+    VkDeviceSize usedBytes;
+    // Offsets of free ranges for each order, range of order i has size of minimumAllocationSize << i
+    std::vector<std::set<VkDeviceSize>> freeRanges;
+};
+
+// Range of device memory reserved for single buffer, block is null for dedicated allocations
+struct VulkanMemoryAllocation
+{
+public:
+    VkDeviceMemory memory;
+    VkDeviceSize offset;
+    VkDeviceSize size;
+    uint32_t memoryTypeIndex;
+    void* mappedData;
+    VulkanMemoryBlock* block;
+    uint32_t order;
+};
+
+// Sub-allocates buffer memory from large blocks, so that creation of buffer does not require separate vkAllocateMemory call and device
+// allocation count limit is not reached when many small arguments are used. Requests larger than half of block receive dedicated memory.
+class VulkanMemoryAllocator
+{
+public:
+    static const VkDeviceSize defaultBlockSize = 64 * 1024 * 1024;
+    static const VkDeviceSize minimumAllocationSize = 256;
+
+    // Constructor
+    explicit VulkanMemoryAllocator(VkDevice device, const VulkanPhysicalDevice& physicalDevice, const VkDeviceSize blockSize = defaultBlockSize) :
+        device(device),
+        physicalDevice(&physicalDevice),
+        blockSize(blockSize),
+        maximumOrder(0),
+        deviceAllocationCount(0)
+    {
+        if (blockSize < minimumAllocationSize || (blockSize & (blockSize - 1)) != 0)
+        {
+            throw std::runtime_error(std::string("Memory block size must be power of two not smaller than ")
+                + std::to_string(minimumAllocationSize));
+        }
+
+        while ((minimumAllocationSize << maximumOrder) < blockSize)
+        {
+            ++maximumOrder;
+        }
+    }
+
+    ~VulkanMemoryAllocator()
+    {
+        for (auto& block : blocks)
+        {
+            releaseDeviceMemory(block->memory, block->mappedData);
+        }
+    }
+
+    VulkanMemoryAllocator(const VulkanMemoryAllocator&) = delete;
+    void operator=(const VulkanMemoryAllocator&) = delete;
+
+    // Core methods
+    VulkanMemoryAllocation allocate(const VkMemoryRequirements& requirements, const VkMemoryPropertyFlags properties)
+    {
+        const uint32_t memoryTypeIndex = physicalDevice->getCompatibleMemoryTypeIndex(requirements.memoryTypeBits, properties);
+        const VkDeviceSize requiredSize = std::max(requirements.size, requirements.alignment);
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (requiredSize > blockSize / 2)
+        {
+            VulkanMemoryAllocation allocation;
+            allocation.memory = allocateDeviceMemory(requirements.size, memoryTypeIndex, allocation.mappedData);
+            allocation.offset = 0;
+            allocation.size = requirements.size;
+            allocation.memoryTypeIndex = memoryTypeIndex;
+            allocation.block = nullptr;
+            allocation.order = 0;
+            return allocation;
+        }
+
+        // Ranges are aligned to their size, power-of-two rounding therefore satisfies alignment requirement as well
+        uint32_t order = 0;
+        while ((minimumAllocationSize << order) < requiredSize)
+        {
+            ++order;
+        }
+
+        VulkanMemoryBlock* block = nullptr;
+        uint32_t freeOrder = 0;
+
+        for (auto& candidate : blocks)
+        {
+            if (candidate->memoryTypeIndex != memoryTypeIndex)
+            {
+                continue;
+            }
+
+            for (uint32_t i = order; i <= maximumOrder; ++i)
+            {
+                if (!candidate->freeRanges[i].empty())
+                {
+                    block = candidate.get();
+                    freeOrder = i;
+                    break;
+                }
+            }
+
+            if (block != nullptr)
+            {
+                break;
+            }
+        }
+
+        if (block == nullptr)
+        {
+            block = createBlock(memoryTypeIndex);
+            freeOrder = maximumOrder;
+        }
+
+        const VkDeviceSize offset = *block->freeRanges[freeOrder].begin();
+        block->freeRanges[freeOrder].erase(block->freeRanges[freeOrder].begin());
+
+        while (freeOrder > order)
+        {
+            --freeOrder;
+            block->freeRanges[freeOrder].insert(offset + (minimumAllocationSize << freeOrder));
+        }
+
+        block->usedBytes += minimumAllocationSize << order;
+
+        VulkanMemoryAllocation allocation;
+        allocation.memory = block->memory;
+        allocation.offset = offset;
+        allocation.size = minimumAllocationSize << order;
+        allocation.memoryTypeIndex = memoryTypeIndex;
+        allocation.mappedData = block->mappedData != nullptr ? static_cast<uint8_t*>(block->mappedData) + offset : nullptr;
+        allocation.block = block;
+        allocation.order = order;
+        return allocation;
+    }
+
+    void free(const VulkanMemoryAllocation& allocation)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (allocation.block == nullptr)
+        {
+            releaseDeviceMemory(allocation.memory, allocation.mappedData);
+            return;
+        }
+
+        VulkanMemoryBlock* block = allocation.block;
+        VkDeviceSize offset = allocation.offset;
+        uint32_t order = allocation.order;
+
+        while (order < maximumOrder)
+        {
+            const VkDeviceSize buddyOffset = offset ^ (minimumAllocationSize << order);
+            auto buddyPointer = block->freeRanges[order].find(buddyOffset);
+
+            if (buddyPointer == block->freeRanges[order].end())
+            {
+                break;
+            }
+
+            block->freeRanges[order].erase(buddyPointer);
+            offset = std::min(offset, buddyOffset);
+            ++order;
+        }
+
+        block->freeRanges[order].insert(offset);
+        block->usedBytes -= allocation.size;
+
+        if (block->usedBytes == 0)
+        {
+            releaseEmptyBlocks(block->memoryTypeIndex);
+        }
+    }
+
+    // Getters
+    VkDeviceSize getBlockSize() const
+    {
+        return blockSize;
+    }
+
+    uint64_t getDeviceAllocationCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return deviceAllocationCount;
+    }
+
+private:
+    // Attributes
+    VkDevice device;
+    const VulkanPhysicalDevice* physicalDevice;
+    VkDeviceSize blockSize;
+    uint32_t maximumOrder;
+    uint64_t deviceAllocationCount;
+    std::vector<std::unique_ptr<VulkanMemoryBlock>> blocks;
+    mutable std::mutex mutex;
+
+    // Helper methods
+    VulkanMemoryBlock* createBlock(const uint32_t memoryTypeIndex)
+    {
+        std::unique_ptr<VulkanMemoryBlock> block(new VulkanMemoryBlock());
+        block->memory = allocateDeviceMemory(blockSize, memoryTypeIndex, block->mappedData);
+        block->memoryTypeIndex = memoryTypeIndex;
+        block->usedBytes = 0;
+        block->freeRanges.resize(maximumOrder + 1);
+        block->freeRanges[maximumOrder].insert(0);
+
+        blocks.push_back(std::move(block));
+        return blocks.back().get();
+    }
+
+    // Keeps single empty block for each memory type, so that repeated creation and destruction of buffers does not reach driver
+    void releaseEmptyBlocks(const uint32_t memoryTypeIndex)
+    {
+        bool emptyBlockKept = false;
+
+        for (auto iterator = blocks.begin(); iterator != blocks.end();)
+        {
+            VulkanMemoryBlock& block = **iterator;
+
+            if (block.memoryTypeIndex != memoryTypeIndex || block.usedBytes != 0)
+            {
+                ++iterator;
+                continue;
+            }
+
+            if (!emptyBlockKept)
+            {
+                emptyBlockKept = true;
+                ++iterator;
+                continue;
+            }
+
+            releaseDeviceMemory(block.memory, block.mappedData);
+            iterator = blocks.erase(iterator);
+        }
+    }
+
+    // Host visible memory is mapped once for its whole lifetime, buffers only receive pointer to their range
+    VkDeviceMemory allocateDeviceMemory(const VkDeviceSize size, const uint32_t memoryTypeIndex, void*& mappedData)
+    {
+        const VkMemoryAllocateInfo memoryAllocateInfo =
+        {
+            VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+            nullptr,
+            size,
+            memoryTypeIndex
+        };
+
+        VkDeviceMemory memory;
+        checkVulkanError(vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &memory), "vkAllocateMemory");
+        ++deviceAllocationCount;
+        mappedData = nullptr;
+
+        const VkPhysicalDeviceMemoryProperties memoryProperties = physicalDevice->getMemoryProperties();
+        if ((memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0)
+        {
+            const VkResult result = vkMapMemory(device, memory, 0, VK_WHOLE_SIZE, 0, &mappedData);
+
+            if (result != VK_SUCCESS)
+            {
+                vkFreeMemory(device, memory, nullptr);
+                checkVulkanError(result, "vkMapMemory");
+            }
+        }
+
+        return memory;
+    }
+
+    void releaseDeviceMemory(VkDeviceMemory memory, void* mappedData)
+    {
+        if (mappedData != nullptr)
+        {
+            vkUnmapMemory(device, memory);
+        }
+
+        vkFreeMemory(device, memory, nullptr);
+    }
+};
+
+} // namespace fly
@@ -72,10 +72,29 @@ public:
         result.setMaxWorkGroupSize(deviceProperties.limits.maxComputeWorkGroupSize[0]);
         result.setMaxConstantBufferSize(deviceProperties.limits.maxUniformBufferRange);
         result.setMaxComputeUnits(0); // to do: find this information for Vulkan API
+        result.setHostUnifiedMemory(hasHostUnifiedMemory());
 
         return result;
     }
 
+    // Integrated and CPU devices which expose device local memory directly to host do not benefit from staged uploads
+    bool hasHostUnifiedMemory() const
+    {
+        const VkPhysicalDeviceType deviceType = getProperties().deviceType;
+
+        if (deviceType != VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU && deviceType != VK_PHYSICAL_DEVICE_TYPE_CPU)
+        {
+            return false;
+        }
+
+        return findMemoryType(~0u, getUnifiedMemoryProperties()) != VK_MAX_MEMORY_TYPES;
+    }
+
+    static VkMemoryPropertyFlags getUnifiedMemoryProperties()
+    {
+        return VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    }
+
     VkPhysicalDeviceProperties getProperties() const
     {
         VkPhysicalDeviceProperties deviceProperties;
@@ -109,6 +128,19 @@ public:
     }
 
     uint32_t getCompatibleMemoryTypeIndex(const uint32_t memoryTypeBits, const VkMemoryPropertyFlags properties) const
+    {
+        const uint32_t index = findMemoryType(memoryTypeBits, properties);
+
+        if (index == VK_MAX_MEMORY_TYPES)
+        {
+            throw std::runtime_error("Physical device does not have any suitable memory types available");
+        }
+
+        return index;
+    }
+
+    // Returns VK_MAX_MEMORY_TYPES if there is no memory type with specified properties
+    uint32_t findMemoryType(const uint32_t memoryTypeBits, const VkMemoryPropertyFlags properties) const
     {
         VkPhysicalDeviceMemoryProperties memoryProperties = getMemoryProperties();
 
@@ -120,7 +152,7 @@ public:
             }
         }
 
-        throw std::runtime_error("Physical device does not have any suitable memory types available");
+        return VK_MAX_MEMORY_TYPES;
     }
 
     static DeviceType getDeviceType(const VkPhysicalDeviceType deviceType)
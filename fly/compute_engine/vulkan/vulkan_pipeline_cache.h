@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <vulkan/vulkan.h>
+#include <fly/compute_engine/vulkan/vulkan_utility.h>
+
+namespace fly
+{
+
+// Driver-side pipeline cache, its data can be serialized and used to initialize cache in another process
+class VulkanPipelineCache
+{
+public:
+    VulkanPipelineCache() :
+        device(nullptr),
+        pipelineCache(nullptr)
+    {}
+
+    explicit VulkanPipelineCache(VkDevice device, const VkPhysicalDeviceProperties& deviceProperties, const std::vector<uint8_t>& initialData) :
+        device(device)
+    {
+        // Some drivers do not validate initial data properly, data produced by different device or driver is dropped here
+        const bool dataValid = isDataCompatible(deviceProperties, initialData);
+
+        const VkPipelineCacheCreateInfo pipelineCacheCreateInfo =
+        {
+            VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+            nullptr,
+            0,
+            dataValid ? initialData.size() : 0,
+            dataValid ? initialData.data() : nullptr
+        };
+
+        checkVulkanError(vkCreatePipelineCache(device, &pipelineCacheCreateInfo, nullptr, &pipelineCache), "vkCreatePipelineCache");
+    }
+
+    ~VulkanPipelineCache()
+    {
+        if (pipelineCache != nullptr)
+        {
+            vkDestroyPipelineCache(device, pipelineCache, nullptr);
+        }
+    }
+
+    VkDevice getDevice() const
+    {
+        return device;
+    }
+
+    VkPipelineCache getPipelineCache() const
+    {
+        return pipelineCache;
+    }
+
+    std::vector<uint8_t> getData() const
+    {
+        size_t dataSize;
+        checkVulkanError(vkGetPipelineCacheData(device, pipelineCache, &dataSize, nullptr), "vkGetPipelineCacheData");
+
+        std::vector<uint8_t> data(dataSize);
+        checkVulkanError(vkGetPipelineCacheData(device, pipelineCache, &dataSize, data.data()), "vkGetPipelineCacheData");
+        data.resize(dataSize);
+        return data;
+    }
+
+private:
+    VkDevice device;
+    VkPipelineCache pipelineCache;
+
+    static bool isDataCompatible(const VkPhysicalDeviceProperties& deviceProperties, const std::vector<uint8_t>& data)
+    {
+        // Header version one: header size, header version, vendor id, device id and pipeline cache UUID
+        const size_t headerSize = 4 * sizeof(uint32_t) + VK_UUID_SIZE;
+
+        if (data.size() < headerSize)
+        {
+            return false;
+        }
+
+        uint32_t header[4];
+        std::memcpy(header, data.data(), sizeof(header));
+
+        return header[0] >= headerSize
+            && header[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+            && header[2] == deviceProperties.vendorID
+            && header[3] == deviceProperties.deviceID
+            && std::memcmp(data.data() + sizeof(header), deviceProperties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+    }
+};
+
+} // namespace fly
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <fly/compute_engine/vulkan/vulkan_pipeline_cache_entry.h>
+
+namespace fly
+{
+
+// Prepared launch pins pipeline from pipeline cache together with its launch geometry
+struct VulkanPreparedPipeline
+{
+public:
+    VulkanPreparedPipeline(std::shared_ptr<VulkanPipelineCacheEntry> pipelineEntry, const std::vector<size_t>& globalSize,
+        const std::vector<size_t>& localSize) :
+        pipelineEntry(pipelineEntry),
+        globalSize(globalSize),
+        localSize(localSize)
+    {}
+
+    std::shared_ptr<VulkanPipelineCacheEntry> pipelineEntry;
+    std::vector<size_t> globalSize;
+    std::vector<size_t> localSize;
+};
+
+} // namespace fly
@@ -1,43 +1,62 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
+#include <vector>
 #include <vulkan/vulkan.h>
 #include <fly/compute_engine/vulkan/vulkan_utility.h>
 
 namespace fly
 {
 
+// Timestamp queries are handed out in slots, each slot holds pair of timestamps for single dispatch, so that kernels running concurrently
+// on multiple queues do not overwrite each other's timings. Additional query pools are created when all slots are in use.
 class VulkanQueryPool
 {
 public:
+    static const uint32_t slotsPerPool = 64;
+
     explicit VulkanQueryPool(VkDevice device, const float timestampPeriod) :
         device(device),
         timestampPeriod(timestampPeriod)
     {
-        const VkQueryPoolCreateInfo queryPoolInfo =
-        {
-            VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
-            nullptr,
-            0,
-            VK_QUERY_TYPE_TIMESTAMP,
-            2,
-            0
-        };
-        
-        checkVulkanError(vkCreateQueryPool(device, &queryPoolInfo, nullptr, &queryPool), "vkCreateQueryPool");
+        addQueryPool();
     }
 
     ~VulkanQueryPool()
     {
-        vkDestroyQueryPool(device, queryPool, nullptr);
+        for (auto queryPool : queryPools)
+        {
+            vkDestroyQueryPool(device, queryPool, nullptr);
+        }
+    }
+
+    VulkanQueryPool(const VulkanQueryPool&) = delete;
+    void operator=(const VulkanQueryPool&) = delete;
+
+    uint32_t acquireSlot()
+    {
+        if (freeSlots.empty())
+        {
+            addQueryPool();
+        }
+
+        const uint32_t slot = freeSlots.back();
+        freeSlots.pop_back();
+        return slot;
+    }
+
+    void releaseSlot(const uint32_t slot)
+    {
+        freeSlots.push_back(slot);
     }
 
-    uint64_t getResult() const
+    uint64_t getResult(const uint32_t slot) const
     {
         std::array<uint64_t, 2> timestamps;
 
-        checkVulkanError(vkGetQueryPoolResults(device, queryPool, 0, 2, 2 * sizeof(uint64_t), timestamps.data(), 0,
-            VK_QUERY_RESULT_WAIT_BIT | VK_QUERY_RESULT_64_BIT), "vkGetQueryPoolResults");
+        checkVulkanError(vkGetQueryPoolResults(device, getQueryPool(slot), getFirstQuery(slot), 2, 2 * sizeof(uint64_t), timestamps.data(),
+            sizeof(uint64_t), VK_QUERY_RESULT_WAIT_BIT | VK_QUERY_RESULT_64_BIT), "vkGetQueryPoolResults");
 
         const uint64_t difference = timestamps[1] - timestamps[0];
         return static_cast<uint64_t>(difference * timestampPeriod);
@@ -48,9 +67,14 @@ public:
         return device;
     }
 
-    VkQueryPool getQueryPool() const
+    VkQueryPool getQueryPool(const uint32_t slot) const
     {
-        return queryPool;
+        return queryPools.at(slot / slotsPerPool);
+    }
+
+    uint32_t getFirstQuery(const uint32_t slot) const
+    {
+        return (slot % slotsPerPool) * 2;
     }
 
     float getTimestampPeriod() const
@@ -60,8 +84,34 @@ public:
 
 private:
     VkDevice device;
-    VkQueryPool queryPool;
+    std::vector<VkQueryPool> queryPools;
+    std::vector<uint32_t> freeSlots;
     float timestampPeriod;
+
+    void addQueryPool()
+    {
+        const VkQueryPoolCreateInfo queryPoolInfo =
+        {
+            VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+            nullptr,
+            0,
+            VK_QUERY_TYPE_TIMESTAMP,
+            2 * slotsPerPool,
+            0
+        };
+
+        VkQueryPool queryPool;
+        checkVulkanError(vkCreateQueryPool(device, &queryPoolInfo, nullptr, &queryPool), "vkCreateQueryPool");
+
+        const uint32_t firstSlot = static_cast<uint32_t>(queryPools.size()) * slotsPerPool;
+        queryPools.push_back(queryPool);
+
+        // Slots are taken from the back, lower slots are used first
+        for (uint32_t i = slotsPerPool; i > 0; --i)
+        {
+            freeSlots.push_back(firstSlot + i - 1);
+        }
+    }
 };
 
 } // namespace fly
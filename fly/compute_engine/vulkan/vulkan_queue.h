@@ -1,5 +1,6 @@
 #pragma once
 
+#include <vector>
 #include <vulkan/vulkan.h>
 #include <fly/compute_engine/vulkan/vulkan_utility.h>
 
@@ -56,6 +57,46 @@ public:
         checkVulkanError(vkQueueSubmit(queue, 1, &submitInfo, fence), "vkQueueSubmit");
     }
 
+    // Command execution starts only after all wait semaphores are signaled
+    void submitSingleCommand(VkCommandBuffer commandBuffer, VkFence fence, const std::vector<VkSemaphore>& waitSemaphores) const
+    {
+        const std::vector<VkPipelineStageFlags> waitStages(waitSemaphores.size(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+
+        const VkSubmitInfo submitInfo =
+        {
+            VK_STRUCTURE_TYPE_SUBMIT_INFO,
+            nullptr,
+            static_cast<uint32_t>(waitSemaphores.size()),
+            waitSemaphores.data(),
+            waitStages.data(),
+            1,
+            &commandBuffer,
+            0,
+            nullptr
+        };
+
+        checkVulkanError(vkQueueSubmit(queue, 1, &submitInfo, fence), "vkQueueSubmit");
+    }
+
+    // Semaphore is signaled once all commands submitted to the queue so far complete
+    void signalSemaphore(VkSemaphore semaphore) const
+    {
+        const VkSubmitInfo submitInfo =
+        {
+            VK_STRUCTURE_TYPE_SUBMIT_INFO,
+            nullptr,
+            0,
+            nullptr,
+            nullptr,
+            0,
+            nullptr,
+            1,
+            &semaphore
+        };
+
+        checkVulkanError(vkQueueSubmit(queue, 1, &submitInfo, nullptr), "vkQueueSubmit");
+    }
+
 private:
     VkQueue queue;
     VkQueueFlagBits queueType;
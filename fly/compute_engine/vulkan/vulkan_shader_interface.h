@@ -0,0 +1,196 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace fly
+{
+
+// Buffer binding declared by shader, binding number is equal to index of the corresponding kernel argument
+struct VulkanShaderBinding
+{
+    uint32_t binding;
+    VkDescriptorType descriptorType;
+};
+
+// Resources used by shader, collected from SPIR-V module. Vector arguments are bound either as storage buffers or as uniform buffers,
+// depending on how the shader declares them. Scalar arguments are stored in push constant block, in the order of its members.
+class VulkanShaderInterface
+{
+public:
+    // Constructor
+    VulkanShaderInterface() :
+        pushConstantBlockFlag(false)
+    {}
+
+    // Getters
+    const std::vector<VulkanShaderBinding>& getBindings() const
+    {
+        return bindings;
+    }
+
+    bool hasPushConstantBlock() const
+    {
+        return pushConstantBlockFlag;
+    }
+
+    const std::vector<uint32_t>& getPushConstantOffsets() const
+    {
+        return pushConstantOffsets;
+    }
+
+    static VulkanShaderInterface reflect(const std::vector<uint32_t>& spirvSource)
+    {
+        const uint32_t spirvHeaderSize = 5;
+        const uint16_t opTypeStruct = 30;
+        const uint16_t opTypePointer = 32;
+        const uint16_t opVariable = 59;
+        const uint16_t opDecorate = 71;
+        const uint16_t opMemberDecorate = 72;
+        const uint32_t decorationBlock = 2;
+        const uint32_t decorationBufferBlock = 3;
+        const uint32_t decorationBinding = 33;
+        const uint32_t decorationDescriptorSet = 34;
+        const uint32_t decorationOffset = 35;
+        const uint32_t storageClassUniform = 2;
+        const uint32_t storageClassPushConstant = 9;
+        const uint32_t storageClassStorageBuffer = 12;
+
+        std::map<uint32_t, uint32_t> bindingDecorations;
+        std::map<uint32_t, uint32_t> descriptorSets;
+        std::map<uint32_t, bool> bufferBlocks;
+        std::map<uint32_t, std::map<uint32_t, uint32_t>> memberOffsets;
+        std::map<uint32_t, uint32_t> structMemberCounts;
+        std::map<uint32_t, uint32_t> pointerTypes;
+        std::map<uint32_t, std::pair<uint32_t, uint32_t>> variables;
+
+        size_t position = spirvHeaderSize;
+
+        while (position < spirvSource.size())
+        {
+            const uint16_t opcode = static_cast<uint16_t>(spirvSource[position] & 0xFFFF);
+            const uint16_t wordCount = static_cast<uint16_t>(spirvSource[position] >> 16);
+
+            if (wordCount == 0 || position + wordCount > spirvSource.size())
+            {
+                throw std::runtime_error("Malformed SPIR-V module");
+            }
+
+            const uint32_t* operands = &spirvSource[position + 1];
+
+            if (opcode == opDecorate && wordCount > 3 && operands[1] == decorationBinding)
+            {
+                bindingDecorations[operands[0]] = operands[2];
+            }
+            else if (opcode == opDecorate && wordCount > 3 && operands[1] == decorationDescriptorSet)
+            {
+                descriptorSets[operands[0]] = operands[2];
+            }
+            else if (opcode == opDecorate && wordCount > 2 && (operands[1] == decorationBlock || operands[1] == decorationBufferBlock))
+            {
+                bufferBlocks[operands[0]] = operands[1] == decorationBufferBlock;
+            }
+            else if (opcode == opMemberDecorate && wordCount > 4 && operands[2] == decorationOffset)
+            {
+                memberOffsets[operands[0]][operands[1]] = operands[3];
+            }
+            else if (opcode == opTypeStruct)
+            {
+                structMemberCounts[operands[0]] = static_cast<uint32_t>(wordCount - 2);
+            }
+            else if (opcode == opTypePointer && wordCount > 3)
+            {
+                pointerTypes[operands[0]] = operands[2];
+            }
+            else if (opcode == opVariable && wordCount > 3)
+            {
+                variables[operands[1]] = std::make_pair(operands[0], operands[2]);
+            }
+
+            position += wordCount;
+        }
+
+        VulkanShaderInterface result;
+
+        for (const auto& variable : variables)
+        {
+            const uint32_t storageClass = variable.second.second;
+
+            if (storageClass != storageClassUniform && storageClass != storageClassPushConstant && storageClass != storageClassStorageBuffer)
+            {
+                continue;
+            }
+
+            auto typePointer = pointerTypes.find(variable.second.first);
+            if (typePointer == pointerTypes.end())
+            {
+                continue;
+            }
+
+            const uint32_t blockType = typePointer->second;
+
+            if (storageClass == storageClassPushConstant)
+            {
+                const uint32_t memberCount = structMemberCounts[blockType];
+                const std::map<uint32_t, uint32_t>& offsets = memberOffsets[blockType];
+
+                for (uint32_t i = 0; i < memberCount; ++i)
+                {
+                    auto offsetPointer = offsets.find(i);
+                    if (offsetPointer == offsets.end())
+                    {
+                        throw std::runtime_error("Push constant block member is missing offset decoration");
+                    }
+
+                    result.pushConstantOffsets.push_back(offsetPointer->second);
+                }
+
+                result.pushConstantBlockFlag = true;
+                continue;
+            }
+
+            auto bindingPointer = bindingDecorations.find(variable.first);
+            if (bindingPointer == bindingDecorations.end())
+            {
+                continue;
+            }
+
+            auto setPointer = descriptorSets.find(variable.first);
+            if (setPointer != descriptorSets.end() && setPointer->second != 0)
+            {
+                throw std::runtime_error(std::string("Only descriptor set 0 is supported, binding ") + std::to_string(bindingPointer->second)
+                    + " uses descriptor set " + std::to_string(setPointer->second));
+            }
+
+            // Storage buffers are emitted either in StorageBuffer storage class or as Uniform blocks decorated with BufferBlock
+            const bool uniformBlock = storageClass == storageClassUniform && !bufferBlocks[blockType];
+            const VulkanShaderBinding binding =
+            {
+                bindingPointer->second,
+                uniformBlock ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
+            };
+
+            result.bindings.push_back(binding);
+        }
+
+        std::sort(result.bindings.begin(), result.bindings.end(), [](const VulkanShaderBinding& first, const VulkanShaderBinding& second)
+        {
+            return first.binding < second.binding;
+        });
+
+        return result;
+    }
+
+private:
+    // Attributes
+    std::vector<VulkanShaderBinding> bindings;
+    bool pushConstantBlockFlag;
+    std::vector<uint32_t> pushConstantOffsets;
+};
+
+} // namespace fly
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <vector>
 #include <vulkan/vulkan.h>
 #include <fly/compute_engine/vulkan/shaderc_compiler.h>
+#include <fly/compute_engine/vulkan/vulkan_shader_interface.h>
+#include <fly/compute_engine/vulkan/vulkan_specialization.h>
 #include <fly/compute_engine/vulkan/vulkan_utility.h>
 
 namespace fly
@@ -18,25 +22,23 @@ public:
         source("")
     {}
 
-    explicit VulkanShaderModule(VkDevice device, const std::string& name, const std::string& source, const std::vector<size_t>& localSize,
-        const std::vector<ParameterPair>& parameterPairs) :
+    explicit VulkanShaderModule(VkDevice device, const std::string& name, const std::string& source, const std::vector<size_t>& localSize) :
         device(device),
         name(name),
         source(source)
     {
-        
-        spirvSource = ShadercCompiler::getCompiler().compile(name, source, VK_SHADER_STAGE_COMPUTE_BIT, localSize, parameterPairs);
-
-        const VkShaderModuleCreateInfo shaderModuleCreateInfo =
-        {
-            VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
-            nullptr,
-            0,
-            spirvSource.size() * sizeof(uint32_t),
-            spirvSource.data()
-        };
+        spirvSource = ShadercCompiler::getCompiler().compile(name, source, VK_SHADER_STAGE_COMPUTE_BIT, localSize);
+        createShaderModule();
+    }
 
-        checkVulkanError(vkCreateShaderModule(device, &shaderModuleCreateInfo, nullptr, &shaderModule), "vkCreateShaderModule");
+    // Shader module is created from SPIR-V compiled previously, source is kept only for informational purposes
+    explicit VulkanShaderModule(VkDevice device, const std::string& name, const std::string& source, const std::vector<uint32_t>& spirvSource) :
+        device(device),
+        name(name),
+        source(source),
+        spirvSource(spirvSource)
+    {
+        createShaderModule();
     }
 
     ~VulkanShaderModule()
@@ -72,12 +74,41 @@ public:
         return spirvSource;
     }
 
+    const std::vector<VulkanSpecializationConstant>& getSpecializationConstants() const
+    {
+        return specializationConstants;
+    }
+
+    const VulkanShaderInterface& getShaderInterface() const
+    {
+        return shaderInterface;
+    }
+
 private:
     VkDevice device;
     VkShaderModule shaderModule;
     std::string name;
     std::string source;
     std::vector<uint32_t> spirvSource;
+    std::vector<VulkanSpecializationConstant> specializationConstants;
+    VulkanShaderInterface shaderInterface;
+
+    void createShaderModule()
+    {
+        specializationConstants = VulkanSpecialization::reflectConstants(spirvSource);
+        shaderInterface = VulkanShaderInterface::reflect(spirvSource);
+
+        const VkShaderModuleCreateInfo shaderModuleCreateInfo =
+        {
+            VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+            nullptr,
+            0,
+            spirvSource.size() * sizeof(uint32_t),
+            spirvSource.data()
+        };
+
+        checkVulkanError(vkCreateShaderModule(device, &shaderModuleCreateInfo, nullptr, &shaderModule), "vkCreateShaderModule");
+    }
 };
 
 } // namespace fly
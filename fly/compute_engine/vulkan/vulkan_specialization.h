@@ -0,0 +1,269 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+#include <fly/api/parameter_pair.h>
+
+namespace fly
+{
+
+enum class VulkanSpecializationType
+{
+    Bool,
+    Int,
+    UnsignedInt,
+    Float
+};
+
+// Specialization constant declared by shader, e.g. layout(constant_id = 3) const uint TILE_SIZE = 16;
+struct VulkanSpecializationConstant
+{
+    uint32_t constantId;
+    std::string name;
+    VulkanSpecializationType type;
+    uint32_t width;
+    // Index of work-group size dimension if constant is referenced by layout(local_size_x_id = ...), otherwise -1
+    int localSizeDimension;
+};
+
+// Maps tuning parameters and local size of single configuration to specialization constants of shader, so that one SPIR-V module can be
+// reused by pipelines of all configurations. Parameters are matched with constants by name, local size by work-group size built-in.
+class VulkanSpecialization
+{
+public:
+    // Constructor
+    explicit VulkanSpecialization(const std::vector<VulkanSpecializationConstant>& constants, const std::vector<size_t>& localSize,
+        const std::vector<ParameterPair>& parameterPairs)
+    {
+        for (const auto& constant : constants)
+        {
+            if (constant.localSizeDimension >= 0)
+            {
+                addConstant(constant, static_cast<double>(localSize.at(static_cast<size_t>(constant.localSizeDimension))));
+                continue;
+            }
+
+            for (const auto& pair : parameterPairs)
+            {
+                if (pair.getName() == constant.name)
+                {
+                    addConstant(constant, pair.hasValueDouble() ? pair.getValueDouble() : static_cast<double>(pair.getValue()));
+                    break;
+                }
+            }
+        }
+
+        specializationInfo.mapEntryCount = static_cast<uint32_t>(mapEntries.size());
+        specializationInfo.pMapEntries = mapEntries.data();
+        specializationInfo.dataSize = data.size();
+        specializationInfo.pData = data.data();
+    }
+
+    VulkanSpecialization(const VulkanSpecialization&) = delete;
+    void operator=(const VulkanSpecialization&) = delete;
+
+    // Getters
+    const VkSpecializationInfo* getSpecializationInfo() const
+    {
+        if (mapEntries.empty())
+        {
+            return nullptr;
+        }
+
+        return &specializationInfo;
+    }
+
+    // Collects specialization constants from SPIR-V module, their names are taken from debug information emitted by GLSL compiler
+    static std::vector<VulkanSpecializationConstant> reflectConstants(const std::vector<uint32_t>& spirvSource)
+    {
+        const uint32_t spirvHeaderSize = 5;
+        const uint16_t opName = 5;
+        const uint16_t opTypeBool = 20;
+        const uint16_t opTypeInt = 21;
+        const uint16_t opTypeFloat = 22;
+        const uint16_t opSpecConstantTrue = 48;
+        const uint16_t opSpecConstantFalse = 49;
+        const uint16_t opSpecConstant = 50;
+        const uint16_t opSpecConstantComposite = 51;
+        const uint16_t opDecorate = 71;
+        const uint32_t decorationSpecId = 1;
+        const uint32_t decorationBuiltIn = 11;
+        const uint32_t builtInWorkgroupSize = 25;
+
+        std::map<uint32_t, std::string> names;
+        std::map<uint32_t, uint32_t> specIds;
+        std::map<uint32_t, std::pair<VulkanSpecializationType, uint32_t>> types;
+        std::map<uint32_t, uint32_t> constantTypes;
+        std::map<uint32_t, std::vector<uint32_t>> composites;
+        std::vector<uint32_t> workgroupSizeIds;
+
+        size_t position = spirvHeaderSize;
+
+        while (position < spirvSource.size())
+        {
+            const uint16_t opcode = static_cast<uint16_t>(spirvSource[position] & 0xFFFF);
+            const uint16_t wordCount = static_cast<uint16_t>(spirvSource[position] >> 16);
+
+            if (wordCount == 0 || position + wordCount > spirvSource.size())
+            {
+                throw std::runtime_error("Malformed SPIR-V module");
+            }
+
+            const uint32_t* operands = &spirvSource[position + 1];
+
+            if (opcode == opName && wordCount > 2)
+            {
+                names[operands[0]] = std::string(reinterpret_cast<const char*>(&operands[1]));
+            }
+            else if (opcode == opDecorate && wordCount > 3 && operands[1] == decorationSpecId)
+            {
+                specIds[operands[0]] = operands[2];
+            }
+            else if (opcode == opDecorate && wordCount > 3 && operands[1] == decorationBuiltIn && operands[2] == builtInWorkgroupSize)
+            {
+                workgroupSizeIds.push_back(operands[0]);
+            }
+            else if (opcode == opTypeBool)
+            {
+                types[operands[0]] = std::make_pair(VulkanSpecializationType::Bool, 32u);
+            }
+            else if (opcode == opTypeInt)
+            {
+                types[operands[0]] = std::make_pair(operands[2] != 0 ? VulkanSpecializationType::Int : VulkanSpecializationType::UnsignedInt,
+                    operands[1]);
+            }
+            else if (opcode == opTypeFloat)
+            {
+                types[operands[0]] = std::make_pair(VulkanSpecializationType::Float, operands[1]);
+            }
+            else if (opcode == opSpecConstantTrue || opcode == opSpecConstantFalse || opcode == opSpecConstant)
+            {
+                constantTypes[operands[1]] = operands[0];
+            }
+            else if (opcode == opSpecConstantComposite)
+            {
+                composites[operands[1]] = std::vector<uint32_t>(&operands[2], &operands[wordCount - 1]);
+            }
+
+            position += wordCount;
+        }
+
+        std::map<uint32_t, int> localSizeDimensions;
+
+        for (const auto id : workgroupSizeIds)
+        {
+            auto compositePointer = composites.find(id);
+
+            if (compositePointer == composites.end())
+            {
+                continue;
+            }
+
+            for (size_t i = 0; i < compositePointer->second.size(); ++i)
+            {
+                localSizeDimensions[compositePointer->second[i]] = static_cast<int>(i);
+            }
+        }
+
+        std::vector<VulkanSpecializationConstant> result;
+
+        for (const auto& constantType : constantTypes)
+        {
+            auto specIdPointer = specIds.find(constantType.first);
+            auto typePointer = types.find(constantType.second);
+
+            if (specIdPointer == specIds.end() || typePointer == types.end())
+            {
+                continue;
+            }
+
+            auto namePointer = names.find(constantType.first);
+            auto dimensionPointer = localSizeDimensions.find(constantType.first);
+
+            VulkanSpecializationConstant constant;
+            constant.constantId = specIdPointer->second;
+            constant.name = namePointer != names.end() ? namePointer->second : std::string("");
+            constant.type = typePointer->second.first;
+            constant.width = typePointer->second.second;
+            constant.localSizeDimension = dimensionPointer != localSizeDimensions.end() ? dimensionPointer->second : -1;
+            result.push_back(constant);
+        }
+
+        return result;
+    }
+
+private:
+    // Attributes
+    std::vector<VkSpecializationMapEntry> mapEntries;
+    std::vector<uint8_t> data;
+    VkSpecializationInfo specializationInfo;
+
+    // Helper methods
+    void addConstant(const VulkanSpecializationConstant& constant, const double value)
+    {
+        uint8_t bytes[8];
+        size_t size = constant.width / 8;
+
+        switch (constant.type)
+        {
+        case VulkanSpecializationType::Bool:
+        {
+            const VkBool32 boolValue = value != 0.0 ? VK_TRUE : VK_FALSE;
+            size = sizeof(VkBool32);
+            std::memcpy(bytes, &boolValue, size);
+            break;
+        }
+        case VulkanSpecializationType::Int:
+        case VulkanSpecializationType::UnsignedInt:
+        {
+            if (size == 0 || size > sizeof(uint64_t))
+            {
+                throw std::runtime_error(std::string("Unsupported width of integer specialization constant: ") + constant.name);
+            }
+
+            // Integers are stored in little-endian order, lower bytes hold the value for all widths
+            const uint64_t integerValue = constant.type == VulkanSpecializationType::Int
+                ? static_cast<uint64_t>(static_cast<int64_t>(value)) : static_cast<uint64_t>(value);
+            for (size_t i = 0; i < size; ++i)
+            {
+                bytes[i] = static_cast<uint8_t>(integerValue >> (8 * i));
+            }
+            break;
+        }
+        case VulkanSpecializationType::Float:
+            if (size == sizeof(float))
+            {
+                const float floatValue = static_cast<float>(value);
+                std::memcpy(bytes, &floatValue, size);
+            }
+            else if (size == sizeof(double))
+            {
+                std::memcpy(bytes, &value, size);
+            }
+            else
+            {
+                throw std::runtime_error(std::string("Unsupported width of floating-point specialization constant: ") + constant.name);
+            }
+            break;
+        default:
+            throw std::runtime_error("Unknown specialization constant type");
+        }
+
+        const VkSpecializationMapEntry entry =
+        {
+            constant.constantId,
+            static_cast<uint32_t>(data.size()),
+            size
+        };
+
+        mapEntries.push_back(entry);
+        data.insert(data.end(), bytes, bytes + size);
+    }
+};
+
+} // namespace fly
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vulkan/vulkan.h>
+#include <fly/compute_engine/vulkan/vulkan_buffer.h>
+#include <fly/compute_engine/vulkan/vulkan_memory_allocator.h>
+#include <fly/compute_engine/vulkan/vulkan_physical_device.h>
+
+namespace fly
+{
+
+// Persistently mapped host buffer used for staging of transfers between host and device buffers. Ranges are reserved in circular order
+// and tagged by transfer batch, range becomes reusable once its batch and all batches reserved before it are retired.
+class VulkanStagingRing
+{
+public:
+    static const VkDeviceSize defaultCapacity = 16 * 1024 * 1024;
+    static const VkDeviceSize rangeAlignment = 256;
+
+    // Constructor
+    explicit VulkanStagingRing(VkDevice device, const VulkanPhysicalDevice& physicalDevice, VulkanMemoryAllocator& allocator,
+        const VkDeviceSize capacity = defaultCapacity) :
+        buffer(device, physicalDevice, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, capacity),
+        capacity(capacity),
+        head(0)
+    {
+        buffer.allocateMemory(allocator, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    }
+
+    // Core methods
+    bool tryReserve(const VkDeviceSize size, const uint64_t batchId, VkDeviceSize& offset)
+    {
+        const VkDeviceSize alignedSize = (size + rangeAlignment - 1) / rangeAlignment * rangeAlignment;
+
+        if (alignedSize == 0 || alignedSize > capacity)
+        {
+            return false;
+        }
+
+        if (ranges.empty())
+        {
+            offset = 0;
+        }
+        else
+        {
+            const VkDeviceSize tail = ranges.front().offset;
+
+            if (head > tail && capacity - head >= alignedSize)
+            {
+                offset = head;
+            }
+            else if (head > tail && tail >= alignedSize)
+            {
+                offset = 0;
+            }
+            else if (head < tail && tail - head >= alignedSize)
+            {
+                offset = head;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        ranges.push_back(StagingRange{offset, batchId, false});
+        head = offset + alignedSize;
+        return true;
+    }
+
+    void retire(const uint64_t batchId)
+    {
+        for (auto& range : ranges)
+        {
+            if (range.batchId == batchId)
+            {
+                range.retired = true;
+            }
+        }
+
+        while (!ranges.empty() && ranges.front().retired)
+        {
+            ranges.pop_front();
+        }
+    }
+
+    // Getters
+    VkBuffer getBuffer() const
+    {
+        return buffer.getBuffer();
+    }
+
+    VkDeviceSize getCapacity() const
+    {
+        return capacity;
+    }
+
+    void* getMappedData(const VkDeviceSize offset) const
+    {
+        return static_cast<uint8_t*>(buffer.getAllocation().mappedData) + offset;
+    }
+
+private:
+    struct StagingRange
+    {
+        VkDeviceSize offset;
+        uint64_t batchId;
+        bool retired;
+    };
+
+    // Attributes
+    VulkanBuffer buffer;
+    VkDeviceSize capacity;
+    VkDeviceSize head;
+    std::deque<StagingRange> ranges;
+};
+
+} // namespace fly
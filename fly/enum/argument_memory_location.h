@@ -26,7 +26,13 @@ enum class ArgumentMemoryLocation
       * that even when this flag is used, extra buffer copy is still sometimes created internally by compute API. This behaviour depends on particular
       * API and device.
       */
-    HostZeroCopy
+    HostZeroCopy,
+
+    /** Memory location will be selected automatically based on properties of device. Host memory is used on devices which share memory with
+      * host, eg. CPUs and integrated GPUs, read-only arguments are accessed without extra buffer if compute API supports it. Device memory is used
+      * on devices with dedicated memory.
+      */
+    Auto
 };
 
 } // namespace fly
@@ -21,7 +21,11 @@ enum class ComputeAPI
 
     /** Tuner will use Vulkan as compute API.
     */
-    Vulkan
+    Vulkan,
+
+    /** Tuner will execute native C++ kernel functions on host CPU threads. Kernels have to be added with Tuner::addHostKernel() method.
+      */
+    Host
 };
 
 } // namespace fly
@@ -0,0 +1,25 @@
+/** @file kernel_cache_eviction_policy.h
+  * Definition of enum for eviction policy of compiled kernel cache.
+  */
+#pragma once
+
+namespace fly
+{
+
+/** @enum KernelCacheEvictionPolicy
+  * Enum for eviction policy of compiled kernel cache. Specifies which kernel is removed from the cache once its capacity or byte budget
+  * is exceeded.
+  */
+enum class KernelCacheEvictionPolicy
+{
+    /** Least recently used kernel is removed from the cache.
+      */
+    LeastRecentlyUsed,
+
+    /** Kernels are removed based on their recency weighted by measured build time (GreedyDual algorithm). Kernels which are expensive
+      * to compile stay in the cache longer than cheap ones.
+      */
+    CostAware
+};
+
+} // namespace fly
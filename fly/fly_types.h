@@ -37,6 +37,11 @@ using QueueId = uint32_t;
   * Data type for referencing compute API events in Fly.
   */
 using EventId = uint64_t;
+
+/** @typedef LaunchId
+  * Data type for referencing prepared kernel launches in Fly.
+  */
+using LaunchId = uint64_t;
     
     
  
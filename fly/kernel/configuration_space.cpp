@@ -0,0 +1,531 @@
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <fly/kernel/configuration_space.h>
+
+namespace fly
+{
+
+static uint64_t multiplySize(const uint64_t first, const uint64_t second)
+{
+    if (second != 0 && first > std::numeric_limits<uint64_t>::max() / second)
+    {
+        throw std::runtime_error("Configuration space is too large to be indexed");
+    }
+    return first * second;
+}
+
+static size_t findParameter(const std::vector<KernelParameter>& parameters, const std::string& name)
+{
+    for (size_t i = 0; i < parameters.size(); ++i)
+    {
+        if (parameters[i].getName() == name)
+        {
+            return i;
+        }
+    }
+
+    throw std::runtime_error(std::string("Parameter with given name does not exist: ") + name);
+}
+
+static size_t findRoot(std::vector<size_t>& parents, size_t element)
+{
+    while (parents[element] != element)
+    {
+        parents[element] = parents[parents[element]];
+        element = parents[element];
+    }
+    return element;
+}
+
+static void mergeGroups(std::vector<size_t>& parents, const size_t first, const size_t second)
+{
+    const size_t firstRoot = findRoot(parents, first);
+    const size_t secondRoot = findRoot(parents, second);
+
+    // Smaller index becomes root, so that subspaces are ordered by their first parameter
+    parents[std::max(firstRoot, secondRoot)] = std::min(firstRoot, secondRoot);
+}
+
+ConfigurationSubspace::ConfigurationSubspace(const std::vector<KernelParameter>& parameters, const std::vector<KernelConstraint>& constraints) :
+    parameters(parameters),
+    strides(parameters.size()),
+    constraintsByDepth(parameters.size()),
+    size(1)
+{
+    for (size_t depth = parameters.size(); depth > 0; --depth)
+    {
+        strides[depth - 1] = size;
+        size = multiplySize(size, parameters[depth - 1].getValues().size());
+    }
+
+    for (const auto& constraint : constraints)
+    {
+        ConstraintCheck check;
+        check.function = constraint.getConstraintFunction();
+        size_t lastDepth = 0;
+
+        for (const auto& parameterName : constraint.getParameterNames())
+        {
+            const size_t depth = findParameter(parameters, parameterName);
+            check.depths.push_back(depth);
+            lastDepth = std::max(lastDepth, depth);
+        }
+
+        // Constraint is evaluated as soon as all of its parameters are assigned
+        constraintsByDepth[lastDepth].push_back(check);
+    }
+}
+
+bool ConfigurationSubspace::isValid(const uint64_t index) const
+{
+    if (index >= size)
+    {
+        return false;
+    }
+
+    const std::vector<size_t> digits = getDigits(index);
+
+    for (size_t depth = 0; depth < parameters.size(); ++depth)
+    {
+        if (!checkConstraints(depth, digits))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+uint64_t ConfigurationSubspace::getNextValidIndex(const uint64_t index) const
+{
+    if (index >= size)
+    {
+        return size;
+    }
+
+    std::vector<size_t> digits = getDigits(index);
+    size_t depth = 0;
+
+    while (depth < parameters.size())
+    {
+        if (checkConstraints(depth, digits))
+        {
+            ++depth;
+            continue;
+        }
+
+        // Partial assignment is invalid, whole subtree below it is skipped
+        for (size_t i = depth + 1; i < parameters.size(); ++i)
+        {
+            digits[i] = 0;
+        }
+
+        while (++digits[depth] == parameters[depth].getValues().size())
+        {
+            digits[depth] = 0;
+
+            if (depth == 0)
+            {
+                return size;
+            }
+            --depth;
+        }
+    }
+
+    uint64_t result = 0;
+    for (size_t i = 0; i < parameters.size(); ++i)
+    {
+        result += digits[i] * strides[i];
+    }
+    return result;
+}
+
+uint64_t ConfigurationSubspace::getValidCount() const
+{
+    std::vector<size_t> digits(parameters.size(), 0);
+    return countValid(0, digits);
+}
+
+void ConfigurationSubspace::appendConfiguration(const uint64_t index, std::vector<ParameterPair>& configuration) const
+{
+    if (index >= size)
+    {
+        throw std::runtime_error(std::string("Configuration index is out of range: ") + std::to_string(index));
+    }
+
+    const std::vector<size_t> digits = getDigits(index);
+
+    for (size_t i = 0; i < parameters.size(); ++i)
+    {
+        if (parameters[i].hasValuesDouble())
+        {
+            configuration.push_back(ParameterPair(parameters[i].getName(), parameters[i].getValuesDouble()[digits[i]]));
+        }
+        else
+        {
+            configuration.push_back(ParameterPair(parameters[i].getName(), parameters[i].getValues()[digits[i]]));
+        }
+    }
+}
+
+uint64_t ConfigurationSubspace::getIndex(const std::vector<ParameterPair>& configuration) const
+{
+    uint64_t result = 0;
+
+    for (size_t i = 0; i < parameters.size(); ++i)
+    {
+        auto pair = std::find_if(configuration.cbegin(), configuration.cend(),
+            [this, i](const ParameterPair& element) { return element.getName() == parameters[i].getName(); });
+
+        if (pair == configuration.cend())
+        {
+            throw std::runtime_error(std::string("Configuration does not contain value for parameter: ") + parameters[i].getName());
+        }
+
+        const std::vector<double>& values = parameters[i].getValuesDouble();
+        bool valueFound = false;
+
+        for (size_t digit = 0; digit < values.size(); ++digit)
+        {
+            const bool equal = parameters[i].hasValuesDouble() ? values[digit] == pair->getValueDouble()
+                : parameters[i].getValues()[digit] == pair->getValue();
+
+            if (equal)
+            {
+                result += digit * strides[i];
+                valueFound = true;
+                break;
+            }
+        }
+
+        if (!valueFound)
+        {
+            throw std::runtime_error(std::string("Configuration contains invalid value for parameter: ") + parameters[i].getName());
+        }
+    }
+
+    return result;
+}
+
+uint64_t ConfigurationSubspace::getSize() const
+{
+    return size;
+}
+
+const std::vector<KernelParameter>& ConfigurationSubspace::getParameters() const
+{
+    return parameters;
+}
+
+std::vector<size_t> ConfigurationSubspace::getDigits(const uint64_t index) const
+{
+    std::vector<size_t> digits(parameters.size());
+
+    for (size_t i = 0; i < parameters.size(); ++i)
+    {
+        digits[i] = static_cast<size_t>((index / strides[i]) % parameters[i].getValues().size());
+    }
+
+    return digits;
+}
+
+bool ConfigurationSubspace::checkConstraints(const size_t depth, const std::vector<size_t>& digits) const
+{
+    std::vector<size_t> values;
+
+    for (const auto& check : constraintsByDepth[depth])
+    {
+        values.clear();
+
+        for (const auto constraintDepth : check.depths)
+        {
+            values.push_back(parameters[constraintDepth].getValues()[digits[constraintDepth]]);
+        }
+
+        if (!check.function(values))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+uint64_t ConfigurationSubspace::countValid(const size_t depth, std::vector<size_t>& digits) const
+{
+    bool constraintsRemaining = false;
+
+    for (size_t i = depth; i < parameters.size(); ++i)
+    {
+        constraintsRemaining = constraintsRemaining || !constraintsByDepth[i].empty();
+    }
+
+    // Subtree without constraints is counted without being expanded
+    if (!constraintsRemaining)
+    {
+        return depth == 0 ? size : strides[depth - 1];
+    }
+
+    uint64_t result = 0;
+
+    for (size_t digit = 0; digit < parameters[depth].getValues().size(); ++digit)
+    {
+        digits[depth] = digit;
+
+        if (checkConstraints(depth, digits))
+        {
+            result += countValid(depth + 1, digits);
+        }
+    }
+
+    return result;
+}
+
+ConfigurationSpace::ConfigurationSpace(const std::vector<KernelParameter>& parameters, const std::vector<KernelConstraint>& constraints,
+    const std::vector<KernelParameterPack>& packs) :
+    size(1)
+{
+    std::vector<size_t> parents(parameters.size());
+    std::vector<bool> packed(parameters.size(), false);
+
+    for (size_t i = 0; i < parents.size(); ++i)
+    {
+        parents[i] = i;
+    }
+
+    for (const auto& pack : packs)
+    {
+        const auto& names = pack.getParameterNames();
+
+        for (const auto& name : names)
+        {
+            const size_t index = findParameter(parameters, name);
+            mergeGroups(parents, findParameter(parameters, names[0]), index);
+            packed[index] = true;
+        }
+    }
+
+    // Parameters outside of packs are tuned together
+    size_t firstUnpacked = parameters.size();
+
+    for (size_t i = 0; i < parameters.size(); ++i)
+    {
+        if (!packed[i])
+        {
+            firstUnpacked = std::min(firstUnpacked, i);
+            mergeGroups(parents, firstUnpacked, i);
+        }
+    }
+
+    for (const auto& constraint : constraints)
+    {
+        const auto& names = constraint.getParameterNames();
+
+        for (const auto& name : names)
+        {
+            mergeGroups(parents, findParameter(parameters, names[0]), findParameter(parameters, name));
+        }
+    }
+
+    std::map<size_t, std::vector<size_t>> groups;
+
+    for (size_t i = 0; i < parameters.size(); ++i)
+    {
+        groups[findRoot(parents, i)].push_back(i);
+    }
+
+    for (const auto& group : groups)
+    {
+        std::vector<KernelParameter> groupParameters;
+        std::vector<KernelConstraint> groupConstraints;
+
+        for (const auto index : group.second)
+        {
+            groupParameters.push_back(parameters[index]);
+            parameterPositions.push_back(index);
+        }
+
+        for (const auto& constraint : constraints)
+        {
+            if (!constraint.getParameterNames().empty()
+                && findRoot(parents, findParameter(parameters, constraint.getParameterNames()[0])) == group.first)
+            {
+                groupConstraints.push_back(constraint);
+            }
+        }
+
+        subspaces.emplace_back(groupParameters, groupConstraints);
+    }
+
+    strides.resize(subspaces.size());
+
+    for (size_t i = subspaces.size(); i > 0; --i)
+    {
+        strides[i - 1] = size;
+        size = multiplySize(size, subspaces[i - 1].getSize());
+    }
+}
+
+bool ConfigurationSpace::isValid(const uint64_t index) const
+{
+    if (index >= size)
+    {
+        return false;
+    }
+
+    const std::vector<uint64_t> subspaceIndices = splitIndex(index);
+
+    for (size_t i = 0; i < subspaces.size(); ++i)
+    {
+        if (!subspaces[i].isValid(subspaceIndices[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+uint64_t ConfigurationSpace::getNextValidIndex(const uint64_t index) const
+{
+    if (index >= size)
+    {
+        return size;
+    }
+
+    std::vector<uint64_t> subspaceIndices = splitIndex(index);
+    size_t subspace = 0;
+
+    while (subspace < subspaces.size())
+    {
+        const uint64_t nextIndex = subspaces[subspace].getNextValidIndex(subspaceIndices[subspace]);
+
+        if (nextIndex == subspaceIndices[subspace])
+        {
+            ++subspace;
+            continue;
+        }
+
+        // Less significant subspaces start again from their first configuration
+        for (size_t i = subspace + 1; i < subspaces.size(); ++i)
+        {
+            subspaceIndices[i] = 0;
+        }
+
+        if (nextIndex < subspaces[subspace].getSize())
+        {
+            subspaceIndices[subspace] = nextIndex;
+            ++subspace;
+            continue;
+        }
+
+        // Subspace is exhausted, carry is propagated to more significant subspace which has to be validated again
+        subspaceIndices[subspace] = 0;
+
+        do
+        {
+            if (subspace == 0)
+            {
+                return size;
+            }
+            --subspace;
+        }
+        while (++subspaceIndices[subspace] == subspaces[subspace].getSize() && (subspaceIndices[subspace] = 0) == 0);
+    }
+
+    return combineIndices(subspaceIndices);
+}
+
+std::vector<ParameterPair> ConfigurationSpace::getConfiguration(const uint64_t index) const
+{
+    if (index >= size)
+    {
+        throw std::runtime_error(std::string("Configuration index is out of range: ") + std::to_string(index));
+    }
+
+    const std::vector<uint64_t> subspaceIndices = splitIndex(index);
+    std::vector<ParameterPair> subspacePairs;
+
+    for (size_t i = 0; i < subspaces.size(); ++i)
+    {
+        subspaces[i].appendConfiguration(subspaceIndices[i], subspacePairs);
+    }
+
+    // Pairs are returned in the same order in which parameters were added to kernel
+    std::vector<ParameterPair> result(subspacePairs.size());
+
+    for (size_t i = 0; i < subspacePairs.size(); ++i)
+    {
+        result[parameterPositions[i]] = subspacePairs[i];
+    }
+
+    return result;
+}
+
+uint64_t ConfigurationSpace::getIndex(const std::vector<ParameterPair>& configuration) const
+{
+    std::vector<uint64_t> subspaceIndices;
+
+    for (const auto& subspace : subspaces)
+    {
+        subspaceIndices.push_back(subspace.getIndex(configuration));
+    }
+
+    return combineIndices(subspaceIndices);
+}
+
+std::vector<uint64_t> ConfigurationSpace::splitIndex(const uint64_t index) const
+{
+    std::vector<uint64_t> result(subspaces.size());
+
+    for (size_t i = 0; i < subspaces.size(); ++i)
+    {
+        result[i] = (index / strides[i]) % subspaces[i].getSize();
+    }
+
+    return result;
+}
+
+uint64_t ConfigurationSpace::combineIndices(const std::vector<uint64_t>& subspaceIndices) const
+{
+    if (subspaceIndices.size() != subspaces.size())
+    {
+        throw std::runtime_error("Number of subspace indices does not match number of configuration subspaces");
+    }
+
+    uint64_t result = 0;
+
+    for (size_t i = 0; i < subspaces.size(); ++i)
+    {
+        if (subspaceIndices[i] >= subspaces[i].getSize())
+        {
+            throw std::runtime_error(std::string("Subspace index is out of range: ") + std::to_string(subspaceIndices[i]));
+        }
+        result += subspaceIndices[i] * strides[i];
+    }
+
+    return result;
+}
+
+uint64_t ConfigurationSpace::getSize() const
+{
+    return size;
+}
+
+size_t ConfigurationSpace::getSubspaceCount() const
+{
+    return subspaces.size();
+}
+
+const ConfigurationSubspace& ConfigurationSpace::getSubspace(const size_t subspace) const
+{
+    if (subspace >= subspaces.size())
+    {
+        throw std::runtime_error(std::string("Invalid configuration subspace index: ") + std::to_string(subspace));
+    }
+    return subspaces[subspace];
+}
+
+} // namespace fly
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include <fly/api/parameter_pair.h>
+#include <fly/kernel/kernel_constraint.h>
+#include <fly/kernel/kernel_parameter.h>
+#include <fly/kernel/kernel_parameter_pack.h>
+
+namespace fly
+{
+
+// Group of parameters which are bound by constraints. Each configuration is identified by mixed-radix index whose digits are indices of
+// parameter values, first parameter forms the most significant digit. Configurations are never materialized.
+class ConfigurationSubspace
+{
+public:
+    // Constructor
+    explicit ConfigurationSubspace(const std::vector<KernelParameter>& parameters, const std::vector<KernelConstraint>& constraints);
+
+    // Core methods
+    bool isValid(const uint64_t index) const;
+    uint64_t getNextValidIndex(const uint64_t index) const;
+    uint64_t getValidCount() const;
+    void appendConfiguration(const uint64_t index, std::vector<ParameterPair>& configuration) const;
+    uint64_t getIndex(const std::vector<ParameterPair>& configuration) const;
+
+    // Getters
+    uint64_t getSize() const;
+    const std::vector<KernelParameter>& getParameters() const;
+
+private:
+    struct ConstraintCheck
+    {
+        std::function<bool(const std::vector<size_t>&)> function;
+        std::vector<size_t> depths;
+    };
+
+    // Attributes
+    std::vector<KernelParameter> parameters;
+    std::vector<uint64_t> strides;
+    std::vector<std::vector<ConstraintCheck>> constraintsByDepth;
+    uint64_t size;
+
+    // Helper methods
+    std::vector<size_t> getDigits(const uint64_t index) const;
+    bool checkConstraints(const size_t depth, const std::vector<size_t>& digits) const;
+    uint64_t countValid(const size_t depth, std::vector<size_t>& digits) const;
+};
+
+// Configuration space of a kernel. Parameter packs and parameters outside of packs form independent subspaces, unless they are bound
+// together by constraint. Global index is mixed-radix number whose digits are subspace indices, first subspace is the most significant.
+// Constraints are evaluated for partial assignments, so that whole subtrees of invalid configurations are skipped during iteration.
+class ConfigurationSpace
+{
+public:
+    // Constructor
+    explicit ConfigurationSpace(const std::vector<KernelParameter>& parameters, const std::vector<KernelConstraint>& constraints,
+        const std::vector<KernelParameterPack>& packs);
+
+    // Core methods
+    bool isValid(const uint64_t index) const;
+    uint64_t getNextValidIndex(const uint64_t index) const;
+    std::vector<ParameterPair> getConfiguration(const uint64_t index) const;
+    uint64_t getIndex(const std::vector<ParameterPair>& configuration) const;
+    std::vector<uint64_t> splitIndex(const uint64_t index) const;
+    uint64_t combineIndices(const std::vector<uint64_t>& subspaceIndices) const;
+
+    // Getters
+    uint64_t getSize() const;
+    size_t getSubspaceCount() const;
+    const ConfigurationSubspace& getSubspace(const size_t subspace) const;
+
+private:
+    // Attributes
+    std::vector<ConfigurationSubspace> subspaces;
+    std::vector<uint64_t> strides;
+    std::vector<size_t> parameterPositions;
+    uint64_t size;
+};
+
+} // namespace fly
@@ -12,8 +12,8 @@ Kernel::Kernel(const KernelId id, const std::string& source, const std::string&
     source(source),
     name(name),
     globalSize(globalSize),
-    localSize(localSize)
-   
+    localSize(localSize),
+    configurationSpace(std::make_shared<ConfigurationSpace>(parameters, constraints, parameterPacks))
 {
     globalThreadModifiers[0] = nullptr;
     globalThreadModifiers[1] = nullptr;
@@ -31,6 +31,7 @@ void Kernel::addParameter(const KernelParameter& parameter)
         throw std::runtime_error(std::string("Parameter with given name already exists: ") + parameter.getName());
     }
     parameters.push_back(parameter);
+    updateConfigurationSpace();
 }
 
 void Kernel::addConstraint(const KernelConstraint& constraint)
@@ -45,6 +46,7 @@ void Kernel::addConstraint(const KernelConstraint& constraint)
         }
     }
     constraints.push_back(constraint);
+    updateConfigurationSpace();
 }
 
 void Kernel::addParameterPack(const KernelParameterPack& pack)
@@ -70,6 +72,7 @@ void Kernel::addParameterPack(const KernelParameterPack& pack)
         }
     }
     parameterPacks.push_back(pack);
+    updateConfigurationSpace();
 }
 
 void Kernel::setThreadModifier(const ModifierType modifierType, const ModifierDimension modifierDimension,
@@ -338,6 +341,17 @@ bool Kernel::hasParameter(const std::string& parameterName) const
     return false;
 }
 
+const ConfigurationSpace& Kernel::getConfigurationSpace() const
+{
+    return *configurationSpace;
+}
+
+void Kernel::updateConfigurationSpace()
+{
+    // Space only describes its structure, configurations are not enumerated, so it is cheap to rebuild whenever kernel is modified. Getter
+    // then does not write anything and can be called by multiple readers at the same time.
+    configurationSpace = std::make_shared<ConfigurationSpace>(parameters, constraints, parameterPacks);
+}
 
 void Kernel::validateModifierParameters(const std::vector<std::string>& parameterNames) const
 {
@@ -10,6 +10,7 @@
 #include <fly/dto/local_memory_modifier.h>
 #include <fly/enum/modifier_dimension.h>
 #include <fly/enum/modifier_type.h>
+#include <fly/kernel/configuration_space.h>
 #include <fly/kernel/kernel_constraint.h>
 #include <fly/kernel/kernel_parameter.h>
 #include <fly/kernel/kernel_parameter_pack.h>
@@ -53,6 +54,7 @@ public:
     const std::vector<ArgumentId>& getArgumentIds() const;
     std::vector<LocalMemoryModifier> getLocalMemoryModifiers(const std::vector<ParameterPair>& parameterPairs) const;
     bool hasParameter(const std::string& parameterName) const;
+    const ConfigurationSpace& getConfigurationSpace() const;
 
 
 private:
@@ -72,8 +74,10 @@ private:
     std::array<std::function<size_t(const size_t, const std::vector<size_t>&)>, 3> localThreadModifiers;
     std::map<ArgumentId, std::vector<std::string>> localMemoryModifierNames;
     std::map<ArgumentId, std::function<size_t(const size_t, const std::vector<size_t>&)>> localMemoryModifiers;
+    std::shared_ptr<ConfigurationSpace> configurationSpace;
   
     void validateModifierParameters(const std::vector<std::string>& parameterNames) const;
+    void updateConfigurationSpace();
 };
 
 } // namespace fly
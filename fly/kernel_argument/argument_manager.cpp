@@ -54,6 +54,19 @@ void ArgumentManager::setPersistentFlag(const ArgumentId id, const bool flag)
     arguments.at(id).setPersistentFlag(flag);
 }
 
+void ArgumentManager::setFillPattern(const ArgumentId id, const void* pattern, const size_t patternSize)
+{
+    if (id >= nextArgumentId)
+    {
+        throw std::runtime_error(std::string("Invalid argument id: ") + std::to_string(id));
+    }
+    if (arguments.at(id).getUploadType() != ArgumentUploadType::Vector || arguments.at(id).getAccessType() != ArgumentAccessType::WriteOnly)
+    {
+        throw std::runtime_error("Fill pattern can only be set for write-only vector kernel arguments");
+    }
+    arguments.at(id).setFillPattern(pattern, patternSize);
+}
+
 size_t ArgumentManager::getArgumentCount() const
 {
     return arguments.size();
@@ -21,6 +21,7 @@ public:
     void updateArgument(const ArgumentId id, void* data, const size_t numberOfElements);
     void updateArgument(const ArgumentId id, const void* data, const size_t numberOfElements);
     void setPersistentFlag(const ArgumentId id, const bool flag);
+    void setFillPattern(const ArgumentId id, const void* pattern, const size_t patternSize);
 
     // Getters
     size_t getArgumentCount() const;
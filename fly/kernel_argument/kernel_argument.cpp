@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <stdexcept>
 #include <fly/kernel_argument/kernel_argument.h>
 
@@ -15,7 +16,8 @@ KernelArgument::KernelArgument(const ArgumentId id, const size_t numberOfElement
     argumentUploadType(uploadType),
     dataCopied(true),
     referencedData(nullptr),
-    persistentFlag(false)
+    persistentFlag(false),
+    dirtyFlag(false)
 {
     if (numberOfElements == 0)
     {
@@ -36,7 +38,8 @@ KernelArgument::KernelArgument(const ArgumentId id, void* data, const size_t num
     argumentUploadType(uploadType),
     dataCopied(dataCopied),
     referencedData(nullptr),
-    persistentFlag(false)
+    persistentFlag(false),
+    dirtyFlag(false)
 {
     if (numberOfElements == 0)
     {
@@ -65,7 +68,8 @@ KernelArgument::KernelArgument(const ArgumentId id, const void* data, const size
     argumentUploadType(uploadType),
     dataCopied(true),
     referencedData(nullptr),
-    persistentFlag(false)
+    persistentFlag(false),
+    dirtyFlag(false)
 {
     if (numberOfElements == 0 && data != nullptr)
     {
@@ -94,6 +98,7 @@ void KernelArgument::updateData(void* data, const size_t numberOfElements)
     {
         referencedData = data;
     }
+    dirtyFlag = true;
 }
 
 void KernelArgument::updateData(const void* data, const size_t numberOfElements)
@@ -106,8 +111,12 @@ void KernelArgument::updateData(const void* data, const size_t numberOfElements)
     this->numberOfElements = numberOfElements;
     if (data != nullptr)
     {
+        // Constant data cannot be referenced, so it is always copied, even if argument previously referenced user data
+        dataCopied = true;
+        referencedData = nullptr;
         initializeData(data);
     }
+    dirtyFlag = true;
 }
 
 void KernelArgument::setPersistentFlag(const bool flag)
@@ -115,6 +124,40 @@ void KernelArgument::setPersistentFlag(const bool flag)
     persistentFlag = flag;
 }
 
+void KernelArgument::setDirtyFlag(const bool flag)
+{
+    dirtyFlag = flag;
+}
+
+void KernelArgument::setFillPattern(const void* pattern, const size_t patternSize)
+{
+    if (pattern != nullptr && patternSize != elementSizeInBytes)
+    {
+        throw std::runtime_error("Size of fill pattern must match element size of kernel argument");
+    }
+
+    if (pattern == nullptr)
+    {
+        fillPattern.clear();
+    }
+    else
+    {
+        const uint8_t* patternBytes = static_cast<const uint8_t*>(pattern);
+        fillPattern.assign(patternBytes, patternBytes + patternSize);
+    }
+    dirtyFlag = true;
+}
+
+void KernelArgument::fillWithPattern(void* destination, const size_t dataSize) const
+{
+    uint8_t* destinationBytes = static_cast<uint8_t*>(destination);
+
+    for (size_t offset = 0; offset < dataSize; offset += fillPattern.size())
+    {
+        std::memcpy(destinationBytes + offset, fillPattern.data(), std::min(fillPattern.size(), dataSize - offset));
+    }
+}
+
 ArgumentId KernelArgument::getId() const
 {
     return id;
@@ -180,6 +223,46 @@ bool KernelArgument::isPersistent() const
     return persistentFlag;
 }
 
+bool KernelArgument::isDirty() const
+{
+    return dirtyFlag;
+}
+
+bool KernelArgument::hasFillPattern() const
+{
+    return !fillPattern.empty();
+}
+
+const std::vector<uint8_t>& KernelArgument::getFillPattern() const
+{
+    return fillPattern;
+}
+
+size_t KernelArgument::getFillPatternPeriod() const
+{
+    // Smallest power of two after which pattern repeats, e.g. zero of any type can be filled byte by byte
+    for (size_t period = 1; period < fillPattern.size(); period *= 2)
+    {
+        if (fillPattern.size() % period != 0)
+        {
+            break;
+        }
+
+        bool repeats = true;
+        for (size_t i = period; i < fillPattern.size() && repeats; ++i)
+        {
+            repeats = fillPattern[i] == fillPattern[i - period];
+        }
+
+        if (repeats)
+        {
+            return period;
+        }
+    }
+
+    return fillPattern.size();
+}
+
 bool KernelArgument::operator==(const KernelArgument& other) const
 {
     return id == other.id;
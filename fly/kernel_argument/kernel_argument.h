@@ -29,6 +29,9 @@ public:
     void updateData(void* data, const size_t numberOfElements);
     void updateData(const void* data, const size_t numberOfElements);
     void setPersistentFlag(const bool flag);
+    void setDirtyFlag(const bool flag);
+    void setFillPattern(const void* pattern, const size_t patternSize);
+    void fillWithPattern(void* destination, const size_t dataSize) const;
 
     // Getters
     ArgumentId getId() const;
@@ -60,6 +63,10 @@ public:
     }
     bool hasCopiedData() const;
     bool isPersistent() const;
+    bool isDirty() const;
+    bool hasFillPattern() const;
+    const std::vector<uint8_t>& getFillPattern() const;
+    size_t getFillPatternPeriod() const;
 
     // Operators
     bool operator==(const KernelArgument& other) const;
@@ -76,8 +83,10 @@ private:
     ArgumentUploadType argumentUploadType;
     std::vector<uint8_t> copiedData;
     void* referencedData;
+    std::vector<uint8_t> fillPattern;
     bool dataCopied;
     bool persistentFlag;
+    bool dirtyFlag;
 
     // Helper methods
     void initializeData(const void* data);
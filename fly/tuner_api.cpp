@@ -42,6 +42,20 @@ KernelId Tuner::addKernelFromFile(const std::string& filePath, const std::string
     }
 }
 
+KernelId Tuner::addHostKernel(const std::string& kernelName, const HostKernelFunction& kernelFunction, const DimensionVector& globalSize,
+    const DimensionVector& localSize)
+{
+    try
+    {
+        return tunerCore->addHostKernel(kernelName, kernelFunction, globalSize, localSize);
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
 void Tuner::setKernelArguments(const KernelId id, const std::vector<ArgumentId>& argumentIds)
 {
     try
@@ -189,6 +203,47 @@ void Tuner::downloadPersistentArgument(const OutputDescriptor& output) const
     }
 }
 
+void Tuner::setResidentArguments(const bool flag)
+{
+    try
+    {
+        tunerCore->setResidentArguments(flag);
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
+void Tuner::releaseArgument(const ArgumentId id)
+{
+    try
+    {
+        tunerCore->releaseArgument(id);
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
+void Tuner::setDeviceMemoryBudget(const size_t budget)
+{
+    tunerCore->setDeviceMemoryBudget(budget);
+}
+
+DeviceMemoryStatistics Tuner::getDeviceMemoryStatistics() const
+{
+    return tunerCore->getDeviceMemoryStatistics();
+}
+
+void Tuner::setConcurrentSubmission(const bool flag)
+{
+    tunerCore->setConcurrentSubmission(flag);
+}
+
 
 ComputationResult Tuner::runKernel(const KernelId id, const std::vector<ParameterPair>& configuration, const std::vector<OutputDescriptor>& output)
 {
@@ -203,6 +258,201 @@ ComputationResult Tuner::runKernel(const KernelId id, const std::vector<Paramete
     }
 }
 
+std::vector<std::future<void>> Tuner::precompile(const KernelId id, const std::vector<std::vector<ParameterPair>>& configurations)
+{
+    try
+    {
+        return tunerCore->precompile(id, configurations);
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
+LaunchId Tuner::prepareLaunch(const KernelId id, const std::vector<ParameterPair>& configuration)
+{
+    try
+    {
+        return tunerCore->prepareLaunch(id, configuration);
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
+ComputationResult Tuner::launch(const LaunchId id, const std::vector<OutputDescriptor>& output)
+{
+    try
+    {
+        return tunerCore->launch(id, output);
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
+void Tuner::releaseLaunch(const LaunchId id)
+{
+    try
+    {
+        tunerCore->releaseLaunch(id);
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
+EventId Tuner::runKernelAsync(const KernelId id, const std::vector<ParameterPair>& configuration, const QueueId queue)
+{
+    try
+    {
+        return tunerCore->runKernelAsync(id, configuration, queue);
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
+ComputationResult Tuner::getKernelResult(const EventId id, const std::vector<OutputDescriptor>& output)
+{
+    try
+    {
+        return tunerCore->getKernelResult(id, output);
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
+EventId Tuner::uploadArgumentAsync(const ArgumentId id, const QueueId queue)
+{
+    try
+    {
+        return tunerCore->uploadArgumentAsync(id, queue);
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
+EventId Tuner::downloadArgumentAsync(const OutputDescriptor& output, const QueueId queue) const
+{
+    try
+    {
+        return tunerCore->downloadArgumentAsync(output, queue);
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
+uint64_t Tuner::getArgumentOperationDuration(const EventId id) const
+{
+    try
+    {
+        return tunerCore->getArgumentOperationDuration(id);
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
+QueueId Tuner::getDefaultQueue() const
+{
+    try
+    {
+        return tunerCore->getDefaultQueue();
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
+std::vector<QueueId> Tuner::getAllQueues() const
+{
+    try
+    {
+        return tunerCore->getAllQueues();
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
+void Tuner::synchronizeQueue(const QueueId queue)
+{
+    try
+    {
+        tunerCore->synchronizeQueue(queue);
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
+void Tuner::synchronizeDevice()
+{
+    try
+    {
+        tunerCore->synchronizeDevice();
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
+std::vector<ComputationResult> Tuner::runGraph(const KernelGraph& graph, const std::vector<OutputDescriptor>& output)
+{
+    try
+    {
+        return tunerCore->runGraph(graph, output);
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
+std::vector<ComputationResult> Tuner::tuneKernel(const KernelId id, std::unique_ptr<StopCondition> stopCondition, std::unique_ptr<Searcher> searcher)
+{
+    try
+    {
+        return tunerCore->tuneKernel(id, std::move(stopCondition), std::move(searcher));
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
 
 
 
@@ -220,6 +470,45 @@ std::string Tuner::getKernelSource(const KernelId id, const std::vector<Paramete
     }
 }
 
+uint64_t Tuner::getConfigurationSpaceSize(const KernelId id) const
+{
+    try
+    {
+        return tunerCore->getConfigurationSpaceSize(id);
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
+uint64_t Tuner::getNextValidConfigurationIndex(const KernelId id, const uint64_t index) const
+{
+    try
+    {
+        return tunerCore->getNextValidConfigurationIndex(id, index);
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
+std::vector<ParameterPair> Tuner::getConfiguration(const KernelId id, const uint64_t index) const
+{
+    try
+    {
+        return tunerCore->getConfiguration(id, index);
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
 void Tuner::setCompilerOptions(const std::string& options)
 {
     tunerCore->setCompilerOptions(options);
@@ -230,6 +519,34 @@ void Tuner::setKernelCacheCapacity(const size_t capacity)
     tunerCore->setKernelCacheCapacity(capacity);
 }
 
+void Tuner::setKernelCacheByteBudget(const size_t budget)
+{
+    tunerCore->setKernelCacheByteBudget(budget);
+}
+
+void Tuner::setKernelCacheEvictionPolicy(const KernelCacheEvictionPolicy policy)
+{
+    tunerCore->setKernelCacheEvictionPolicy(policy);
+}
+
+KernelCacheStatistics Tuner::getKernelCacheStatistics() const
+{
+    return tunerCore->getKernelCacheStatistics();
+}
+
+void Tuner::setPersistentKernelCache(const std::string& directory, const size_t maxSizeInBytes)
+{
+    try
+    {
+        tunerCore->setPersistentKernelCache(directory, maxSizeInBytes);
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
 void Tuner::printComputeAPIInfo(std::ostream& outputTarget) const
 {
     try
@@ -349,4 +666,43 @@ ArgumentId Tuner::addArgument(const size_t localMemoryElementsCount, const size_
     }
 }
 
+void Tuner::updateArgument(const ArgumentId id, void* data, const size_t numberOfElements, const size_t elementSizeInBytes)
+{
+    try
+    {
+        tunerCore->updateArgument(id, data, numberOfElements, elementSizeInBytes);
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
+void Tuner::updateArgument(const ArgumentId id, const void* data, const size_t numberOfElements, const size_t elementSizeInBytes)
+{
+    try
+    {
+        tunerCore->updateArgument(id, data, numberOfElements, elementSizeInBytes);
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
+void Tuner::setArgumentFillPattern(const ArgumentId id, const void* pattern, const size_t patternSize)
+{
+    try
+    {
+        tunerCore->setArgumentFillPattern(id, pattern, patternSize);
+    }
+    catch (const std::runtime_error& error)
+    {
+        TunerCore::log(LoggingLevel::Error, error.what());
+        throw;
+    }
+}
+
 } // namespace fly
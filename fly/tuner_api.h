@@ -1,6 +1,7 @@
 #pragma once
 
 #include <functional>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <ostream>
@@ -21,6 +22,7 @@
 #include "fly/enum/argument_upload_type.h"
 #include "fly/enum/compute_api.h"
 #include "fly/enum/global_size_type.h"
+#include "fly/enum/kernel_cache_eviction_policy.h"
 #include "fly/enum/logging_level.h"
 #include "fly/enum/modifier_action.h"
 #include "fly/enum/modifier_dimension.h"
@@ -31,10 +33,22 @@
 // Data holders
 #include "fly/api/computation_result.h"
 #include "fly/api/device_info.h"
+#include "fly/api/device_memory_statistics.h"
 #include "fly/api/dimension_vector.h"
+#include "fly/api/host_kernel_context.h"
+#include "fly/api/kernel_cache_statistics.h"
+#include "fly/api/kernel_graph.h"
 #include "fly/api/output_descriptor.h"
 #include "fly/api/platform_info.h"
 
+// Offline tuning
+#include "fly/api/searcher/annealing_searcher.h"
+#include "fly/api/searcher/full_searcher.h"
+#include "fly/api/searcher/random_searcher.h"
+#include "fly/api/stop_condition/configuration_count.h"
+#include "fly/api/stop_condition/configuration_duration.h"
+#include "fly/api/stop_condition/tuning_duration.h"
+
 
 
 
@@ -78,6 +92,18 @@ namespace fly
         KernelId addKernelFromFile(const std::string& filePath, const std::string& kernelName, const DimensionVector& globalSize,
             const DimensionVector& localSize);
 
+        /**
+          * 向使用ComputeAPI::Host的tuner添加由C++函数实现的内核。函数对每个work-group调用一次，并在线程池上并行执行。
+          * 内核名称必须唯一，重复添加同名内核会抛出异常。只读参数不得被内核写入。
+          * @param kernelName 内核名称
+          * @param kernelFunction 内核函数，通过HostKernelContext访问work-group索引、参数和本地内存
+          * @param globalSize 基本内核全局大小的维度
+          * @param localSize 基本内核本地大小的维度 (work-group 大小)
+          * @return Id  KernelId
+          */
+        KernelId addHostKernel(const std::string& kernelName, const HostKernelFunction& kernelFunction, const DimensionVector& globalSize,
+            const DimensionVector& localSize);
+
         /**
           * 通过提供相应的参数id为指定的内核设置内核参数。
           * @param id KernelId
@@ -154,15 +180,212 @@ namespace fly
 
         void downloadPersistentArgument(const OutputDescriptor& output) const;
 
+        /** 更新向量参数的数据。常住模式下，只有被更新的参数会在下次运行内核时重新上传。
+          * 如果参数引用用户数据（copyData为false），则改为引用新的数据，否则复制新的数据。
+          * @param id 参数id
+          * @param data 新的数据，元素类型必须与添加参数时的类型大小相同
+          */
+        template <typename T> void updateArgumentVector(const ArgumentId id, std::vector<T>& data)
+        {
+            updateArgument(id, data.data(), data.size(), sizeof(T));
+        }
+
+        /** 使用常量数据更新向量参数，数据总是被复制。
+          * @param id 参数id
+          * @param data 新的数据，元素类型必须与添加参数时的类型大小相同
+          */
+        template <typename T> void updateArgumentVector(const ArgumentId id, const std::vector<T>& data)
+        {
+            updateArgument(id, static_cast<const void*>(data.data()), data.size(), sizeof(T));
+        }
+
+        /** 更新标量参数的值。
+          * @param id 参数id
+          * @param data 新的值
+          */
+        template <typename T> void updateArgumentScalar(const ArgumentId id, const T& data)
+        {
+            updateArgument(id, static_cast<const void*>(&data), 1, sizeof(T));
+        }
+
+        /** 为WriteOnly向量参数设置填充值。WriteOnly参数的主机数据不会上传到设备，缓冲区只被分配，内容未定义。
+          * 设置填充值后，缓冲区在设备上被初始化为该值（clEnqueueFillBuffer、cuMemsetD*或vkCmdFillBuffer），同样不需要主机到设备的传输。
+          * @param id 参数id，参数必须是WriteOnly向量参数
+          * @param value 填充值，类型大小必须与参数元素大小相同
+          */
+        template <typename T> void setArgumentFillValue(const ArgumentId id, const T& value)
+        {
+            setArgumentFillPattern(id, &value, sizeof(T));
+        }
+
+        /** 启用或禁用常住模式（默认禁用）。禁用时，每次runKernel调用之后都会释放所有设备缓冲区，下次运行时重新上传全部参数。
+          * 启用时，缓冲区保留在设备上，直到参数被更新（updateArgumentVector）或被释放（releaseArgument），未修改的输入不会重复上传。
+          * 注意：常住模式下，内核对ReadWrite参数的修改会保留到下一次运行，需要恢复初始数据时请更新该参数。
+          * @param flag 为true时启用常住模式，为false时禁用并立即释放所有缓冲区
+          */
+        void setResidentArguments(const bool flag);
+
+        /** 释放参数的设备缓冲区，下次运行使用该参数的内核时会重新上传。
+          * @param id 参数id
+          */
+        void releaseArgument(const ArgumentId id);
+
+        /** 设置参数缓冲区可以占用的设备内存预算。上传新缓冲区会超出预算时，最久未使用的缓冲区被移出设备：ReadOnly缓冲区直接释放，
+          * 下次使用时从参数的主机数据重新上传；其他缓冲区的内容先被复制到主机，下次使用时再恢复。当前启动所用的缓冲区和持久缓冲区不会被移出。
+          * 建议同时启用常住模式（setResidentArguments），否则每次运行之后仍会释放所有缓冲区。
+          * @param budget 参数缓冲区的最大总大小（字节）。0表示不限制（默认）
+          */
+        void setDeviceMemoryBudget(const size_t budget);
+
+        /** 获取参数缓冲区当前和峰值设备内存占用，以及移出和溢出到主机的缓冲区数量。
+          * @return 设备内存统计信息
+          */
+        DeviceMemoryStatistics getDeviceMemoryStatistics() const;
+
+        /** 启用或禁用并发提交模式（默认禁用）。Tuner的方法可以从多个线程同时调用：读取内核和参数元数据的调用（运行内核、查询配置）可以并行进行，
+          * 修改元数据的调用（添加内核或参数、updateArgumentVector、tuneKernel等）会等待正在进行的运行结束。等待内核完成时不持有任何锁。
+          * 启用后，每个调用线程的阻塞运行（runKernel、launch）被轮流分配到各自的队列上，来自线程池的独立请求可以在设备上重叠执行；
+          * 运行失败时只同步该线程的队列，不会清除其他线程的事件。禁用时阻塞运行使用默认队列。
+          * 建议队列数量（computeQueueCount）不少于提交线程数。未启用常住模式时，设备缓冲区在最后一个并发运行结束之后才会释放。
+          * @param flag 为true时启用并发提交模式
+          */
+        void setConcurrentSubmission(const bool flag);
+
 
         ComputationResult runKernel(const KernelId id, const std::vector<ParameterPair>& configuration, const std::vector<OutputDescriptor>& output);
 
+        /** 在后台线程池中并行编译内核的多个配置，并将结果放入已编译内核缓存，之后的runKernel调用无需再编译。
+          * 线程数等于CPU核心数。内核缓存容量应不小于配置数量，否则先编译的配置可能被淘汰（参见setKernelCacheCapacity）。
+          * 修改编译选项、全局尺寸或内核缓存设置的调用会先等待所有后台编译完成。
+          * @param id 内核id
+          * @param configurations 需要编译的配置列表
+          * @return 每个配置对应一个future，编译完成后就绪。编译失败时，调用get()会抛出相应异常
+          */
+        std::vector<std::future<void>> precompile(const KernelId id, const std::vector<std::vector<ParameterPair>>& configurations);
+
+        /** 为内核的一个配置准备启动句柄。内核在此时编译（或从缓存中取出）并被句柄固定，带宏定义的源码和启动尺寸只生成一次。
+          * 之后的launch调用不再生成源码、计算缓存键或查找内核缓存，只重新绑定自上次启动以来发生变化的参数，适用于主机开销占主导的小内核循环。
+          * 建议同时启用常住模式（setResidentArguments），否则每次launch之后仍会释放所有缓冲区。
+          * @param id 内核id
+          * @param configuration 内核配置
+          * @return 启动句柄id
+          */
+        LaunchId prepareLaunch(const KernelId id, const std::vector<ParameterPair>& configuration);
+
+        /** 使用prepareLaunch准备的句柄运行内核，并等待其完成。
+          * @param id 启动句柄id
+          * @param output 运行后需要下载的参数
+          * @return 运行结果，失败时包含错误信息
+          */
+        ComputationResult launch(const LaunchId id, const std::vector<OutputDescriptor>& output);
+
+        /** 释放启动句柄，被句柄固定的内核可以被内核缓存淘汰。
+          * @param id 启动句柄id
+          */
+        void releaseLaunch(const LaunchId id);
+
+        /** 将内核的一个配置提交到指定队列后立即返回，不等待内核完成。不同队列上的内核以及数据传输可以相互重叠，同一队列上的操作按提交顺序执行。
+          * 异步运行之后不会释放设备缓冲区，不同队列之间的依赖需要通过getArgumentOperationDuration、synchronizeQueue或getKernelResult自行保证。
+          * 在使用某个参数的内核完成之前，不应更新或释放该参数。
+          * @param id 内核id
+          * @param configuration 内核配置
+          * @param queue 队列id，有效范围见getAllQueues
+          * @return 内核事件id，用于getKernelResult
+          */
+        EventId runKernelAsync(const KernelId id, const std::vector<ParameterPair>& configuration, const QueueId queue);
+
+        /** 等待异步运行的内核完成并返回其结果。每个事件的结果只能获取一次。
+          * @param id runKernelAsync返回的内核事件id
+          * @param output 内核完成后需要下载的参数
+          * @return 运行结果，失败时包含错误信息
+          */
+        ComputationResult getKernelResult(const EventId id, const std::vector<OutputDescriptor>& output);
+
+        /** 在指定队列上异步上传向量参数。参数已有的设备缓冲区会在所有队列完成后被释放，上传的缓冲区之后被使用该参数的内核复用。
+          * @param id 参数id，持久参数不能异步上传
+          * @param queue 队列id
+          * @return 数据传输事件id，用于getArgumentOperationDuration
+          */
+        EventId uploadArgumentAsync(const ArgumentId id, const QueueId queue);
+
+        /** 在指定队列上异步下载参数，目标内存在传输完成之前必须保持有效。
+          * @param output 需要下载的参数和目标内存
+          * @param queue 队列id
+          * @return 数据传输事件id，用于getArgumentOperationDuration
+          */
+        EventId downloadArgumentAsync(const OutputDescriptor& output, const QueueId queue) const;
+
+        /** 等待异步数据传输完成。每个事件只能等待一次。
+          * @param id uploadArgumentAsync或downloadArgumentAsync返回的事件id
+          * @return 传输时间（纳秒），未在设备上执行传输时为0
+          */
+        uint64_t getArgumentOperationDuration(const EventId id) const;
+
+        /** 返回阻塞调用（runKernel、launch等）使用的默认队列。
+          * @return 默认队列id
+          */
+        QueueId getDefaultQueue() const;
+
+        /** 返回所有可用的队列，队列数量由构造函数的computeQueueCount参数决定。
+          * @return 队列id列表
+          */
+        std::vector<QueueId> getAllQueues() const;
+
+        /** 等待指定队列上已提交的所有操作完成。
+          * @param queue 队列id
+          */
+        void synchronizeQueue(const QueueId queue);
+
+        /** 等待所有队列上已提交的操作完成。
+          */
+        void synchronizeDevice();
+
+        /** 运行内核图。节点之间的依赖由共享向量参数的访问类型推断（读等待之前的写，写等待之前的读和写），也可以在图中显式添加。
+          * 依赖链上的节点放在同一个队列中，独立的分支分配到负载最小的队列，跨队列依赖通过设备事件解决（cl_event、CUDA事件、Vulkan信号量），
+          * 所有节点提交之后才等待结果，中间结果保留在设备上，节点之间没有主机同步。
+          * @param graph 内核图
+          * @param output 所有节点完成后需要下载的参数
+          * @return 每个节点的运行结果，顺序与图中节点的顺序相同
+          */
+        std::vector<ComputationResult> runGraph(const KernelGraph& graph, const std::vector<OutputDescriptor>& output);
+
+        /** 离线调优内核：由searcher在配置空间中选择配置并逐个运行，直到所有配置都被探索或满足停止条件。
+          * 只读参数的缓冲区在配置之间保留在设备上，可被内核修改的缓冲区在每次运行前重新上传。
+          * @param id 内核id
+          * @param stopCondition 停止条件，例如ConfigurationCount、TuningDuration或ConfigurationDuration。为nullptr时探索所有配置
+          * @param searcher 配置搜索器，例如FullSearcher、RandomSearcher或AnnealingSearcher。为nullptr时使用FullSearcher
+          * @return 按运行时间从快到慢排序的结果，失败的配置排在最后
+          */
+        std::vector<ComputationResult> tuneKernel(const KernelId id, std::unique_ptr<StopCondition> stopCondition = nullptr,
+            std::unique_ptr<Searcher> searcher = nullptr);
+
 
 
 
 
         std::string getKernelSource(const KernelId id, const std::vector<ParameterPair>& configuration) const;
 
+        /** 返回内核配置空间的大小（包括不满足约束的配置）。配置空间不会被展开，每个配置由索引表示，
+          * 参数包和不受约束关联的参数组成独立的子空间。
+          * @param id 内核id
+          * @return 配置空间的大小
+          */
+        uint64_t getConfigurationSpaceSize(const KernelId id) const;
+
+        /** 返回不小于给定索引且满足所有约束的第一个配置的索引。违反约束的部分配置会被整体跳过。
+          * @param id 内核id
+          * @param index 起始索引
+          * @return 有效配置的索引。如果不存在，返回getConfigurationSpaceSize()
+          */
+        uint64_t getNextValidConfigurationIndex(const KernelId id, const uint64_t index) const;
+
+        /** 根据索引返回配置，参数顺序与添加参数的顺序相同。
+          * @param id 内核id
+          * @param index 配置的索引，必须小于getConfigurationSpaceSize()
+          * @return 配置
+          */
+        std::vector<ParameterPair> getConfiguration(const KernelId id, const uint64_t index) const;
+
 
 
 
@@ -170,6 +393,28 @@ namespace fly
 
         void setKernelCacheCapacity(const size_t capacity);
 
+        /** 设置已编译内核缓存的字节预算。超过预算时按照淘汰策略移除内核。
+          * @param budget 缓存中已编译内核的最大总大小（字节）。0表示不限制
+          */
+        void setKernelCacheByteBudget(const size_t budget);
+
+        /** 设置已编译内核缓存的淘汰策略。默认为KernelCacheEvictionPolicy::LeastRecentlyUsed
+          * @param policy 淘汰策略
+          */
+        void setKernelCacheEvictionPolicy(const KernelCacheEvictionPolicy policy);
+
+        /** 获取已编译内核缓存的命中、未命中和淘汰次数。
+          * @return 内核缓存统计信息
+          */
+        KernelCacheStatistics getKernelCacheStatistics() const;
+
+        /** 启用已编译内核的磁盘缓存，进程重启后可直接加载内核二进制而无需重新编译。支持OpenCL（程序二进制）和Vulkan（SPIR-V及VkPipelineCache数据）。
+          * 缓存文件以原子方式写入，损坏或被驱动拒绝的文件会被删除并重新编译。
+          * @param directory 缓存目录。空字符串表示禁用磁盘缓存
+          * @param maxSizeInBytes 缓存目录的最大总大小（字节），超过时删除最久未使用的文件。0表示不限制
+          */
+        void setPersistentKernelCache(const std::string& directory, const size_t maxSizeInBytes);
+
 
         void printComputeAPIInfo(std::ostream& outputTarget) const;
 
@@ -205,6 +450,9 @@ namespace fly
         ArgumentId addArgument(const void* data, const size_t numberOfElements, const size_t elementSizeInBytes, const ArgumentDataType dataType,
             const ArgumentMemoryLocation memoryLocation, const ArgumentAccessType accessType, const ArgumentUploadType uploadType);
         ArgumentId addArgument(const size_t localMemoryElementsCount, const size_t elementSizeInBytes, const ArgumentDataType dataType);
+        void updateArgument(const ArgumentId id, void* data, const size_t numberOfElements, const size_t elementSizeInBytes);
+        void updateArgument(const ArgumentId id, const void* data, const size_t numberOfElements, const size_t elementSizeInBytes);
+        void setArgumentFillPattern(const ArgumentId id, const void* pattern, const size_t patternSize);
 
         template <typename T> ArgumentDataType getMatchingArgumentDataType() const
         {
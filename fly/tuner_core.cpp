@@ -1,4 +1,5 @@
 #include "fly/compute_engine/cuda/cuda_engine.h"
+#include "fly/compute_engine/host/host_engine.h"
 #include "fly/compute_engine/opencl/opencl_engine.h"
 #include "fly/compute_engine/vulkan/vulkan_engine.h"
 #include "fly/utility/fly_utility.h"
@@ -38,6 +39,10 @@ TunerCore::TunerCore(const PlatformIndex platform, const DeviceIndex device, con
         throw std::runtime_error("Support for Vulkan API is not included in this version of Fly framework");
         #endif // FLY_PLATFORM_VULKAN
     }
+    else if (computeAPI == ComputeAPI::Host)
+    {
+        computeEngine = MakeStdUnique<HostEngine>(device, queueCount);
+    }
     else
     {
         throw std::runtime_error("Specified compute API is not supported");
@@ -47,59 +52,85 @@ TunerCore::TunerCore(const PlatformIndex platform, const DeviceIndex device, con
     Logger::getLogger().log(LoggingLevel::Info, std::string("Initializing tuner for device ") + info.getName());
 
     kernelRunner = MakeStdUnique<KernelRunner>(&argumentManager, &kernelManager, computeEngine.get());
+    tuningRunner = MakeStdUnique<TuningRunner>(&kernelManager, kernelRunner.get());
     
 }
 
 KernelId TunerCore::addKernel(const std::string& source, const std::string& kernelName, const DimensionVector& globalSize,
     const DimensionVector& localSize)
 {
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
     return kernelManager.addKernel(source, kernelName, globalSize, localSize);
 }
 
 KernelId TunerCore::addKernelFromFile(const std::string& filePath, const std::string& kernelName, const DimensionVector& globalSize,
     const DimensionVector& localSize)
 {
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
     return kernelManager.addKernelFromFile(filePath, kernelName, globalSize, localSize);
 }
 
+KernelId TunerCore::addHostKernel(const std::string& kernelName, const HostKernelFunction& kernelFunction, const DimensionVector& globalSize,
+    const DimensionVector& localSize)
+{
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
+    HostEngine* hostEngine = dynamic_cast<HostEngine*>(computeEngine.get());
+
+    if (hostEngine == nullptr)
+    {
+        throw std::runtime_error("Host kernels can only be added to tuner which uses Host compute API");
+    }
+
+    hostEngine->addKernelFunction(kernelName, kernelFunction);
+    return kernelManager.addKernel("", kernelName, globalSize, localSize);
+}
+
 
 
 void TunerCore::addParameter(const KernelId id, const std::string& parameterName, const std::vector<size_t>& parameterValues)
 {
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
     kernelManager.addParameter(id, parameterName, parameterValues);
 }
 
 void TunerCore::addParameter(const KernelId id, const std::string& parameterName, const std::vector<double>& parameterValues)
 {
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
     kernelManager.addParameter(id, parameterName, parameterValues);
 }
 
 void TunerCore::addConstraint(const KernelId id, const std::vector<std::string>& parameterNames,
     const std::function<bool(const std::vector<size_t>&)>& constraintFunction)
 {
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
     kernelManager.addConstraint(id, parameterNames, constraintFunction);
 }
 
 void TunerCore::addParameterPack(const KernelId id, const std::string& packName, const std::vector<std::string>& parameterNames)
 {
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
     kernelManager.addParameterPack(id, packName, parameterNames);
 }
 
 void TunerCore::setThreadModifier(const KernelId id, const ModifierType modifierType, const ModifierDimension modifierDimension,
     const std::vector<std::string>& parameterNames, const std::function<size_t(const size_t, const std::vector<size_t>&)>& modifierFunction)
 {
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
     kernelManager.setThreadModifier(id, modifierType, modifierDimension, parameterNames, modifierFunction);
 }
 
 void TunerCore::setLocalMemoryModifier(const KernelId id, const ArgumentId argumentId, const std::vector<std::string>& parameterNames,
     const std::function<size_t(const size_t, const std::vector<size_t>&)>& modifierFunction)
 {
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
     kernelManager.setLocalMemoryModifier(id, argumentId, parameterNames, modifierFunction);
 }
 
 
 void TunerCore::setKernelArguments(const KernelId id, const std::vector<ArgumentId>& argumentIds)
 {
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
+
     for (const auto argumentId : argumentIds)
     {
         if (argumentId >= argumentManager.getArgumentCount())
@@ -118,6 +149,8 @@ void TunerCore::setKernelArguments(const KernelId id, const std::vector<Argument
 
 std::string TunerCore::getKernelSource(const KernelId id, const std::vector<ParameterPair>& configuration) const
 {
+    SharedLockGuard lock(metadataLock);
+
     if (!kernelManager.isKernel(id))
     {
         throw std::runtime_error(std::string("Invalid kernel id: ") + std::to_string(id));
@@ -125,57 +158,246 @@ std::string TunerCore::getKernelSource(const KernelId id, const std::vector<Para
     return kernelManager.getKernelSourceWithDefines(id, configuration);
 }
 
+uint64_t TunerCore::getConfigurationSpaceSize(const KernelId id) const
+{
+    SharedLockGuard lock(metadataLock);
+
+    if (!kernelManager.isKernel(id))
+    {
+        throw std::runtime_error(std::string("Invalid kernel id: ") + std::to_string(id));
+    }
+    return kernelManager.getKernel(id).getConfigurationSpace().getSize();
+}
+
+uint64_t TunerCore::getNextValidConfigurationIndex(const KernelId id, const uint64_t index) const
+{
+    SharedLockGuard lock(metadataLock);
+
+    if (!kernelManager.isKernel(id))
+    {
+        throw std::runtime_error(std::string("Invalid kernel id: ") + std::to_string(id));
+    }
+    return kernelManager.getKernel(id).getConfigurationSpace().getNextValidIndex(index);
+}
+
+std::vector<ParameterPair> TunerCore::getConfiguration(const KernelId id, const uint64_t index) const
+{
+    SharedLockGuard lock(metadataLock);
+
+    if (!kernelManager.isKernel(id))
+    {
+        throw std::runtime_error(std::string("Invalid kernel id: ") + std::to_string(id));
+    }
+    return kernelManager.getKernel(id).getConfigurationSpace().getConfiguration(index);
+}
+
 
 ArgumentId TunerCore::addArgument(void* data, const size_t numberOfElements, const size_t elementSizeInBytes, const ArgumentDataType dataType,
     const ArgumentMemoryLocation memoryLocation, const ArgumentAccessType accessType, const ArgumentUploadType uploadType, const bool copyData)
 {
-    return argumentManager.addArgument(data, numberOfElements, elementSizeInBytes, dataType, memoryLocation, accessType, uploadType, copyData);
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
+    const ArgumentMemoryLocation location = memoryLocation == ArgumentMemoryLocation::Auto
+        ? computeEngine->getAutomaticMemoryLocation(accessType) : memoryLocation;
+    return argumentManager.addArgument(data, numberOfElements, elementSizeInBytes, dataType, location, accessType, uploadType, copyData);
 }
 
 ArgumentId TunerCore::addArgument(const void* data, const size_t numberOfElements, const size_t elementSizeInBytes, const ArgumentDataType dataType,
     const ArgumentMemoryLocation memoryLocation, const ArgumentAccessType accessType, const ArgumentUploadType uploadType)
 {
-    return argumentManager.addArgument(data, numberOfElements, elementSizeInBytes, dataType, memoryLocation, accessType, uploadType);
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
+    const ArgumentMemoryLocation location = memoryLocation == ArgumentMemoryLocation::Auto
+        ? computeEngine->getAutomaticMemoryLocation(accessType) : memoryLocation;
+    return argumentManager.addArgument(data, numberOfElements, elementSizeInBytes, dataType, location, accessType, uploadType);
+}
+
+void TunerCore::updateArgument(const ArgumentId id, void* data, const size_t numberOfElements, const size_t elementSizeInBytes)
+{
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
+    checkArgumentElementSize(id, elementSizeInBytes);
+    argumentManager.updateArgument(id, data, numberOfElements);
+}
+
+void TunerCore::updateArgument(const ArgumentId id, const void* data, const size_t numberOfElements, const size_t elementSizeInBytes)
+{
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
+    checkArgumentElementSize(id, elementSizeInBytes);
+    argumentManager.updateArgument(id, data, numberOfElements);
+}
+
+void TunerCore::setArgumentFillPattern(const ArgumentId id, const void* pattern, const size_t patternSize)
+{
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
+    argumentManager.setFillPattern(id, pattern, patternSize);
+}
+
+void TunerCore::setResidentArguments(const bool flag)
+{
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
+    kernelRunner->setResidentArgumentUsage(flag);
+}
+
+void TunerCore::releaseArgument(const ArgumentId id)
+{
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
+
+    if (id >= argumentManager.getArgumentCount())
+    {
+        throw std::runtime_error(std::string("Invalid argument id: ") + std::to_string(id));
+    }
+    kernelRunner->releaseArgument(id);
+}
+
+void TunerCore::setDeviceMemoryBudget(const size_t budget)
+{
+    computeEngine->setDeviceMemoryBudget(budget);
+}
+
+DeviceMemoryStatistics TunerCore::getDeviceMemoryStatistics() const
+{
+    return computeEngine->getDeviceMemoryStatistics();
+}
+
+void TunerCore::setConcurrentSubmission(const bool flag)
+{
+    kernelRunner->setConcurrentSubmission(flag);
 }
 
 ComputationResult TunerCore::runKernel(const KernelId id, const std::vector<ParameterPair>& configuration,
     const std::vector<OutputDescriptor>& output)
 {
+    SharedLockGuard lock(metadataLock);
     KernelResult result;
+    kernelRunner->beginRun();
 
-    result = kernelRunner->runKernel(id, KernelRunMode::Running, configuration, output);
+    try
+    {
+        result = kernelRunner->runKernel(id, KernelRunMode::Running, configuration, output);
+    }
+    catch (...)
+    {
+        kernelRunner->endRun();
+        throw;
+    }
+
+    kernelRunner->endRun();
+    return createComputationResult(result);
+}
 
-    kernelRunner->clearBuffers();
 
-    if (result.isValid())
+
+std::vector<std::future<void>> TunerCore::precompile(const KernelId id, const std::vector<std::vector<ParameterPair>>& configurations)
+{
+    SharedLockGuard lock(metadataLock);
+    return kernelRunner->precompileKernel(id, configurations);
+}
+
+LaunchId TunerCore::prepareLaunch(const KernelId id, const std::vector<ParameterPair>& configuration)
+{
+    SharedLockGuard lock(metadataLock);
+    return kernelRunner->prepareLaunch(id, configuration);
+}
+
+ComputationResult TunerCore::launch(const LaunchId id, const std::vector<OutputDescriptor>& output)
+{
+    SharedLockGuard lock(metadataLock);
+    KernelResult result;
+    kernelRunner->beginRun();
+
+    try
     {
-        return ComputationResult(result.getKernelName(), result.getConfiguration().getParameterPairs(), result.getComputationDuration());
+        result = kernelRunner->launch(id, output);
     }
-    else
+    catch (...)
     {
-        return ComputationResult(result.getKernelName(), result.getConfiguration().getParameterPairs(), result.getErrorMessage());
+        kernelRunner->endRun();
+        throw;
     }
+
+    kernelRunner->endRun();
+    return createComputationResult(result);
+}
+
+void TunerCore::releaseLaunch(const LaunchId id)
+{
+    SharedLockGuard lock(metadataLock);
+    kernelRunner->releaseLaunch(id);
 }
 
+EventId TunerCore::runKernelAsync(const KernelId id, const std::vector<ParameterPair>& configuration, const QueueId queue)
+{
+    SharedLockGuard lock(metadataLock);
+    return kernelRunner->runKernelAsync(id, configuration, queue);
+}
+
+std::vector<ComputationResult> TunerCore::runGraph(const KernelGraph& graph, const std::vector<OutputDescriptor>& output)
+{
+    SharedLockGuard lock(metadataLock);
+    std::vector<KernelResult> results;
+    kernelRunner->beginRun();
+
+    try
+    {
+        results = kernelRunner->runGraph(graph, output);
+    }
+    catch (...)
+    {
+        kernelRunner->endRun();
+        throw;
+    }
+
+    kernelRunner->endRun();
+    std::vector<ComputationResult> computationResults;
+
+    for (const auto& result : results)
+    {
+        computationResults.push_back(createComputationResult(result));
+    }
+
+    return computationResults;
+}
+
+ComputationResult TunerCore::getKernelResult(const EventId id, const std::vector<OutputDescriptor>& output)
+{
+    SharedLockGuard lock(metadataLock);
+
+    // Buffers are not released after asynchronous runs, other queues may still be using them
+    KernelResult result = kernelRunner->getKernelResult(id, output);
+    return createComputationResult(result);
+}
 
+std::vector<ComputationResult> TunerCore::tuneKernel(const KernelId id, std::unique_ptr<StopCondition> stopCondition,
+    std::unique_ptr<Searcher> searcher)
+{
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
+    return tuningRunner->tuneKernel(id, std::move(stopCondition), std::move(searcher));
+}
 
 void TunerCore::setCompilerOptions(const std::string& options)
 {
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
+    kernelRunner->waitForPrecompilation();
     computeEngine->setCompilerOptions(options);
 }
 
 void TunerCore::setGlobalSizeType(const GlobalSizeType type)
 {
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
+    kernelRunner->waitForPrecompilation();
     computeEngine->setGlobalSizeType(type);
 }
 
 void TunerCore::setAutomaticGlobalSizeCorrection(const bool flag)
 {
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
+    kernelRunner->waitForPrecompilation();
     computeEngine->setAutomaticGlobalSizeCorrection(flag);
 }
 
 void TunerCore::setKernelCacheCapacity(const size_t capacity)
 {
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
+    kernelRunner->waitForPrecompilation();
+
     if (capacity == 0)
     {
         computeEngine->setKernelCacheUsage(false);
@@ -187,8 +409,35 @@ void TunerCore::setKernelCacheCapacity(const size_t capacity)
     computeEngine->setKernelCacheCapacity(capacity);
 }
 
+void TunerCore::setKernelCacheByteBudget(const size_t budget)
+{
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
+    kernelRunner->waitForPrecompilation();
+    computeEngine->setKernelCacheByteBudget(budget);
+}
+
+void TunerCore::setKernelCacheEvictionPolicy(const KernelCacheEvictionPolicy policy)
+{
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
+    kernelRunner->waitForPrecompilation();
+    computeEngine->setKernelCacheEvictionPolicy(policy);
+}
+
+KernelCacheStatistics TunerCore::getKernelCacheStatistics() const
+{
+    return computeEngine->getKernelCacheStatistics();
+}
+
+void TunerCore::setPersistentKernelCache(const std::string& directory, const size_t maxSizeInBytes)
+{
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
+    kernelRunner->waitForPrecompilation();
+    computeEngine->setPersistentKernelCache(directory, maxSizeInBytes);
+}
+
 void TunerCore::persistArgument(const ArgumentId id, const bool flag)
 {
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
     argumentManager.setPersistentFlag(id, flag);
     KernelArgument& argument = argumentManager.getArgument(id);
     computeEngine->persistArgument(argument, flag);
@@ -199,6 +448,53 @@ void TunerCore::downloadPersistentArgument(const OutputDescriptor& output) const
     computeEngine->downloadArgument(output.getArgumentId(), output.getOutputDestination(), output.getOutputSizeInBytes());
 }
 
+EventId TunerCore::uploadArgumentAsync(const ArgumentId id, const QueueId queue)
+{
+    std::lock_guard<ReadWriteLock> lock(metadataLock);
+    KernelArgument& argument = argumentManager.getArgument(id);
+
+    if (argument.isPersistent())
+    {
+        throw std::runtime_error(std::string("Persistent argument cannot be uploaded asynchronously, argument id: ") + std::to_string(id));
+    }
+
+    // Explicit upload replaces current buffer of the argument, so that it reflects the latest host data. Asynchronous runs and transfers
+    // on other queues may still use the current buffer, it can only be released once all queues are finished.
+    computeEngine->synchronizeDevice();
+    kernelRunner->releaseArgument(id);
+    return computeEngine->uploadArgumentAsync(argument, queue);
+}
+
+EventId TunerCore::downloadArgumentAsync(const OutputDescriptor& output, const QueueId queue) const
+{
+    return computeEngine->downloadArgumentAsync(output.getArgumentId(), output.getOutputDestination(), output.getOutputSizeInBytes(), queue);
+}
+
+uint64_t TunerCore::getArgumentOperationDuration(const EventId id) const
+{
+    return computeEngine->getArgumentOperationDuration(id);
+}
+
+QueueId TunerCore::getDefaultQueue() const
+{
+    return computeEngine->getDefaultQueue();
+}
+
+std::vector<QueueId> TunerCore::getAllQueues() const
+{
+    return computeEngine->getAllQueues();
+}
+
+void TunerCore::synchronizeQueue(const QueueId queue)
+{
+    computeEngine->synchronizeQueue(queue);
+}
+
+void TunerCore::synchronizeDevice()
+{
+    computeEngine->synchronizeDevice();
+}
+
 void TunerCore::printComputeAPIInfo(std::ostream& outputTarget) const
 {
     computeEngine->printComputeAPIInfo(outputTarget);
@@ -239,4 +535,30 @@ void TunerCore::log(const LoggingLevel level, const std::string& message)
     Logger::getLogger().log(level, message);
 }
 
+ComputationResult TunerCore::createComputationResult(const KernelResult& result)
+{
+    if (result.isValid())
+    {
+        return ComputationResult(result.getKernelName(), result.getConfiguration().getParameterPairs(), result.getComputationDuration());
+    }
+    else
+    {
+        return ComputationResult(result.getKernelName(), result.getConfiguration().getParameterPairs(), result.getErrorMessage());
+    }
+}
+
+void TunerCore::checkArgumentElementSize(const ArgumentId id, const size_t elementSizeInBytes) const
+{
+    if (id >= argumentManager.getArgumentCount())
+    {
+        throw std::runtime_error(std::string("Invalid argument id: ") + std::to_string(id));
+    }
+
+    if (argumentManager.getArgument(id).getElementSizeInBytes() != elementSizeInBytes)
+    {
+        throw std::runtime_error(std::string("Element size of updated data does not match element size of argument with id: ")
+            + std::to_string(id));
+    }
+}
+
 } // namespace fly
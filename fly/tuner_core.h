@@ -1,15 +1,19 @@
 #pragma once
 
 #include <fstream>
+#include <future>
 #include <memory>
 #include <vector>
 #include "fly/api/computation_result.h"
+#include "fly/api/host_kernel_context.h"
 #include "fly/compute_engine/compute_engine.h"
 #include "fly/enum/compute_api.h"
 #include "fly/kernel/kernel_manager.h"
 #include "fly/kernel_argument/argument_manager.h"
 #include "fly/tuning_runner/kernel_runner.h"
+#include "fly/tuning_runner/tuning_runner.h"
 #include "fly/utility/logger.h"
+#include "fly/utility/read_write_lock.h"
 #include "fly/fly_types.h"
 
 namespace fly
@@ -26,6 +30,8 @@ public:
         const DimensionVector& localSize);
     KernelId addKernelFromFile(const std::string& filePath, const std::string& kernelName, const DimensionVector& globalSize,
         const DimensionVector& localSize);
+    KernelId addHostKernel(const std::string& kernelName, const HostKernelFunction& kernelFunction, const DimensionVector& globalSize,
+        const DimensionVector& localSize);
   
     void addParameter(const KernelId id, const std::string& parameterName, const std::vector<size_t>& parameterValues);
     void addParameter(const KernelId id, const std::string& parameterName, const std::vector<double>& parameterValues);
@@ -40,6 +46,9 @@ public:
    
     void setKernelArguments(const KernelId id, const std::vector<ArgumentId>& argumentIds);
     std::string getKernelSource(const KernelId id, const std::vector<ParameterPair>& configuration) const;
+    uint64_t getConfigurationSpaceSize(const KernelId id) const;
+    uint64_t getNextValidConfigurationIndex(const KernelId id, const uint64_t index) const;
+    std::vector<ParameterPair> getConfiguration(const KernelId id, const uint64_t index) const;
  
     // Argument manager methods
     ArgumentId addArgument(void* data, const size_t numberOfElements, const size_t elementSizeInBytes, const ArgumentDataType dataType,
@@ -47,9 +56,27 @@ public:
         const bool copyData);
     ArgumentId addArgument(const void* data, const size_t numberOfElements, const size_t elementSizeInBytes, const ArgumentDataType dataType,
         const ArgumentMemoryLocation memoryLocation, const ArgumentAccessType accessType, const ArgumentUploadType uploadType);
+    void updateArgument(const ArgumentId id, void* data, const size_t numberOfElements, const size_t elementSizeInBytes);
+    void updateArgument(const ArgumentId id, const void* data, const size_t numberOfElements, const size_t elementSizeInBytes);
+    void setArgumentFillPattern(const ArgumentId id, const void* pattern, const size_t patternSize);
 
     // Kernel runner methods
     ComputationResult runKernel(const KernelId id, const std::vector<ParameterPair>& configuration, const std::vector<OutputDescriptor>& output);
+    void setResidentArguments(const bool flag);
+    void releaseArgument(const ArgumentId id);
+    void setDeviceMemoryBudget(const size_t budget);
+    DeviceMemoryStatistics getDeviceMemoryStatistics() const;
+    void setConcurrentSubmission(const bool flag);
+    std::vector<std::future<void>> precompile(const KernelId id, const std::vector<std::vector<ParameterPair>>& configurations);
+    LaunchId prepareLaunch(const KernelId id, const std::vector<ParameterPair>& configuration);
+    ComputationResult launch(const LaunchId id, const std::vector<OutputDescriptor>& output);
+    void releaseLaunch(const LaunchId id);
+    EventId runKernelAsync(const KernelId id, const std::vector<ParameterPair>& configuration, const QueueId queue);
+    ComputationResult getKernelResult(const EventId id, const std::vector<OutputDescriptor>& output);
+    std::vector<ComputationResult> runGraph(const KernelGraph& graph, const std::vector<OutputDescriptor>& output);
+
+    // Tuning runner methods
+    std::vector<ComputationResult> tuneKernel(const KernelId id, std::unique_ptr<StopCondition> stopCondition, std::unique_ptr<Searcher> searcher);
 
 
     
@@ -58,8 +85,19 @@ public:
     void setGlobalSizeType(const GlobalSizeType type);
     void setAutomaticGlobalSizeCorrection(const bool flag);
     void setKernelCacheCapacity(const size_t capacity);
+    void setKernelCacheByteBudget(const size_t budget);
+    void setKernelCacheEvictionPolicy(const KernelCacheEvictionPolicy policy);
+    KernelCacheStatistics getKernelCacheStatistics() const;
+    void setPersistentKernelCache(const std::string& directory, const size_t maxSizeInBytes);
     void persistArgument(const ArgumentId id, const bool flag);
     void downloadPersistentArgument(const OutputDescriptor& output) const;
+    EventId uploadArgumentAsync(const ArgumentId id, const QueueId queue);
+    EventId downloadArgumentAsync(const OutputDescriptor& output, const QueueId queue) const;
+    uint64_t getArgumentOperationDuration(const EventId id) const;
+    QueueId getDefaultQueue() const;
+    std::vector<QueueId> getAllQueues() const;
+    void synchronizeQueue(const QueueId queue);
+    void synchronizeDevice();
     void printComputeAPIInfo(std::ostream& outputTarget) const;
     std::vector<PlatformInfo> getPlatformInfo() const;
     std::vector<DeviceInfo> getDeviceInfo(const PlatformIndex platform) const;
@@ -77,6 +115,14 @@ private:
     KernelManager kernelManager;
     std::unique_ptr<ComputeEngine> computeEngine;
     std::unique_ptr<KernelRunner> kernelRunner;
+    std::unique_ptr<TuningRunner> tuningRunner;
+    // Runs and metadata queries share the lock, calls which modify kernels, arguments or settings used to build kernels wait for runs in
+    // progress. Engines can then compile kernels without holding their own lock.
+    mutable ReadWriteLock metadataLock;
+
+    // Helper methods
+    static ComputationResult createComputationResult(const KernelResult& result);
+    void checkArgumentElementSize(const ArgumentId id, const size_t elementSizeInBytes) const;
 };
 
 } // namespace fly
@@ -0,0 +1,88 @@
+#include <utility>
+#include <fly/tuning_runner/kernel_compile_service.h>
+
+namespace fly
+{
+
+KernelCompileService::KernelCompileService(const uint32_t workerCount) :
+    activeTaskCount(0),
+    stopFlag(false)
+{
+    const uint32_t count = workerCount == 0 ? 1 : workerCount;
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        workers.emplace_back(&KernelCompileService::processTasks, this);
+    }
+}
+
+KernelCompileService::~KernelCompileService()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopFlag = true;
+
+        // Tasks which did not start yet are abandoned, their futures report broken promise
+        tasks.clear();
+    }
+    taskCondition.notify_all();
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+std::future<void> KernelCompileService::enqueueTask(const std::function<void()>& task)
+{
+    std::packaged_task<void()> packagedTask(task);
+    std::future<void> result = packagedTask.get_future();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(packagedTask));
+    }
+    taskCondition.notify_one();
+
+    return result;
+}
+
+void KernelCompileService::waitForTasks()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    idleCondition.wait(lock, [this]() { return tasks.empty() && activeTaskCount == 0; });
+}
+
+uint32_t KernelCompileService::getWorkerCount() const
+{
+    return static_cast<uint32_t>(workers.size());
+}
+
+void KernelCompileService::processTasks()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true)
+    {
+        taskCondition.wait(lock, [this]() { return stopFlag || !tasks.empty(); });
+
+        if (stopFlag)
+        {
+            return;
+        }
+
+        std::packaged_task<void()> task = std::move(tasks.front());
+        tasks.pop_front();
+        activeTaskCount++;
+        lock.unlock();
+
+        // Exceptions thrown by task are stored in its future
+        task();
+
+        lock.lock();
+        activeTaskCount--;
+        idleCondition.notify_all();
+    }
+}
+
+} // namespace fly
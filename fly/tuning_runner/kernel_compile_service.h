@@ -0,0 +1,44 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fly
+{
+
+// Worker pool which builds kernels in background, tasks submitted to the service run concurrently on all workers
+class KernelCompileService
+{
+public:
+    // Constructor
+    explicit KernelCompileService(const uint32_t workerCount);
+    ~KernelCompileService();
+
+    // Core methods
+    std::future<void> enqueueTask(const std::function<void()>& task);
+    void waitForTasks();
+
+    // Getters
+    uint32_t getWorkerCount() const;
+
+private:
+    // Attributes
+    std::vector<std::thread> workers;
+    std::deque<std::packaged_task<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable taskCondition;
+    std::condition_variable idleCondition;
+    uint32_t activeTaskCount;
+    bool stopFlag;
+
+    // Helper methods
+    void processTasks();
+};
+
+} // namespace fly
@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <fly/tuning_runner/kernel_graph_scheduler.h>
+
+namespace fly
+{
+
+KernelGraphScheduler::KernelGraphScheduler(const KernelGraph& graph, const std::vector<std::vector<KernelArgument*>>& nodeArguments,
+    const std::vector<QueueId>& queues)
+{
+    if (queues.empty())
+    {
+        throw std::runtime_error("Kernel graph cannot be scheduled without compute queues");
+    }
+
+    inferDependencies(graph, nodeArguments);
+    assignQueues(queues);
+}
+
+const std::vector<size_t>& KernelGraphScheduler::getDependencies(const size_t node) const
+{
+    return dependencies.at(node);
+}
+
+QueueId KernelGraphScheduler::getQueue(const size_t node) const
+{
+    return nodeQueues.at(node);
+}
+
+void KernelGraphScheduler::inferDependencies(const KernelGraph& graph, const std::vector<std::vector<KernelArgument*>>& nodeArguments)
+{
+    const size_t noWriter = std::numeric_limits<size_t>::max();
+    std::map<ArgumentId, size_t> lastWriters;
+    std::map<ArgumentId, std::vector<size_t>> readersSinceWrite;
+
+    dependencies.resize(graph.getNodeCount());
+
+    for (size_t node = 0; node < graph.getNodeCount(); ++node)
+    {
+        std::vector<size_t>& nodeDependencies = dependencies[node];
+        nodeDependencies = graph.getDependencies(node);
+
+        for (const auto argument : nodeArguments[node])
+        {
+            if (argument->getUploadType() != ArgumentUploadType::Vector)
+            {
+                continue;
+            }
+
+            const ArgumentId id = argument->getId();
+            const ArgumentAccessType accessType = argument->getAccessType();
+            const bool reads = accessType != ArgumentAccessType::WriteOnly;
+            const bool writes = accessType != ArgumentAccessType::ReadOnly;
+
+            auto writerPointer = lastWriters.find(id);
+            const size_t lastWriter = writerPointer != lastWriters.end() ? writerPointer->second : noWriter;
+
+            // Reads wait for the last write, writes additionally wait for all reads of the previous value
+            if (lastWriter != noWriter)
+            {
+                nodeDependencies.push_back(lastWriter);
+            }
+
+            if (writes)
+            {
+                std::vector<size_t>& readers = readersSinceWrite[id];
+                nodeDependencies.insert(nodeDependencies.end(), readers.begin(), readers.end());
+                readers.clear();
+                lastWriters[id] = node;
+            }
+            else if (reads)
+            {
+                readersSinceWrite[id].push_back(node);
+            }
+        }
+
+        std::sort(nodeDependencies.begin(), nodeDependencies.end());
+        nodeDependencies.erase(std::unique(nodeDependencies.begin(), nodeDependencies.end()), nodeDependencies.end());
+        nodeDependencies.erase(std::remove(nodeDependencies.begin(), nodeDependencies.end(), node), nodeDependencies.end());
+    }
+}
+
+void KernelGraphScheduler::assignQueues(const std::vector<QueueId>& queues)
+{
+    const size_t noNode = std::numeric_limits<size_t>::max();
+    std::vector<size_t> queueTails(queues.size(), noNode);
+    std::vector<size_t> queueLoads(queues.size(), 0);
+    std::vector<size_t> nodeQueueIndices(dependencies.size(), 0);
+
+    nodeQueues.resize(dependencies.size());
+
+    for (size_t node = 0; node < dependencies.size(); ++node)
+    {
+        size_t queueIndex = noNode;
+
+        // Node appended right after one of its dependencies on the same queue continues the chain
+        for (auto dependency = dependencies[node].rbegin(); dependency != dependencies[node].rend(); ++dependency)
+        {
+            if (queueTails[nodeQueueIndices[*dependency]] == *dependency)
+            {
+                queueIndex = nodeQueueIndices[*dependency];
+                break;
+            }
+        }
+
+        if (queueIndex == noNode)
+        {
+            queueIndex = static_cast<size_t>(std::min_element(queueLoads.begin(), queueLoads.end()) - queueLoads.begin());
+        }
+
+        nodeQueueIndices[node] = queueIndex;
+        nodeQueues[node] = queues[queueIndex];
+        queueTails[queueIndex] = node;
+        ++queueLoads[queueIndex];
+    }
+}
+
+} // namespace fly
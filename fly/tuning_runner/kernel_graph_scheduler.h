@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <fly/api/kernel_graph.h>
+#include <fly/kernel_argument/kernel_argument.h>
+#include <fly/fly_types.h>
+
+namespace fly
+{
+
+// Computes dependencies of kernel graph nodes and distributes nodes among compute queues. Chains of dependent nodes stay on one queue,
+// independent branches are placed on the least loaded queues.
+class KernelGraphScheduler
+{
+public:
+    // Constructor
+    explicit KernelGraphScheduler(const KernelGraph& graph, const std::vector<std::vector<KernelArgument*>>& nodeArguments,
+        const std::vector<QueueId>& queues);
+
+    // Getters
+    const std::vector<size_t>& getDependencies(const size_t node) const;
+    QueueId getQueue(const size_t node) const;
+
+private:
+    // Attributes
+    std::vector<std::vector<size_t>> dependencies;
+    std::vector<QueueId> nodeQueues;
+
+    // Helper methods
+    void inferDependencies(const KernelGraph& graph, const std::vector<std::vector<KernelArgument*>>& nodeArguments);
+    void assignQueues(const std::vector<QueueId>& queues);
+};
+
+} // namespace fly
@@ -3,6 +3,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <fly/tuning_runner/kernel_graph_scheduler.h>
 #include <fly/tuning_runner/kernel_runner.h>
 #include <fly/utility/fly_utility.h>
 #include <fly/utility/logger.h>
@@ -15,6 +16,10 @@ KernelRunner::KernelRunner(ArgumentManager* argumentManager, KernelManager* kern
     argumentManager(argumentManager),
     kernelManager(kernelManager),
     computeEngine(computeEngine),
+    residentArgumentFlag(false),
+    concurrentSubmissionFlag(false),
+    nextLaunchId(0),
+    activeRunCount(0),
     timeUnit(TimeUnit::Milliseconds)
 {}
 
@@ -33,15 +38,15 @@ KernelResult KernelRunner::runKernel(const KernelId id, const KernelRunMode mode
     stream << "Running kernel " << kernel.getName() << " with configuration: " << configuration;
     Logger::getLogger().log(LoggingLevel::Info, stream.str());
 
+    const QueueId queue = getSubmissionQueue();
     KernelResult result;
     try
     {
-        result = runKernelSimple(kernel, mode, configuration, output);
+        result = runKernelSimple(kernel, mode, configuration, output, queue);
     }
     catch (const std::runtime_error& error)
     {
-        computeEngine->synchronizeDevice();
-        computeEngine->clearEvents();
+        recoverFromFailure(queue);
         Logger::getLogger().log(LoggingLevel::Warning, std::string("Kernel run failed, reason: ") + error.what());
         result = KernelResult(kernel.getName(), configuration, error.what());
     }
@@ -56,6 +61,299 @@ KernelResult KernelRunner::runKernel(const KernelId id, const KernelRunMode mode
     return runKernel(id, mode, launchConfiguration, output);
 }
 
+std::vector<std::future<void>> KernelRunner::precompileKernel(const KernelId id, const std::vector<std::vector<ParameterPair>>& configurations)
+{
+    if (!kernelManager->isKernel(id))
+    {
+        throw std::runtime_error(std::string("Invalid kernel id: ") + std::to_string(id));
+    }
+
+    {
+        // Multiple threads may submit precompilation under shared tuner lock
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (compileService == nullptr)
+        {
+            compileService = MakeStdUnique<KernelCompileService>(std::thread::hardware_concurrency());
+        }
+    }
+
+    const Kernel& kernel = kernelManager->getKernel(id);
+    std::vector<std::future<void>> result;
+    ComputeEngine* engine = computeEngine;
+
+    for (const auto& configuration : configurations)
+    {
+        const KernelConfiguration launchConfiguration = kernelManager->getKernelConfiguration(id, configuration);
+        const KernelRuntimeData kernelData = createKernelRuntimeData(kernel, launchConfiguration);
+        result.push_back(compileService->enqueueTask([engine, kernelData]() { engine->compileKernel(kernelData); }));
+    }
+
+    Logger::getLogger().log(LoggingLevel::Debug, std::string("Submitted ") + std::to_string(configurations.size())
+        + " configurations of kernel " + kernel.getName() + " for background compilation");
+    return result;
+}
+
+void KernelRunner::waitForPrecompilation()
+{
+    // Background compilation reads compiler options and kernel cache settings of compute engine without holding its lock, so settings
+    // can only be changed once all submitted tasks are finished
+    if (compileService != nullptr)
+    {
+        compileService->waitForTasks();
+    }
+}
+
+LaunchId KernelRunner::prepareLaunch(const KernelId id, const std::vector<ParameterPair>& configuration)
+{
+    if (!kernelManager->isKernel(id))
+    {
+        throw std::runtime_error(std::string("Invalid kernel id: ") + std::to_string(id));
+    }
+
+    const Kernel& kernel = kernelManager->getKernel(id);
+    const KernelConfiguration launchConfiguration = kernelManager->getKernelConfiguration(id, configuration);
+    const KernelRuntimeData kernelData = createKernelRuntimeData(kernel, launchConfiguration);
+
+    LaunchId launchId;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        launchId = nextLaunchId;
+        nextLaunchId++;
+    }
+
+    computeEngine->prepareKernel(launchId, kernelData);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        preparedLaunches.insert(std::make_pair(launchId, std::make_pair(id, launchConfiguration)));
+    }
+
+    Logger::getLogger().log(LoggingLevel::Debug, std::string("Prepared launch ") + std::to_string(launchId) + " of kernel " + kernel.getName());
+    return launchId;
+}
+
+KernelResult KernelRunner::launch(const LaunchId id, const std::vector<OutputDescriptor>& output)
+{
+    KernelId kernelId;
+    KernelConfiguration configuration;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto launchPointer = preparedLaunches.find(id);
+
+        if (launchPointer == preparedLaunches.end())
+        {
+            throw std::runtime_error(std::string("Invalid launch id: ") + std::to_string(id));
+        }
+
+        kernelId = launchPointer->second.first;
+        configuration = launchPointer->second.second;
+    }
+
+    const Kernel& kernel = kernelManager->getKernel(kernelId);
+    const QueueId queue = getSubmissionQueue();
+
+    KernelResult result;
+    try
+    {
+        std::vector<KernelArgument*> arguments = argumentManager->getArguments(kernel.getArgumentIds());
+        refreshDirtyArguments(arguments);
+
+        const EventId eventId = computeEngine->runPreparedKernelAsync(id, arguments, queue);
+        result = computeEngine->getKernelResult(eventId, output);
+        result.setConfiguration(configuration);
+    }
+    catch (const std::runtime_error& error)
+    {
+        recoverFromFailure(queue);
+        Logger::getLogger().log(LoggingLevel::Warning, std::string("Kernel launch failed, reason: ") + error.what());
+        result = KernelResult(kernel.getName(), configuration, error.what());
+    }
+
+    return result;
+}
+
+void KernelRunner::releaseLaunch(const LaunchId id)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (preparedLaunches.erase(id) == 0)
+        {
+            throw std::runtime_error(std::string("Invalid launch id: ") + std::to_string(id));
+        }
+    }
+
+    computeEngine->releasePreparedKernel(id);
+}
+
+EventId KernelRunner::runKernelAsync(const KernelId id, const std::vector<ParameterPair>& configuration, const QueueId queue)
+{
+    if (!kernelManager->isKernel(id))
+    {
+        throw std::runtime_error(std::string("Invalid kernel id: ") + std::to_string(id));
+    }
+
+    const Kernel& kernel = kernelManager->getKernel(id);
+    const KernelConfiguration launchConfiguration = kernelManager->getKernelConfiguration(id, configuration);
+    const KernelRuntimeData kernelData = createKernelRuntimeData(kernel, launchConfiguration);
+
+    std::vector<KernelArgument*> arguments = argumentManager->getArguments(kernel.getArgumentIds());
+    refreshDirtyArguments(arguments);
+
+    // Asynchronous run keeps buffers alive until its result is retrieved, but it does not release them afterwards. Run is counted before
+    // submission, so that other threads cannot clear buffers which it has already recorded.
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        activeRunCount++;
+    }
+
+    EventId eventId;
+
+    try
+    {
+        eventId = computeEngine->runKernelAsync(kernelData, arguments, queue);
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        activeRunCount--;
+        throw;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    pendingKernelRuns.insert(std::make_pair(eventId, std::make_pair(id, launchConfiguration)));
+    return eventId;
+}
+
+KernelResult KernelRunner::getKernelResult(const EventId id, const std::vector<OutputDescriptor>& output)
+{
+    KernelId kernelId;
+    KernelConfiguration configuration;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto runPointer = pendingKernelRuns.find(id);
+
+        if (runPointer == pendingKernelRuns.end())
+        {
+            throw std::runtime_error(std::string("Kernel event with following id does not exist or its result was already retrieved: ")
+                + std::to_string(id));
+        }
+
+        kernelId = runPointer->second.first;
+        configuration = runPointer->second.second;
+        pendingKernelRuns.erase(runPointer);
+    }
+
+    KernelResult result;
+    try
+    {
+        result = computeEngine->getKernelResult(id, output);
+        result.setConfiguration(configuration);
+    }
+    catch (const std::runtime_error& error)
+    {
+        Logger::getLogger().log(LoggingLevel::Warning, std::string("Kernel run failed, reason: ") + error.what());
+        result = KernelResult(kernelManager->getKernel(kernelId).getName(), configuration, error.what());
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    activeRunCount--;
+    return result;
+}
+
+std::vector<KernelResult> KernelRunner::runGraph(const KernelGraph& graph, const std::vector<OutputDescriptor>& output)
+{
+    const size_t nodeCount = graph.getNodeCount();
+    std::vector<KernelConfiguration> configurations;
+    std::vector<std::vector<KernelArgument*>> nodeArguments;
+
+    for (size_t node = 0; node < nodeCount; ++node)
+    {
+        const KernelId id = graph.getKernelId(node);
+
+        if (!kernelManager->isKernel(id))
+        {
+            throw std::runtime_error(std::string("Invalid kernel id: ") + std::to_string(id));
+        }
+
+        configurations.push_back(kernelManager->getKernelConfiguration(id, graph.getConfiguration(node)));
+        nodeArguments.push_back(argumentManager->getArguments(kernelManager->getKernel(id).getArgumentIds()));
+        refreshDirtyArguments(nodeArguments.back());
+    }
+
+    const KernelGraphScheduler scheduler(graph, nodeArguments, computeEngine->getAllQueues());
+    std::vector<EventId> events;
+
+    // All nodes are submitted before waiting for any of them, dependencies are resolved by compute queues and intermediate buffers stay
+    // on device
+    try
+    {
+        for (size_t node = 0; node < nodeCount; ++node)
+        {
+            const QueueId queue = scheduler.getQueue(node);
+
+            for (const auto dependency : scheduler.getDependencies(node))
+            {
+                computeEngine->enqueueEventWait(queue, events[dependency]);
+            }
+
+            const Kernel& kernel = kernelManager->getKernel(graph.getKernelId(node));
+            const KernelRuntimeData kernelData = createKernelRuntimeData(kernel, configurations[node]);
+            events.push_back(computeEngine->runKernelAsync(kernelData, nodeArguments[node], queue));
+        }
+    }
+    catch (const std::runtime_error&)
+    {
+        computeEngine->synchronizeDevice();
+
+        // Unrelated pending events of the caller and of other threads stay untouched, only events of already submitted nodes are discarded
+        for (const auto event : events)
+        {
+            try
+            {
+                computeEngine->getKernelResult(event, {});
+            }
+            catch (const std::runtime_error&)
+            {}
+        }
+
+        throw;
+    }
+
+    Logger::getLogger().log(LoggingLevel::Debug, std::string("Submitted kernel graph with ") + std::to_string(nodeCount) + " nodes to "
+        + std::to_string(computeEngine->getAllQueues().size()) + " queues");
+
+    std::vector<KernelResult> results;
+
+    for (size_t node = 0; node < nodeCount; ++node)
+    {
+        const Kernel& kernel = kernelManager->getKernel(graph.getKernelId(node));
+
+        try
+        {
+            KernelResult result = computeEngine->getKernelResult(events[node], {});
+            result.setConfiguration(configurations[node]);
+            results.push_back(result);
+        }
+        catch (const std::runtime_error& error)
+        {
+            Logger::getLogger().log(LoggingLevel::Warning, std::string("Kernel graph node ") + std::to_string(node) + " failed, reason: "
+                + error.what());
+            results.push_back(KernelResult(kernel.getName(), configurations[node], error.what()));
+        }
+    }
+
+    for (const auto& descriptor : output)
+    {
+        computeEngine->downloadArgument(descriptor.getArgumentId(), descriptor.getOutputDestination(), descriptor.getOutputSizeInBytes());
+    }
+
+    return results;
+}
 
 void KernelRunner::setTimeUnit(const TimeUnit unit)
 {
@@ -84,23 +382,151 @@ void KernelRunner::setPersistentArgumentUsage(const bool flag)
     computeEngine->setPersistentBufferUsage(flag);
 }
 
+void KernelRunner::setResidentArgumentUsage(const bool flag)
+{
+    residentArgumentFlag = flag;
+
+    if (!flag)
+    {
+        computeEngine->clearBuffers();
+    }
+}
+
+bool KernelRunner::getResidentArgumentUsage() const
+{
+    return residentArgumentFlag;
+}
+
+void KernelRunner::releaseArgument(const ArgumentId id)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    KernelArgument& argument = argumentManager->getArgument(id);
+    computeEngine->clearBuffer(id);
+    argument.setDirtyFlag(false);
+}
+
+void KernelRunner::setConcurrentSubmission(const bool flag)
+{
+    concurrentSubmissionFlag = flag;
+}
+
+bool KernelRunner::getConcurrentSubmission() const
+{
+    return concurrentSubmissionFlag;
+}
+
+QueueId KernelRunner::getSubmissionQueue()
+{
+    if (!concurrentSubmissionFlag)
+    {
+        return computeEngine->getDefaultQueue();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    const std::thread::id threadId = std::this_thread::get_id();
+    auto queuePointer = threadQueues.find(threadId);
+
+    if (queuePointer != threadQueues.end())
+    {
+        return queuePointer->second;
+    }
+
+    // Queues are assigned to threads in round-robin order on their first submission, so that independent requests overlap on device
+    const std::vector<QueueId> queues = computeEngine->getAllQueues();
+    const QueueId queue = queues.at(threadQueues.size() % queues.size());
+    threadQueues.insert(std::make_pair(threadId, queue));
+
+    Logger::getLogger().log(LoggingLevel::Debug, std::string("Assigned queue ") + std::to_string(queue) + " to submitting thread");
+    return queue;
+}
+
+void KernelRunner::beginRun()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    activeRunCount++;
+}
+
+void KernelRunner::endRun()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    activeRunCount--;
+
+    // Buffers cannot be released while other threads are still running kernels which use them
+    if (activeRunCount == 0 && !residentArgumentFlag)
+    {
+        computeEngine->clearBuffers();
+    }
+}
+
 KernelResult KernelRunner::runKernelSimple(const Kernel& kernel, const KernelRunMode mode, const KernelConfiguration& configuration,
-    const std::vector<OutputDescriptor>& output)
+    const std::vector<OutputDescriptor>& output, const QueueId queue)
 {
-    KernelId kernelId = kernel.getId();
-    const std::string& kernelName = kernel.getName();
-    std::string source = kernelManager->getKernelSourceWithDefines(kernelId, configuration);
-    
-    KernelRuntimeData kernelData(kernelId, kernelName, source, kernel.getSource(), configuration.getGlobalSize(), configuration.getLocalSize(),
-        configuration.getParameterPairs(), kernel.getArgumentIds(), configuration.getLocalMemoryModifiers());
+    KernelRuntimeData kernelData = createKernelRuntimeData(kernel, configuration);
+    std::vector<KernelArgument*> arguments = argumentManager->getArguments(kernel.getArgumentIds());
+    refreshDirtyArguments(arguments);
 
     KernelResult result;
-    result = computeEngine->runKernel(kernelData, argumentManager->getArguments(kernel.getArgumentIds()), output);
+    const EventId eventId = computeEngine->runKernelAsync(kernelData, arguments, queue);
+    result = computeEngine->getKernelResult(eventId, output);
 
     result.setConfiguration(configuration);
     return result;
 }
 
+KernelRuntimeData KernelRunner::createKernelRuntimeData(const Kernel& kernel, const KernelConfiguration& configuration) const
+{
+    std::string source = kernelManager->getKernelSourceWithDefines(kernel.getId(), configuration);
+
+    return KernelRuntimeData(kernel.getId(), kernel.getName(), source, kernel.getSource(), configuration.getGlobalSize(),
+        configuration.getLocalSize(), configuration.getParameterPairs(), kernel.getArgumentIds(), configuration.getLocalMemoryModifiers());
+}
+
+void KernelRunner::refreshDirtyArguments(const std::vector<KernelArgument*>& arguments)
+{
+    // Buffers of arguments updated since their upload are dropped, compute engine uploads them again on demand. Buffers of unchanged
+    // arguments are reused.
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto argument : arguments)
+    {
+        if (!argument->isDirty())
+        {
+            continue;
+        }
+
+        if (argument->getUploadType() == ArgumentUploadType::Vector)
+        {
+            Logger::getLogger().log(LoggingLevel::Debug, std::string("Argument ") + std::to_string(argument->getId())
+                + " was updated, its buffer will be uploaded again");
+
+            if (argument->isPersistent())
+            {
+                computeEngine->persistArgument(*argument, false);
+                computeEngine->persistArgument(*argument, true);
+            }
+            else
+            {
+                computeEngine->clearBuffer(argument->getId());
+            }
+        }
+
+        argument->setDirtyFlag(false);
+    }
+}
+
+void KernelRunner::recoverFromFailure(const QueueId queue)
+{
+    // Other threads may still wait for their events, only queue of the failed run is drained in concurrent submission mode
+    if (concurrentSubmissionFlag)
+    {
+        computeEngine->synchronizeQueue(queue);
+        return;
+    }
+
+    computeEngine->synchronizeDevice();
+    computeEngine->clearEvents();
+}
+
 
 
 
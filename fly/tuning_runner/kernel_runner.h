@@ -1,14 +1,21 @@
 #pragma once
 
+#include <atomic>
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <utility>
+#include <vector>
+#include <fly/api/kernel_graph.h>
 #include <fly/compute_engine/compute_engine.h>
 #include <fly/dto/kernel_result.h>
 #include <fly/enum/kernel_run_mode.h>
 #include <fly/enum/time_unit.h>
 #include <fly/kernel/kernel_manager.h>
 #include <fly/kernel_argument/argument_manager.h>
+#include <fly/tuning_runner/kernel_compile_service.h>
 
 
 namespace fly
@@ -26,6 +33,14 @@ public:
 
     KernelResult runKernel(const KernelId id, const KernelRunMode mode, const std::vector<ParameterPair>& configuration,
         const std::vector<OutputDescriptor>& output);
+    std::vector<std::future<void>> precompileKernel(const KernelId id, const std::vector<std::vector<ParameterPair>>& configurations);
+    void waitForPrecompilation();
+    LaunchId prepareLaunch(const KernelId id, const std::vector<ParameterPair>& configuration);
+    KernelResult launch(const LaunchId id, const std::vector<OutputDescriptor>& output);
+    void releaseLaunch(const LaunchId id);
+    EventId runKernelAsync(const KernelId id, const std::vector<ParameterPair>& configuration, const QueueId queue);
+    KernelResult getKernelResult(const EventId id, const std::vector<OutputDescriptor>& output);
+    std::vector<KernelResult> runGraph(const KernelGraph& graph, const std::vector<OutputDescriptor>& output);
 
     void setTimeUnit(const TimeUnit unit);
     void setKernelProfiling(const bool flag);
@@ -38,12 +53,34 @@ public:
     void clearBuffers(const ArgumentAccessType accessType);
     void clearBuffers();
     void setPersistentArgumentUsage(const bool flag);
+    void setResidentArgumentUsage(const bool flag);
+    bool getResidentArgumentUsage() const;
+    void releaseArgument(const ArgumentId id);
+
+    // Concurrent submission methods
+    void setConcurrentSubmission(const bool flag);
+    bool getConcurrentSubmission() const;
+    // Each submitting thread gets its own queue in concurrent submission mode, otherwise default queue is used
+    QueueId getSubmissionQueue();
+    // Runs are counted, buffers of non-resident arguments are released once the last synchronous run finishes and no other run is pending
+    void beginRun();
+    void endRun();
 
 private:
     // Attributes
     ArgumentManager* argumentManager;
     KernelManager* kernelManager;
     ComputeEngine* computeEngine;
+    std::unique_ptr<KernelCompileService> compileService;
+    std::atomic<bool> residentArgumentFlag;
+    std::atomic<bool> concurrentSubmissionFlag;
+    LaunchId nextLaunchId;
+    std::map<LaunchId, std::pair<KernelId, KernelConfiguration>> preparedLaunches;
+    std::map<EventId, std::pair<KernelId, KernelConfiguration>> pendingKernelRuns;
+    std::map<std::thread::id, QueueId> threadQueues;
+    size_t activeRunCount;
+    // Guards runner state and dirty flags of arguments, it is not held while kernel results are awaited
+    mutable std::mutex mutex;
   
 
     TimeUnit timeUnit;
@@ -51,7 +88,10 @@ private:
 
     // Helper methods
     KernelResult runKernelSimple(const Kernel& kernel, const KernelRunMode mode, const KernelConfiguration& configuration,
-        const std::vector<OutputDescriptor>& output);
+        const std::vector<OutputDescriptor>& output, const QueueId queue);
+    KernelRuntimeData createKernelRuntimeData(const Kernel& kernel, const KernelConfiguration& configuration) const;
+    void refreshDirtyArguments(const std::vector<KernelArgument*>& arguments);
+    void recoverFromFailure(const QueueId queue);
 
     
 };
@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <fly/api/searcher/full_searcher.h>
+#include <fly/tuning_runner/tuning_runner.h>
+#include <fly/utility/fly_utility.h>
+#include <fly/utility/logger.h>
+
+namespace fly
+{
+
+TuningRunner::TuningRunner(KernelManager* kernelManager, KernelRunner* kernelRunner) :
+    kernelManager(kernelManager),
+    kernelRunner(kernelRunner)
+{}
+
+std::vector<ComputationResult> TuningRunner::tuneKernel(const KernelId id, std::unique_ptr<StopCondition> stopCondition,
+    std::unique_ptr<Searcher> searcher)
+{
+    if (!kernelManager->isKernel(id))
+    {
+        throw std::runtime_error(std::string("Invalid kernel id: ") + std::to_string(id));
+    }
+
+    const Kernel& kernel = kernelManager->getKernel(id);
+    const ConfigurationSpace& configurationSpace = kernel.getConfigurationSpace();
+
+    if (searcher == nullptr)
+    {
+        searcher = MakeStdUnique<FullSearcher>();
+    }
+
+    searcher->initialize(configurationSpace);
+    if (stopCondition != nullptr)
+    {
+        stopCondition->initialize();
+    }
+
+    Logger::getLogger().log(LoggingLevel::Info, std::string("Starting offline tuning of kernel ") + kernel.getName()
+        + ", configuration space size: " + std::to_string(configurationSpace.getSize()));
+
+    std::vector<ComputationResult> results;
+    kernelRunner->clearBuffers(ArgumentAccessType::ReadWrite);
+    kernelRunner->clearBuffers(ArgumentAccessType::WriteOnly);
+
+    while (stopCondition == nullptr || !stopCondition->isSatisfied())
+    {
+        const uint64_t index = searcher->getNextConfiguration();
+
+        if (index >= configurationSpace.getSize())
+        {
+            break;
+        }
+
+        const ComputationResult result = runConfiguration(kernel, configurationSpace.getConfiguration(index));
+
+        // Read-only buffers stay resident between configurations, buffers which kernel may modify are uploaded again for each run
+        kernelRunner->clearBuffers(ArgumentAccessType::ReadWrite);
+        kernelRunner->clearBuffers(ArgumentAccessType::WriteOnly);
+
+        searcher->updateResult(index, result);
+        results.push_back(result);
+
+        if (stopCondition != nullptr)
+        {
+            stopCondition->updateStatus(result);
+            Logger::getLogger().log(LoggingLevel::Info, stopCondition->getStatusString());
+        }
+    }
+
+    if (!kernelRunner->getResidentArgumentUsage())
+    {
+        kernelRunner->clearBuffers();
+    }
+
+    Logger::getLogger().log(LoggingLevel::Info, std::string("Ending offline tuning of kernel ") + kernel.getName() + ", explored "
+        + std::to_string(results.size()) + " configurations");
+
+    // Failed computations have maximum duration, so they are placed after all successful ones
+    std::stable_sort(results.begin(), results.end(), [](const ComputationResult& first, const ComputationResult& second)
+    {
+        return first.getStatus() != second.getStatus() ? first.getStatus() : first.getDuration() < second.getDuration();
+    });
+
+    return results;
+}
+
+ComputationResult TuningRunner::runConfiguration(const Kernel& kernel, const std::vector<ParameterPair>& configuration)
+{
+    KernelResult result;
+
+    try
+    {
+        result = kernelRunner->runKernel(kernel.getId(), KernelRunMode::OfflineTuning, configuration, std::vector<OutputDescriptor>{});
+    }
+    catch (const std::runtime_error& error)
+    {
+        // Configuration may be rejected already during launch configuration setup, e.g. because of invalid thread modifiers
+        Logger::getLogger().log(LoggingLevel::Warning, std::string("Kernel configuration setup failed, reason: ") + error.what());
+        return ComputationResult(kernel.getName(), configuration, error.what());
+    }
+
+    if (result.isValid())
+    {
+        return ComputationResult(result.getKernelName(), configuration, result.getComputationDuration());
+    }
+
+    return ComputationResult(result.getKernelName(), configuration, result.getErrorMessage());
+}
+
+} // namespace fly
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <fly/api/computation_result.h>
+#include <fly/api/searcher/searcher.h>
+#include <fly/api/stop_condition/stop_condition.h>
+#include <fly/kernel/kernel_manager.h>
+#include <fly/tuning_runner/kernel_runner.h>
+
+namespace fly
+{
+
+class TuningRunner
+{
+public:
+    // Constructor
+    explicit TuningRunner(KernelManager* kernelManager, KernelRunner* kernelRunner);
+
+    // Core methods
+    std::vector<ComputationResult> tuneKernel(const KernelId id, std::unique_ptr<StopCondition> stopCondition, std::unique_ptr<Searcher> searcher);
+
+private:
+    // Attributes
+    KernelManager* kernelManager;
+    KernelRunner* kernelRunner;
+
+    // Helper methods
+    ComputationResult runConfiguration(const Kernel& kernel, const std::vector<ParameterPair>& configuration);
+};
+
+} // namespace fly
@@ -14,23 +14,28 @@ Logger& Logger::getLogger()
 
 void Logger::setLoggingLevel(const LoggingLevel level)
 {
+    std::lock_guard<std::mutex> lock(mutex);
     this->level = level;
 }
 
 void Logger::setLoggingTarget(std::ostream& outputTarget)
 {
+    std::lock_guard<std::mutex> lock(mutex);
     this->outputTarget = &outputTarget;
     filePathValid = false;
 }
 
 void Logger::setLoggingTarget(const std::string& filePath)
 {
+    std::lock_guard<std::mutex> lock(mutex);
     this->filePath = filePath;
     filePathValid = true;
 }
 
 void Logger::log(const LoggingLevel level, const std::string& message) const
 {
+    std::lock_guard<std::mutex> lock(mutex);
+
     if (static_cast<int>(this->level) < static_cast<int>(level))
     {
         return;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <fly/enum/logging_level.h>
@@ -7,6 +8,7 @@
 namespace fly
 {
 
+// Logger is shared by all tuner instances and threads, messages are written whole and do not interleave
 class Logger
 {
 public:
@@ -32,6 +34,7 @@ private:
     std::ostream* outputTarget;
     bool filePathValid;
     std::string filePath;
+    mutable std::mutex mutex;
 
     Logger();
     static std::string getLoggingLevelString(const LoggingLevel level);
@@ -0,0 +1,65 @@
+#include <fly/utility/read_write_lock.h>
+
+namespace fly
+{
+
+ReadWriteLock::ReadWriteLock() :
+    readerCount(0),
+    waitingWriterCount(0),
+    writerFlag(false)
+{}
+
+void ReadWriteLock::lock()
+{
+    std::unique_lock<std::mutex> guard(mutex);
+    ++waitingWriterCount;
+    writerCondition.wait(guard, [this]() { return !writerFlag && readerCount == 0; });
+    --waitingWriterCount;
+    writerFlag = true;
+}
+
+void ReadWriteLock::unlock()
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    writerFlag = false;
+
+    if (waitingWriterCount > 0)
+    {
+        writerCondition.notify_one();
+    }
+    else
+    {
+        readerCondition.notify_all();
+    }
+}
+
+void ReadWriteLock::lockShared()
+{
+    std::unique_lock<std::mutex> guard(mutex);
+    readerCondition.wait(guard, [this]() { return !writerFlag && waitingWriterCount == 0; });
+    ++readerCount;
+}
+
+void ReadWriteLock::unlockShared()
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    --readerCount;
+
+    if (readerCount == 0 && waitingWriterCount > 0)
+    {
+        writerCondition.notify_one();
+    }
+}
+
+SharedLockGuard::SharedLockGuard(ReadWriteLock& lock) :
+    lock(lock)
+{
+    lock.lockShared();
+}
+
+SharedLockGuard::~SharedLockGuard()
+{
+    lock.unlockShared();
+}
+
+} // namespace fly
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace fly
+{
+
+// Lock which lets any number of readers proceed together, writers get exclusive access. Waiting writers block new readers, so that
+// continuous stream of readers cannot starve them. Exclusive side satisfies requirements of std::lock_guard and std::unique_lock.
+class ReadWriteLock
+{
+public:
+    // Constructor
+    ReadWriteLock();
+
+    // Core methods
+    void lock();
+    void unlock();
+    void lockShared();
+    void unlockShared();
+
+    ReadWriteLock(const ReadWriteLock&) = delete;
+    void operator=(const ReadWriteLock&) = delete;
+
+private:
+    // Attributes
+    std::mutex mutex;
+    std::condition_variable readerCondition;
+    std::condition_variable writerCondition;
+    size_t readerCount;
+    size_t waitingWriterCount;
+    bool writerFlag;
+};
+
+// Holds shared side of read-write lock for the duration of a scope
+class SharedLockGuard
+{
+public:
+    // Constructor
+    explicit SharedLockGuard(ReadWriteLock& lock);
+    ~SharedLockGuard();
+
+    SharedLockGuard(const SharedLockGuard&) = delete;
+    void operator=(const SharedLockGuard&) = delete;
+
+private:
+    // Attributes
+    ReadWriteLock& lock;
+};
+
+} // namespace fly